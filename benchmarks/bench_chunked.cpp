@@ -0,0 +1,82 @@
+#include "chunked_backtest.h"
+#include "optimizer.h"
+#include "price_store.h"
+#include "synthetic_prices.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Chunked vs in-memory backtest of one long minute-bar store file: time,
+// peak resident memory, and whether the results agree. The store is written
+// by a child process so generating it does not count toward the peak.
+// Usage: bench_chunked [bars] [chunk_bars]
+
+static double peak_rss_mb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;  // KiB on Linux
+}
+
+template <typename Fn>
+static double time_ms(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 10000000;
+    size_t chunk_bars = argc > 2 ? std::stoul(argv[2]) : DEFAULT_CHUNK_BARS;
+    std::string path = "/tmp/bench_chunked_" + std::to_string(::getpid()) + ".atps";
+
+    pid_t child = fork();
+    if (child == 0) {
+        PriceSeries series;
+        series.symbol = "SYN";
+        series.close = generate_gbm_prices(bars, 17, 100.0, 0.0, 0.002);
+        series.open = series.high = series.low = series.volume = series.close;
+        series.dates.resize(bars);
+        for (size_t i = 0; i < bars; ++i) series.dates[i] = 1700000000 + static_cast<int64_t>(i) * 60;
+        write_price_store(path, series);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::cerr << "❌ Could not write " << path << "\n";
+        return 1;
+    }
+
+    StrategyParameters params;
+    std::cout << "Chunked backtest: " << bars << " bars, " << chunk_bars << "-bar blocks\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    double base_rss = peak_rss_mb();
+
+    BacktestResult chunked;
+    double chunked_ms = time_ms([&] { chunked = backtest_chunked(path, params, chunk_bars); });
+    double chunked_rss = peak_rss_mb();
+    std::cout << "  chunked    " << std::setw(8) << chunked_ms << " ms   peak RSS " << std::setw(7) << chunked_rss
+              << " MB (+" << chunked_rss - base_rss << ")\n";
+
+    BacktestResult in_memory;
+    double in_memory_ms = time_ms([&] {
+        PriceSeries loaded = MappedPriceStore(path).to_series();
+        in_memory = backtest_detailed(loaded.close, params);
+    });
+    double in_memory_rss = peak_rss_mb();
+    std::cout << "  in-memory  " << std::setw(8) << in_memory_ms << " ms   peak RSS " << std::setw(7)
+              << in_memory_rss << " MB (+" << in_memory_rss - base_rss << ")\n";
+
+    bool same = chunked.fitness == in_memory.fitness && chunked.triggers == in_memory.triggers &&
+                chunked.successes == in_memory.successes && chunked.total_return == in_memory.total_return;
+    std::cout << "\n  " << chunked.triggers << " triggers, fitness " << std::setprecision(4) << chunked.fitness
+              << (same ? "  ✅ identical" : "  ❌ results differ") << "\n";
+    std::remove(path.c_str());
+    return same ? 0 : 1;
+}
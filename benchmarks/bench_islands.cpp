@@ -0,0 +1,105 @@
+#include "island_optimizer.h"
+#include "synthetic_prices.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+// Time-to-target fitness: the single-population GA against the island model.
+// The target is a long reference run's best minus a tolerance; each run's
+// time-to-target is its wall time scaled by the first generation whose
+// best-so-far reaches the target (generations cost about the same).
+// Usage: bench_islands [max_islands] [bars] [seeds] [tolerance]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Outcome {
+    double seconds;
+    int hit_generation;  // -1 when the target was never reached
+    double best;
+};
+
+int first_hit(const std::vector<double>& history, double target) {
+    double best = -1e9;
+    for (size_t g = 0; g < history.size(); ++g) {
+        best = std::max(best, history[g]);
+        if (best >= target) return static_cast<int>(g);
+    }
+    return -1;
+}
+
+void report(const std::string& label, const std::vector<Outcome>& runs, int generations, size_t evaluations) {
+    size_t hits = 0;
+    double ttt = 0.0, wall = 0.0, best = 0.0;
+    for (const auto& r : runs) {
+        wall += r.seconds;
+        best += r.best;
+        if (r.hit_generation >= 0) {
+            ++hits;
+            ttt += r.seconds * (r.hit_generation + 1) / generations;
+        }
+    }
+    std::cout << std::left << std::setw(24) << label << std::right << std::fixed
+              << std::setw(9) << hits << "/" << runs.size()
+              << std::setprecision(1) << std::setw(12) << (hits ? 1000.0 * ttt / hits : 0.0)
+              << std::setw(11) << 1000.0 * wall / runs.size()
+              << std::setprecision(0) << std::setw(12) << evaluations * runs.size() / wall
+              << std::setprecision(2) << std::setw(10) << best / runs.size() << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t max_islands = argc > 1 ? std::stoul(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 5000;
+    unsigned int seeds = argc > 3 ? static_cast<unsigned int>(std::stoul(argv[3])) : 4;
+    double tolerance = argc > 4 ? std::stod(argv[4]) : 0.5;
+    const int generations = 60;
+    const size_t per_island = 30;
+
+    auto prices = generate_gbm_prices(bars, 77);
+
+    GeneticOptimizer reference(60, 200, 0.1, 0.2, 999, max_islands);
+    reference.set_verbose(false);
+    double target = reference.optimize(prices, cached_backtest_fitness).best_fitness - tolerance;
+
+    std::cout << "Time to target fitness " << std::fixed << std::setprecision(2) << target << " ("
+              << bars << " bars, " << generations << " generations, " << seeds << " seeds)\n";
+    std::cout << std::left << std::setw(24) << "optimizer" << std::right << std::setw(11) << "reached"
+              << std::setw(12) << "ttt ms" << std::setw(11) << "wall ms" << std::setw(12) << "evals/s"
+              << std::setw(10) << "best" << "\n";
+
+    for (size_t k = 1; k <= max_islands; k *= 2) {
+        std::vector<Outcome> single, islands;
+        for (unsigned int seed = 1; seed <= seeds; ++seed) {
+            // Same total population and threads for both models
+            GeneticOptimizer ga(per_island * k, generations, 0.1, 0.2, seed, k);
+            ga.set_verbose(false);
+            auto start = Clock::now();
+            auto a = ga.optimize(prices, cached_backtest_fitness);
+            single.push_back({std::chrono::duration<double>(Clock::now() - start).count(),
+                              first_hit(a.fitness_history, target), a.best_fitness});
+
+            IslandOptions options;
+            options.islands = k;
+            options.population_per_island = per_island;
+            options.generations = generations;
+            options.seed = seed;
+            options.threads = k;
+            IslandOptimizer model(options);
+            start = Clock::now();
+            auto b = model.optimize(prices, cached_backtest_fitness);
+            islands.push_back({std::chrono::duration<double>(Clock::now() - start).count(),
+                               first_hit(b.best.fitness_history, target), b.best.best_fitness});
+        }
+        size_t evaluations = per_island * k * generations;
+        report("GA pop " + std::to_string(per_island * k) + " x" + std::to_string(k) + " thr", single,
+               generations, evaluations);
+        report(std::to_string(k) + " islands x" + std::to_string(per_island), islands, generations, evaluations);
+    }
+    return 0;
+}
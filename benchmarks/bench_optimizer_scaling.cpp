@@ -0,0 +1,57 @@
+#include "optimizer.h"
+#include "synthetic_prices.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measures GeneticOptimizer wall time from 1 to N worker threads on a fixed
+// seed and checks that every thread count reproduces the same result.
+// Usage: bench_optimizer_scaling [max_threads] [bars]
+int main(int argc, char** argv) {
+    size_t max_threads = argc > 1 ? std::stoul(argv[1]) : std::thread::hardware_concurrency();
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 7500;
+    if (max_threads == 0) max_threads = 1;
+
+    const unsigned int seed = 12345;
+    auto prices = generate_gbm_prices(bars, seed);
+
+    std::cout << "GA scaling: " << bars << " bars, population 64, 30 generations\n";
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "ms" << std::setw(10) << "speedup"
+              << std::setw(14) << "best fitness" << "\n";
+
+    double baseline_ms = 0.0;
+    double baseline_fitness = 0.0;
+    bool reproducible = true;
+
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    for (size_t threads : thread_counts) {
+        GeneticOptimizer optimizer(64, 30, 0.1, 0.2, seed, threads);
+        optimizer.set_verbose(false);
+
+        auto start = std::chrono::steady_clock::now();
+        auto result = optimizer.optimize(prices, cached_backtest_fitness);
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        if (threads == 1) {
+            baseline_ms = ms;
+            baseline_fitness = result.best_fitness;
+        } else if (result.best_fitness != baseline_fitness) {
+            reproducible = false;
+        }
+
+        std::cout << std::setw(8) << threads << std::setw(12) << std::fixed << std::setprecision(1) << ms
+                  << std::setw(9) << std::setprecision(2) << baseline_ms / ms << "x"
+                  << std::setw(14) << result.best_fitness << "\n";
+    }
+
+    std::cout << (reproducible ? "✅ Identical results across thread counts\n"
+                               : "❌ Results differ across thread counts\n");
+    return reproducible ? 0 : 1;
+}
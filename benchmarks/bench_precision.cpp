@@ -0,0 +1,90 @@
+#include "indicators.h"
+#include "optimizer.h"
+#include "synthetic_prices.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+// Float32 vs double: indicator kernel time on a long intraday-like series,
+// agreement of the trigger sets and fitness over random parameter sets, and
+// a GA run in each precision with the float winner re-scored in double.
+// Usage: bench_precision [bars] [param_sets]
+
+template <typename Fn>
+static double best_ms(Fn fn, int repeats = 5) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 2000000;
+    int param_sets = argc > 2 ? std::stoi(argv[2]) : 50;
+
+    // Minute-bar scale volatility and no drift so long series stay in range
+    auto prices = generate_gbm_prices(bars, 7, 100.0, 0.0, 0.002);
+    std::vector<float> prices_f(prices.begin(), prices.end());
+    Span<const double> pd(prices);
+    Span<const float> pf(prices_f);
+
+    std::cout << "Precision comparison: " << bars << " bars\n\n";
+    std::cout << std::setw(10) << "kernel" << std::setw(12) << "double ms" << std::setw(12) << "float ms"
+              << std::setw(10) << "speedup" << "\n";
+    auto row = [&](const char* name, double d, double f) {
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << name << std::setw(12) << d
+                  << std::setw(12) << f << std::setw(9) << d / f << "x\n";
+    };
+    row("SMA 200", best_ms([&] { calc_sma(pd, 200); }), best_ms([&] { calc_sma(pf, 200); }));
+    row("MACD", best_ms([&] { calc_macd(pd); }), best_ms([&] { calc_macd(pf); }));
+    row("RSI 14", best_ms([&] { calc_rsi(pd, 14); }), best_ms([&] { calc_rsi(pf, 14); }));
+    row("backtest", best_ms([&] { backtest_arrays(pd, StrategyParameters{}); }),
+        best_ms([&] { backtest_arrays(pf, StrategyParameters{}); }));
+
+    // Trigger agreement: Jaccard index of the entry sets per parameter set
+    std::mt19937 gen(11);
+    double jaccard_sum = 0.0, jaccard_min = 1.0, fitness_diff_sum = 0.0, fitness_diff_max = 0.0;
+    size_t only_double = 0, only_float = 0, shared = 0;
+    for (int k = 0; k < param_sets; ++k) {
+        StrategyParameters params = StrategyParameters::random(gen);
+        auto a = entry_triggers(pd, params);
+        auto b = entry_triggers(pf, params);
+        std::vector<size_t> both;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(both));
+        size_t unioned = a.size() + b.size() - both.size();
+        double jaccard = unioned ? static_cast<double>(both.size()) / unioned : 1.0;
+        jaccard_sum += jaccard;
+        jaccard_min = std::min(jaccard_min, jaccard);
+        shared += both.size();
+        only_double += a.size() - both.size();
+        only_float += b.size() - both.size();
+
+        double diff = std::fabs(backtest_arrays(pd, params).fitness - backtest_arrays(pf, params).fitness);
+        fitness_diff_sum += diff;
+        fitness_diff_max = std::max(fitness_diff_max, diff);
+    }
+    std::cout << "\nTrigger sets over " << param_sets << " random parameter sets:\n"
+              << "  shared " << shared << ", only double " << only_double << ", only float " << only_float << "\n"
+              << std::setprecision(4) << "  Jaccard mean " << jaccard_sum / param_sets << ", min " << jaccard_min
+              << "\n  |fitness diff| mean " << fitness_diff_sum / param_sets << ", max " << fitness_diff_max << "\n";
+
+    // Same GA seed in both precisions on a daily-length slice
+    std::vector<double> slice(prices.begin(), prices.begin() + std::min<size_t>(bars, 20000));
+    GeneticOptimizer double_ga(30, 50, 0.1, 0.2, 5, 1), float_ga(30, 50, 0.1, 0.2, 5, 1);
+    double_ga.set_verbose(false);
+    float_ga.set_verbose(false);
+    double double_ms = 0.0, float_ms = 0.0;
+    OptimizationResult a, b;
+    double_ms = best_ms([&] { a = double_ga.optimize(slice, backtest_fitness_for(Precision::Double)); }, 1);
+    float_ms = best_ms([&] { b = float_ga.optimize(slice, backtest_fitness_for(Precision::Float)); }, 1);
+    std::cout << "\nGA on " << slice.size() << " bars (seed 5): double best " << std::setprecision(2)
+              << a.best_fitness << " in " << double_ms << " ms, float best " << b.best_fitness << " in " << float_ms
+              << " ms (re-scored in double: " << backtest_detailed(slice, b.best_params).fitness << ")\n";
+    return 0;
+}
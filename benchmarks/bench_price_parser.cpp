@@ -0,0 +1,76 @@
+#include "price_parser.h"
+#include "synthetic_prices.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+
+// Compares the streaming SAX parser with the nlohmann DOM path on synthetic
+// historical-price-full payloads: wall time and peak heap growth.
+// Usage: bench_price_parser [max_megabytes]
+
+namespace {
+
+size_t live_bytes = 0;
+size_t peak_bytes = 0;
+
+// Each allocation carries its size in a 16-byte prefix so deletes can be tracked
+void* tracked_alloc(size_t size) {
+    void* raw = std::malloc(size + 16);
+    if (!raw) throw std::bad_alloc();
+    *static_cast<size_t*>(raw) = size;
+    live_bytes += size;
+    if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+    return static_cast<char*>(raw) + 16;
+}
+
+void tracked_free(void* ptr) {
+    if (!ptr) return;
+    void* raw = static_cast<char*>(ptr) - 16;
+    live_bytes -= *static_cast<size_t*>(raw);
+    std::free(raw);
+}
+
+template <typename Parse>
+void run(const char* label, const std::string& payload, Parse parse) {
+    size_t baseline = live_bytes;
+    peak_bytes = live_bytes;
+    auto start = std::chrono::steady_clock::now();
+    ParsedHistory parsed = parse(payload, "SYN");
+    auto end = std::chrono::steady_clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    double payload_mb = payload.size() / (1024.0 * 1024.0);
+    double peak_mb = (peak_bytes - baseline) / (1024.0 * 1024.0);
+    std::cout << "  " << std::left << std::setw(6) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << ms << " ms"
+              << std::setw(10) << payload_mb / (ms / 1000.0) << " MB/s"
+              << std::setw(10) << peak_mb << " MB peak"
+              << std::setw(7) << std::setprecision(2) << peak_mb / payload_mb << "x payload"
+              << "  (" << parsed.series.size() << " bars)\n";
+}
+
+} // namespace
+
+void* operator new(size_t size) { return tracked_alloc(size); }
+void* operator new[](size_t size) { return tracked_alloc(size); }
+void operator delete(void* ptr) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { tracked_free(ptr); }
+
+int main(int argc, char** argv) {
+    size_t max_mb = argc > 1 ? std::stoul(argv[1]) : 32;
+
+    for (size_t mb = 1; mb <= max_mb; mb *= 4) {
+        // ~150 bytes per intraday record
+        std::string payload = generate_history_payload(mb * 1024 * 1024 / 150);
+        std::cout << std::fixed << std::setprecision(1) << payload.size() / (1024.0 * 1024.0) << " MB payload\n";
+        run("DOM", payload, parse_price_history_dom);
+        run("SAX", payload, parse_price_history);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "optimizer.h"
+#include "synthetic_prices.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// Compares racing (successive halving on growing prefixes) with full
+// evaluation on the same seeds: bar-evaluations saved, wall time, and the
+// gap between the best full-series fitness each run finds.
+// Usage: bench_racing [bars] [seeds]
+int main(int argc, char** argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 20000;
+    unsigned int seeds = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 5;
+    auto prices = generate_gbm_prices(bars, 2024);
+
+    RacingOptions racing;
+    racing.enabled = true;
+
+    std::cout << "GA racing: " << bars << " bars, population 30, 50 generations, rungs 25/50/100%\n";
+    std::cout << std::setw(6) << "seed" << std::setw(11) << "full ms" << std::setw(11) << "race ms"
+              << std::setw(9) << "saved" << std::setw(12) << "full best" << std::setw(12) << "race best"
+              << std::setw(9) << "diff" << "\n";
+
+    double total_saved = 0.0, total_diff = 0.0;
+    for (unsigned int seed = 1; seed <= seeds; ++seed) {
+        GeneticOptimizer full(30, 50, 0.1, 0.2, seed, 1);
+        GeneticOptimizer raced(30, 50, 0.1, 0.2, seed, 1);
+        full.set_verbose(false);
+        raced.set_verbose(false);
+        raced.set_racing(racing);
+
+        auto start = std::chrono::steady_clock::now();
+        auto a = full.optimize(prices, cached_backtest_fitness);
+        double full_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        auto b = raced.optimize(prices, cached_backtest_fitness);
+        double race_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        double saved = 1.0 - static_cast<double>(b.bar_evaluations) / b.full_bar_evaluations;
+        double diff = b.best_fitness - a.best_fitness;
+        total_saved += saved;
+        total_diff += diff;
+
+        std::cout << std::fixed << std::setw(6) << seed << std::setprecision(1) << std::setw(11) << full_ms
+                  << std::setw(11) << race_ms << std::setw(8) << saved * 100.0 << "%"
+                  << std::setprecision(2) << std::setw(12) << a.best_fitness << std::setw(12) << b.best_fitness
+                  << std::setw(9) << diff << "\n";
+    }
+
+    std::cout << "Mean: " << std::setprecision(1) << total_saved / seeds * 100.0
+              << "% bar-evaluations saved, best fitness " << std::showpos << std::setprecision(2)
+              << total_diff / seeds << " vs full evaluation\n";
+    return 0;
+}
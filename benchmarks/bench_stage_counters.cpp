@@ -0,0 +1,64 @@
+#include "indicators.h"
+#include "optimizer.h"
+#include "perf_counters.h"
+#include "price_parser.h"
+#include "synthetic_prices.h"
+#include <iostream>
+#include <string>
+
+// Runs the offline pipeline stages (parse, indicators, backtest, optimize) on
+// a synthetic payload and reports IPC and cache/branch misses per bar for
+// each, or wall time only where perf_event_open is not permitted.
+// Usage: bench_stage_counters [bars] [repeats]
+int main(int argc, char** argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 20000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    std::string payload = generate_history_payload(bars);
+    StageCounters perf;
+    std::cout << "Stage counters: " << bars << " bars, " << repeats << " repeats\n";
+
+    PriceSeries series;
+    for (int r = 0; r < repeats; ++r) {
+        ScopedStage stage(&perf, "parse");
+        series = parse_price_history(payload, "SYN").series;
+        stage.set_bars(series.size());
+    }
+    const std::vector<double>& closes = series.close;
+
+    for (int r = 0; r < repeats; ++r) {
+        ScopedStage stage(&perf, "sma", closes.size());
+        calc_sma(closes, 200);
+    }
+    for (int r = 0; r < repeats; ++r) {
+        ScopedStage stage(&perf, "macd", closes.size());
+        calc_macd(closes);
+    }
+    for (int r = 0; r < repeats; ++r) {
+        ScopedStage stage(&perf, "rsi", closes.size());
+        calc_rsi(closes, 14);
+    }
+
+    StrategyParameters params;
+    for (int r = 0; r < repeats; ++r) {
+        ScopedStage stage(&perf, "backtest", closes.size());
+        backtest_detailed(closes, params);
+    }
+    IndicatorCache cache;
+    backtest_detailed(closes, params, cache);  // warm: measure the trigger/exit scan only
+    for (int r = 0; r < repeats; ++r) {
+        ScopedStage stage(&perf, "bt-cached", closes.size());
+        backtest_detailed(closes, params, cache);
+    }
+
+    {
+        // Bars are bar-evaluations: series length x fitness evaluations
+        ScopedStage stage(&perf, "optimize", closes.size() * 30 * 20);
+        GeneticOptimizer optimizer(30, 20, 0.1, 0.2, 42, 1);
+        optimizer.set_verbose(false);
+        optimizer.optimize(closes, cached_backtest_fitness);
+    }
+
+    perf.print_report(std::cout);
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include "backtest_workspace.h"
+#include "exit_resolver.h"
+#include "indicators.h"
+#include "optimizer.h"
+#include "strategy_engine.h"
+#include "streaming_indicators.h"
+#include "synthetic_prices.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Strategy engine vs the hand-written loops it replaced, timed over the same
+// parameter sets and checked for identical results:
+//   fused        backtest_detailed: streaming scan and exits
+//   arrays       backtest_arrays: indicator arrays, then scan and exits
+//   arrays scan  the scan and exits alone, over prebuilt indicator arrays
+//   resolved     the same scan with exits from an ExitResolver (cached path)
+// Hand and engine runs alternate and each keeps its best time, so clock and
+// cache drift hit both sides alike.
+// Usage: bench_strategy_engine [bars] [param_sets] [repeats]
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Best-of-`repeats` time of each side, alternating hand and engine
+template <typename Hand, typename Engine>
+static std::pair<double, double> interleaved_ms(Hand hand, Engine engine, int repeats) {
+    double best_hand = 1e300, best_engine = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        hand();
+        best_hand = std::min(best_hand, elapsed_ms(start));
+        start = std::chrono::steady_clock::now();
+        engine();
+        best_engine = std::min(best_engine, elapsed_ms(start));
+    }
+    return {best_hand, best_engine};
+}
+
+// Forward scan from each trigger, as score_triggers did before the engine
+static BacktestResult hand_score(Span<const double> prices, const StrategyParameters& params,
+                                 const std::vector<size_t>& triggers) {
+    size_t successes = 0;
+    double total_return = 0.0;
+    for (size_t i : triggers) {
+        double stop = prices[i] * (1.0 - params.stop_loss);
+        double take = prices[i] * (1.0 + params.take_profit);
+        for (size_t j = i + 1; j <= i + params.look_ahead && j < prices.size(); ++j) {
+            if (prices[j] >= take) {
+                ++successes;
+                total_return += params.take_profit;
+                break;
+            }
+            if (prices[j] <= stop) {
+                total_return -= params.stop_loss;
+                break;
+            }
+        }
+    }
+    return score_outcomes(triggers.size(), successes, total_return);
+}
+
+// Entry bars from prebuilt arrays, written over `triggers`
+static void hand_collect(Span<const double> prices, const StrategyParameters& params,
+                         const IndicatorBuffers<double>& b, std::vector<size_t>& triggers) {
+    triggers.clear();
+    for (size_t i = params.ma_period; i < prices.size() - params.look_ahead; ++i) {
+        bool above = prices[i] > b.sma[i];
+        bool cross = b.macd.macd[i] > b.macd.signal[i] && b.macd.macd[i - 1] <= b.macd.signal[i - 1];
+        if (above && cross && b.rsi[i] < params.rsi_threshold) triggers.push_back(i);
+    }
+}
+
+// Exits from the resolver's tables, as score_triggers did for the cached path
+static BacktestResult hand_resolved(const ExitResolver& exits, const StrategyParameters& params,
+                                    const std::vector<size_t>& triggers, std::vector<ExitOutcome>& outcomes) {
+    exits.resolve_batch(triggers, ExitLevels{params.stop_loss, params.take_profit}, params.look_ahead, outcomes);
+    size_t successes = 0;
+    double total_return = 0.0;
+    for (const ExitOutcome& outcome : outcomes) {
+        if (outcome.reason == ExitReason::TakeProfit) {
+            ++successes;
+            total_return += params.take_profit;
+        } else if (outcome.reason == ExitReason::StopLoss) {
+            total_return -= params.stop_loss;
+        }
+    }
+    return score_outcomes(triggers.size(), successes, total_return);
+}
+
+static auto engine_entry(Span<const double> prices, const StrategyParameters& params,
+                         const IndicatorBuffers<double>& b) {
+    return all_of(SeriesAboveSMA<double>(prices, b.sma), SeriesMACDCross<double>(b.macd),
+                  SeriesRSIBelow<double>(b.rsi, params.rsi_threshold));
+}
+
+static BacktestResult hand_fused(Span<const double> prices, const StrategyParameters& params, BacktestWorkspace& ws) {
+    ws.triggers.clear();
+    ws.sma_stream.reset(params.ma_period);
+    StreamingMACD macd(12, 26, 9);
+    StreamingRSI rsi(params.rsi_period);
+    MACDValue prev{0.0, 0.0};
+    size_t end = prices.size() - params.look_ahead;
+    for (size_t i = 0; i < end; ++i) {
+        double sma = ws.sma_stream.update(prices[i]);
+        MACDValue cur = macd.update(prices[i]);
+        double r = rsi.update(prices[i]);
+        if (i >= static_cast<size_t>(params.ma_period) && prices[i] > sma && cur.macd > cur.signal &&
+            prev.macd <= prev.signal && r < params.rsi_threshold) {
+            ws.triggers.push_back(i);
+        }
+        prev = cur;
+    }
+    return hand_score(prices, params, ws.triggers);
+}
+
+static BacktestResult hand_arrays(Span<const double> prices, const StrategyParameters& params, BacktestWorkspace& ws) {
+    IndicatorBuffers<double>& b = ws.buffers<double>();
+    calc_sma(prices, params.ma_period, b.sma);
+    calc_macd(prices, 12, 26, 9, b.macd);
+    calc_rsi(prices, params.rsi_period, b.rsi);
+    hand_collect(prices, params, b, ws.triggers);
+    return hand_score(prices, params, ws.triggers);
+}
+
+int main(int argc, char** argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 200000;
+    int param_sets = argc > 2 ? std::stoi(argv[2]) : 40;
+    int repeats = argc > 3 ? std::stoi(argv[3]) : 9;
+
+    auto prices = generate_gbm_prices(bars, 13, 100.0, 0.0, 0.002);
+    Span<const double> pd(prices);
+    std::mt19937 gen(4);
+    std::vector<StrategyParameters> sets;
+    for (int k = 0; k < param_sets; ++k) sets.push_back(StrategyParameters::random(gen));
+
+    BacktestWorkspace ws;
+    ws.reserve(bars);
+    ExitResolver exits(prices);
+    std::vector<ExitOutcome> outcomes;
+    size_t mismatches = 0;
+    volatile double sink = 0.0;  // keeps the timed results live
+    double hand_ms[4] = {0, 0, 0, 0}, engine_ms[4] = {0, 0, 0, 0};
+    auto add = [&](int row, std::pair<double, double> t) {
+        hand_ms[row] += t.first;
+        engine_ms[row] += t.second;
+    };
+
+    for (const auto& params : sets) {
+        BacktestResult fused = backtest_detailed(prices, params);
+        BacktestResult arrays = backtest_arrays(pd, params, ws);
+        if (fused.fitness != hand_fused(pd, params, ws).fitness) ++mismatches;
+        if (arrays.fitness != hand_arrays(pd, params, ws).fitness) ++mismatches;
+        if (fused.triggers != arrays.triggers) ++mismatches;
+
+        add(0, interleaved_ms([&] { sink = sink + hand_fused(pd, params, ws).fitness; },
+                              [&] { sink = sink + backtest_detailed(prices, params).fitness; }, repeats));
+        add(1, interleaved_ms([&] { sink = sink + hand_arrays(pd, params, ws).fitness; },
+                              [&] { sink = sink + backtest_arrays(pd, params, ws).fitness; }, repeats));
+
+        // Prebuilt arrays: both sides time only the scan and the exits
+        IndicatorBuffers<double> b;
+        calc_sma(pd, params.ma_period, b.sma);
+        calc_macd(pd, 12, 26, 9, b.macd);
+        calc_rsi(pd, params.rsi_period, b.rsi);
+        size_t end = prices.size() - params.look_ahead;
+        TakeProfitStopLoss<> scan_exit(params.stop_loss, params.take_profit, params.look_ahead);
+        ResolvedTakeProfitStopLoss table_exit(exits, params.stop_loss, params.take_profit, params.look_ahead);
+        auto engine_scan = [&](const auto& exit) {
+            auto entry = engine_entry(pd, params, b);
+            TradeTally t = run_strategy(entry, exit, pd, params.ma_period, end);
+            return score_outcomes(t.triggers, t.successes, t.total_return);
+        };
+        auto hand_scan = [&] {
+            hand_collect(pd, params, b, ws.triggers);
+            return hand_score(pd, params, ws.triggers);
+        };
+        auto hand_table = [&] {
+            hand_collect(pd, params, b, ws.triggers);
+            return hand_resolved(exits, params, ws.triggers, outcomes);
+        };
+        if (hand_scan().fitness != engine_scan(scan_exit).fitness) ++mismatches;
+        if (hand_table().fitness != engine_scan(table_exit).fitness) ++mismatches;
+        add(2, interleaved_ms([&] { sink = sink + hand_scan().fitness; },
+                              [&] { sink = sink + engine_scan(scan_exit).fitness; }, repeats));
+        add(3, interleaved_ms([&] { sink = sink + hand_table().fitness; },
+                              [&] { sink = sink + engine_scan(table_exit).fitness; }, repeats));
+    }
+
+    std::cout << "Strategy engine vs hand-written loops: " << bars << " bars, " << param_sets
+              << " parameter sets, best of " << repeats << "\n\n";
+    std::cout << std::setw(12) << "path" << std::setw(12) << "hand ms" << std::setw(12) << "engine ms"
+              << std::setw(18) << "engine speedup" << "\n";
+    const char* names[4] = {"fused", "arrays", "arrays scan", "resolved"};
+    for (int row = 0; row < 4; ++row) {
+        std::cout << std::fixed << std::setprecision(2) << std::setw(12) << names[row] << std::setw(12)
+                  << hand_ms[row] << std::setw(12) << engine_ms[row] << std::setw(17)
+                  << hand_ms[row] / engine_ms[row] << "x\n";
+    }
+    std::cout << "\nResult mismatches: " << mismatches << (mismatches ? "  ❌" : "  ✅") << "\n";
+    return mismatches ? 1 : 0;
+}
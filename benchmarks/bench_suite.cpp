@@ -0,0 +1,270 @@
+#include <benchmark/benchmark.h>
+#include "grid_sweep.h"
+#include "indicators.h"
+#include "indicator_lanes.h"
+#include "optimizer.h"
+#include "profiler.h"
+#include "synthetic_prices.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+// Google Benchmark microbenchmarks over seeded GBM prices, so runs are
+// offline and comparable between releases. Emit JSON with
+//   bench_algo_trader --benchmark_out=results.json --benchmark_out_format=json
+
+namespace {
+
+// Series are generated once per length and shared by every benchmark
+const std::vector<double>& prices_for(size_t bars) {
+    static std::map<size_t, std::vector<double>> series;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = series.find(bars);
+    if (it == series.end()) {
+        it = series.emplace(bars, generate_gbm_prices(bars, 42)).first;
+    }
+    return it->second;
+}
+
+// Float32 copies for the precision comparison
+const std::vector<float>& float_prices_for(size_t bars) {
+    static std::map<size_t, std::vector<float>> series;
+    static std::mutex mutex;
+    const auto& prices = prices_for(bars);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = series.find(bars);
+    if (it == series.end()) {
+        it = series.emplace(bars, std::vector<float>(prices.begin(), prices.end())).first;
+    }
+    return it->second;
+}
+
+void set_bar_counters(benchmark::State& state, size_t bars, size_t value_bytes = sizeof(double)) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bars));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bars * value_bytes));
+    state.counters["bars"] = static_cast<double>(bars);
+}
+
+void BM_CalcSMA(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    int period = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_sma(prices, period));
+    }
+    set_bar_counters(state, prices.size());
+}
+
+void BM_CalcSMAMulti(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    std::vector<int> periods;
+    for (int p = 50; p <= 300; p += 25) periods.push_back(p);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_sma_multi(prices, periods));
+    }
+    set_bar_counters(state, prices.size());
+    state.counters["periods"] = static_cast<double>(periods.size());
+}
+
+void BM_CalcMACD(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_macd(prices));
+    }
+    set_bar_counters(state, prices.size());
+}
+
+void BM_CalcRSI(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    int period = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_rsi(prices, period));
+    }
+    set_bar_counters(state, prices.size());
+}
+
+void BM_CalcSMAFloat(benchmark::State& state) {
+    const auto& prices = float_prices_for(state.range(0));
+    int period = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_sma(prices, period));
+    }
+    set_bar_counters(state, prices.size(), sizeof(float));
+}
+
+void BM_CalcMACDFloat(benchmark::State& state) {
+    const auto& prices = float_prices_for(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_macd(prices));
+    }
+    set_bar_counters(state, prices.size(), sizeof(float));
+}
+
+void BM_CalcRSIFloat(benchmark::State& state) {
+    const auto& prices = float_prices_for(state.range(0));
+    int period = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_rsi(prices, period));
+    }
+    set_bar_counters(state, prices.size(), sizeof(float));
+}
+
+// 16 RSI periods / MACD triples over one series: one scalar call per
+// parameter set vs the multi-lane kernels at SimdLevel range(1). Outputs are
+// reused across iterations so the kernels, not page faults, are timed.
+std::vector<int> lane_rsi_periods() {
+    std::vector<int> periods;
+    for (int p = 5; p <= 20; ++p) periods.push_back(p);
+    return periods;
+}
+
+std::vector<MACDParams> lane_macd_sets() {
+    std::vector<MACDParams> sets;
+    for (int fast : {8, 10, 12, 14}) {
+        for (int slow : {21, 26, 30, 35}) sets.push_back({fast, slow, 9});
+    }
+    return sets;
+}
+
+void set_lane_level(benchmark::State& state) {
+    SimdLevel level = std::min(static_cast<SimdLevel>(state.range(1)), detected_simd_level());
+    state.SetLabel(simd_level_name(level));
+}
+
+void BM_RSIPeriodsScalar(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    auto periods = lane_rsi_periods();
+    std::vector<std::vector<double>> rows(periods.size());
+    for (auto _ : state) {
+        for (size_t k = 0; k < periods.size(); ++k) calc_rsi(Span<const double>(prices), periods[k], rows[k]);
+        benchmark::DoNotOptimize(rows.data());
+    }
+    set_bar_counters(state, prices.size() * periods.size());
+}
+
+void BM_RSILanes(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    auto periods = lane_rsi_periods();
+    auto level = static_cast<SimdLevel>(state.range(1));
+    IndicatorMatrix rows;
+    for (auto _ : state) {
+        calc_rsi_lanes(prices, periods, rows, level);
+        benchmark::DoNotOptimize(rows.values.data());
+    }
+    set_bar_counters(state, prices.size() * periods.size());
+    set_lane_level(state);
+}
+
+void BM_MACDSetsScalar(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    auto sets = lane_macd_sets();
+    std::vector<MACD> rows(sets.size());
+    for (auto _ : state) {
+        for (size_t k = 0; k < sets.size(); ++k) {
+            calc_macd(Span<const double>(prices), sets[k].fast, sets[k].slow, sets[k].signal, rows[k]);
+        }
+        benchmark::DoNotOptimize(rows.data());
+    }
+    set_bar_counters(state, prices.size() * sets.size());
+}
+
+void BM_MACDLanes(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    auto sets = lane_macd_sets();
+    auto level = static_cast<SimdLevel>(state.range(1));
+    MACDMatrix rows;
+    for (auto _ : state) {
+        calc_macd_lanes(prices, sets, rows, level);
+        benchmark::DoNotOptimize(rows.macd.values.data());
+    }
+    set_bar_counters(state, prices.size() * sets.size());
+    set_lane_level(state);
+}
+
+void BM_BacktestDetailed(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    StrategyParameters params;
+    params.ma_period = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(backtest_detailed(prices, params));
+    }
+    set_bar_counters(state, prices.size());
+}
+
+void BM_BacktestDetailedCached(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    StrategyParameters params;
+    params.ma_period = static_cast<int>(state.range(1));
+    IndicatorCache cache;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(backtest_detailed(prices, params, cache));
+    }
+    set_bar_counters(state, prices.size());
+}
+
+void BM_GeneticOptimize(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    size_t threads = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        GeneticOptimizer optimizer(30, 50, 0.1, 0.2, 42, threads);
+        optimizer.set_verbose(false);
+        benchmark::DoNotOptimize(optimizer.optimize(prices, cached_backtest_fitness));
+    }
+    set_bar_counters(state, prices.size());
+    state.counters["evaluations"] = 30 * 50;
+}
+
+// Full default lattice (~1M combinations); items are combinations
+void BM_GridSweep(benchmark::State& state) {
+    const auto& prices = prices_for(state.range(0));
+    GridAxes axes = GridAxes::default_axes();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(grid_sweep(prices, axes, static_cast<size_t>(state.range(1))));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * axes.size()));
+    state.counters["bars"] = static_cast<double>(prices.size());
+}
+
+// Cost of one zone; range(0) toggles runtime collection
+void BM_ProfileZone(benchmark::State& state) {
+    Profiler::set_enabled(state.range(0) != 0);
+    for (auto _ : state) {
+        PROFILE_ZONE("bench");
+        benchmark::ClobberMemory();
+    }
+    Profiler::set_enabled(false);
+    Profiler::reset();
+}
+
+} // namespace
+
+// Series lengths 1k..10M bars
+BENCHMARK(BM_CalcSMA)->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10), {14, 50, 200}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcSMAMulti)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcMACD)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcRSI)->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10), {10, 14, 20}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcSMAFloat)->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10), {200}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcMACDFloat)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcRSIFloat)->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10), {14}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RSIPeriodsScalar)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RSILanes)->ArgsProduct({{100000, 1000000}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MACDSetsScalar)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MACDLanes)->ArgsProduct({{100000, 1000000}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BacktestDetailed)->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10), {50, 200}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BacktestDetailedCached)->ArgsProduct({benchmark::CreateRange(1000, 1000000, 10), {50, 200}})
+    ->Unit(benchmark::kMicrosecond);
+// A full 30 x 50 GA run; capped at 100k bars to keep the suite tractable
+BENCHMARK(BM_GeneticOptimize)->ArgsProduct({{1000, 10000, 100000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)->Iterations(1);
+
+BENCHMARK(BM_GridSweep)->ArgsProduct({{10000, 100000}, {1, 4}})->Unit(benchmark::kMillisecond)
+    ->Iterations(1);
+// Fixed iteration count bounds the events buffered while enabled
+BENCHMARK(BM_ProfileZone)->Arg(0)->Arg(1)->Iterations(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,47 @@
+#ifndef SYNTHETIC_PRICES_H
+#define SYNTHETIC_PRICES_H
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+// Seeded geometric Brownian motion close series for offline benchmarks
+inline std::vector<double> generate_gbm_prices(size_t count, unsigned int seed = 42,
+                                               double start = 100.0, double drift = 0.0002,
+                                               double volatility = 0.015) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<> shock(0.0, 1.0);
+
+    std::vector<double> prices(count);
+    double price = start;
+    for (size_t i = 0; i < count; ++i) {
+        price *= std::exp(drift - 0.5 * volatility * volatility + volatility * shock(gen));
+        prices[i] = price;
+    }
+    return prices;
+}
+
+// historical-price-full style JSON body (newest first, like the API) around
+// a GBM close series
+inline std::string generate_history_payload(size_t records, unsigned int seed = 99) {
+    auto closes = generate_gbm_prices(records, seed);
+    std::string body = "{\"symbol\":\"SYN\",\"historical\":[";
+    char line[256];
+    for (size_t i = 0; i < records; ++i) {
+        double c = closes[records - 1 - i];
+        int minute = static_cast<int>(i % 390);
+        std::snprintf(line, sizeof(line),
+                      "%s{\"date\":\"2024-03-%02d %02d:%02d:00\",\"open\":%.4f,\"high\":%.4f,\"low\":%.4f,"
+                      "\"close\":%.4f,\"adjClose\":%.4f,\"volume\":%zu}",
+                      i ? "," : "", 1 + static_cast<int>(i / 390 % 28), 9 + minute / 60, minute % 60,
+                      c * 0.999, c * 1.002, c * 0.997, c, c, 1000 + i % 5000);
+        body += line;
+    }
+    body += "]}";
+    return body;
+}
+
+#endif // SYNTHETIC_PRICES_H
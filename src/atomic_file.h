@@ -0,0 +1,18 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+
+// Sibling temp name for write-then-rename. The process id and a per-process
+// counter make it unique, so concurrent writers of one file (two threads
+// with the same symbol, or two processes) never write into the same temp
+// file; the last rename wins with a complete file.
+inline std::string unique_temp_path(const std::string& path) {
+    static std::atomic<uint64_t> counter{0};
+    return path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+}
+
+#endif // ATOMIC_FILE_H
@@ -0,0 +1,20 @@
+#include "backtest_workspace.h"
+
+template <typename T>
+static void reserve_buffers(IndicatorBuffers<T>& buffers, size_t bars) {
+    buffers.sma.reserve(bars);
+    buffers.rsi.reserve(bars);
+    buffers.macd.macd.reserve(bars);
+    buffers.macd.signal.reserve(bars);
+}
+
+void BacktestWorkspace::reserve(size_t bars) {
+    reserve_buffers(f64, bars);
+    reserve_buffers(f32, bars);
+    triggers.reserve(bars);
+}
+
+BacktestWorkspace& BacktestWorkspace::for_thread() {
+    thread_local BacktestWorkspace workspace;
+    return workspace;
+}
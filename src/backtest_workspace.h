@@ -0,0 +1,43 @@
+#ifndef BACKTEST_WORKSPACE_H
+#define BACKTEST_WORKSPACE_H
+
+#include <vector>
+#include <cstddef>
+#include "indicators.h"
+#include "streaming_indicators.h"
+
+// Indicator output buffers for one value type
+template <typename T>
+struct IndicatorBuffers {
+    std::vector<T> sma, rsi;
+    BasicMACD<T> macd;
+};
+
+// Scratch storage a backtest writes into instead of allocating. Buffers are
+// overwritten but never shrunk, so once they have grown to the longest series
+// and trigger count seen, further evaluations do no heap allocation.
+struct BacktestWorkspace {
+    IndicatorBuffers<double> f64;
+    IndicatorBuffers<float> f32;
+    std::vector<size_t> triggers;
+    StreamingSMA sma_stream{1};     // window of the fused scan
+
+    template <typename T>
+    IndicatorBuffers<T>& buffers();
+
+    // Grows every buffer to hold a `bars`-long series (and as many triggers)
+    // up front, so even the first evaluation does not allocate
+    void reserve(size_t bars);
+
+    // The calling thread's workspace. Backtests without an explicit one use
+    // it, so GA and pool workers keep theirs across evaluations.
+    static BacktestWorkspace& for_thread();
+};
+
+template <>
+inline IndicatorBuffers<double>& BacktestWorkspace::buffers<double>() { return f64; }
+
+template <>
+inline IndicatorBuffers<float>& BacktestWorkspace::buffers<float>() { return f32; }
+
+#endif // BACKTEST_WORKSPACE_H
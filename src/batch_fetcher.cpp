@@ -0,0 +1,220 @@
+#include "batch_fetcher.h"
+#include "exceptions.h"
+#include "atomic_file.h"
+#include "profiler.h"
+#include <curl/curl.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+ResponseCache::ResponseCache(const std::string& cache_dir, std::chrono::seconds max_age)
+    : dir(cache_dir), ttl(max_age) {
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) {
+        throw DataException("Cannot create response cache directory: " + dir);
+    }
+}
+
+std::string ResponseCache::key_for(const std::string& url) {
+    // Drop the apikey query parameter before hashing
+    std::string canonical = url;
+    size_t key_pos = canonical.find("apikey=");
+    if (key_pos != std::string::npos) {
+        size_t end = canonical.find('&', key_pos);
+        canonical.erase(key_pos, end == std::string::npos ? std::string::npos : end - key_pos + 1);
+        while (!canonical.empty() && (canonical.back() == '&' || canonical.back() == '?')) {
+            canonical.pop_back();
+        }
+    }
+
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : canonical) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return out.str();
+}
+
+std::string ResponseCache::path_for(const std::string& url) const {
+    return (fs::path(dir) / (key_for(url) + ".json")).string();
+}
+
+bool ResponseCache::get(const std::string& url, std::string& body) const {
+    const std::string path = path_for(url);
+    std::error_code ec;
+    auto modified = fs::last_write_time(path, ec);
+    if (ec || fs::file_time_type::clock::now() - modified > ttl) {
+        return false;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    body = contents.str();
+    return true;
+}
+
+void ResponseCache::put(const std::string& url, const std::string& body) const {
+    const std::string path = path_for(url);
+    const std::string tmp_path = unique_temp_path(path);
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        out.write(body.data(), static_cast<std::streamsize>(body.size()));
+        if (!out) {
+            throw DataException("Failed writing response cache entry: " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw DataException("Cannot move response cache entry into place: " + path);
+    }
+}
+
+static size_t append_body(void* contents, size_t size, size_t nmemb, void* userp) {
+    static_cast<std::string*>(userp)->append(static_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+// Points a pooled easy handle at the next pending URL
+static void start_transfer(CURLM* multi, CURL* easy, FetchResult& result, long timeout_seconds) {
+    curl_easy_setopt(easy, CURLOPT_URL, result.url.c_str());
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, append_body);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &result.body);
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, &result);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT, timeout_seconds);
+    curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");
+    curl_multi_add_handle(multi, easy);
+}
+
+std::vector<FetchResult> fetch_all(const std::vector<std::string>& urls, const FetchOptions& options) {
+    std::vector<FetchResult> results(urls.size());
+    fetch_each(urls, options, [&](size_t index, FetchResult&& result) { results[index] = std::move(result); });
+    return results;
+}
+
+namespace {
+
+// Multi handle and its pooled easy handles, released on every exit path
+struct TransferPool {
+    CURLM* multi = curl_multi_init();
+    std::vector<CURL*> handles;
+
+    ~TransferPool() {
+        for (CURL* easy : handles) {
+            curl_multi_remove_handle(multi, easy);
+            curl_easy_cleanup(easy);
+        }
+        if (multi) curl_multi_cleanup(multi);
+    }
+};
+
+} // namespace
+
+void fetch_each(const std::vector<std::string>& urls, const FetchOptions& options, const FetchCallback& on_done) {
+    PROFILE_ZONE("Batch HTTP Fetch");
+
+    // In-flight bodies; a slot is handed off once its transfer completes
+    std::vector<FetchResult> results(urls.size());
+    std::deque<size_t> pending;
+
+    std::unique_ptr<ResponseCache> cache;
+    if (!options.cache_dir.empty()) {
+        cache = std::make_unique<ResponseCache>(options.cache_dir, options.cache_ttl);
+    }
+
+    for (size_t i = 0; i < urls.size(); ++i) {
+        results[i].url = urls[i];
+        if (cache && cache->get(urls[i], results[i].body)) {
+            results[i].from_cache = true;
+            on_done(i, std::move(results[i]));
+        } else {
+            pending.push_back(i);
+        }
+    }
+    if (pending.empty()) return;
+    if (options.cache_only) {
+        for (size_t index : pending) {
+            results[index].error = "Not in response cache";
+            on_done(index, std::move(results[index]));
+        }
+        return;
+    }
+
+    TransferPool pool;
+    if (!pool.multi) {
+        throw APIException("Failed to initialize CURL multi handle");
+    }
+    CURLM* multi = pool.multi;
+
+    const size_t slots = std::max<size_t>(1, std::min(options.max_in_flight, pending.size()));
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(slots));
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(slots));
+
+    // A fixed pool of easy handles; each is reused for the next URL when its
+    // transfer completes so its connection stays warm
+    for (size_t i = 0; i < slots; ++i) {
+        CURL* easy = curl_easy_init();
+        if (!easy) break;
+        pool.handles.push_back(easy);
+        size_t index = pending.front();
+        pending.pop_front();
+        start_transfer(multi, easy, results[index], options.timeout_seconds);
+    }
+    if (pool.handles.empty()) {
+        throw APIException("Failed to initialize CURL easy handles");
+    }
+
+    int running = 0;
+    do {
+        curl_multi_perform(multi, &running);
+
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            CURL* easy = msg->easy_handle;
+            CURLcode code = msg->data.result;
+            FetchResult* result = nullptr;
+            curl_easy_getinfo(easy, CURLINFO_PRIVATE, reinterpret_cast<char**>(&result));
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &result->status);
+
+            if (code != CURLE_OK) {
+                result->error = curl_easy_strerror(code);
+            } else if (result->status >= 400) {
+                result->error = "HTTP status " + std::to_string(result->status);
+            } else if (cache) {
+                try {
+                    cache->put(result->url, result->body);
+                } catch (const TradingException& e) {
+                    std::cerr << "⚠️ " << e.what() << "\n";
+                }
+            }
+
+            curl_multi_remove_handle(multi, easy);
+            if (!pending.empty()) {
+                size_t index = pending.front();
+                pending.pop_front();
+                start_transfer(multi, easy, results[index], options.timeout_seconds);
+                ++running;
+            }
+            on_done(static_cast<size_t>(result - results.data()), std::move(*result));
+        }
+
+        if (running > 0) {
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+    } while (running > 0 || !pending.empty());
+}
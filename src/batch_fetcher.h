@@ -0,0 +1,58 @@
+#ifndef BATCH_FETCHER_H
+#define BATCH_FETCHER_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+struct FetchOptions {
+    size_t max_in_flight = 8;              // concurrent transfers (and open connections)
+    std::string cache_dir;                 // empty disables the response cache
+    std::chrono::seconds cache_ttl{24 * 3600};
+    long timeout_seconds = 30;
+    bool cache_only = false;               // never touch the network; misses are errors
+};
+
+struct FetchResult {
+    std::string url;
+    std::string body;
+    long status = 0;          // HTTP status; 0 when served from cache or on transport failure
+    bool from_cache = false;
+    std::string error;        // empty on success
+
+    bool ok() const { return error.empty(); }
+};
+
+// On-disk response cache. Entries are addressed by a hash of the request URL
+// with any apikey parameter removed, so keys never land on disk and rotating
+// the key keeps the cache warm. Entries older than the TTL are ignored.
+class ResponseCache {
+private:
+    std::string dir;
+    std::chrono::seconds ttl;
+
+public:
+    ResponseCache(const std::string& cache_dir, std::chrono::seconds max_age);
+
+    static std::string key_for(const std::string& url);
+    std::string path_for(const std::string& url) const;
+
+    bool get(const std::string& url, std::string& body) const;
+    void put(const std::string& url, const std::string& body) const;
+};
+
+// Downloads every URL over the curl multi interface, at most
+// options.max_in_flight at a time, reusing connections between transfers.
+// Results come back in the same order as `urls`; failures are reported per
+// URL rather than thrown. Expects curl_global_init to have run (CurlGlobal).
+std::vector<FetchResult> fetch_all(const std::vector<std::string>& urls, const FetchOptions& options = {});
+
+// Same downloads, handing each result to on_done(index into `urls`, result)
+// on the calling thread as soon as it is known: cache hits first, then
+// transfers in completion order. An exception from on_done aborts the rest.
+using FetchCallback = std::function<void(size_t, FetchResult&&)>;
+void fetch_each(const std::vector<std::string>& urls, const FetchOptions& options, const FetchCallback& on_done);
+
+#endif // BATCH_FETCHER_H
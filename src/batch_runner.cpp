@@ -0,0 +1,210 @@
+#include "batch_runner.h"
+#include "work_stealing_pool.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include "fitness_memo.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <cstdint>
+#include <filesystem>
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Stable per-symbol seed so a batch is reproducible regardless of scheduling
+static unsigned int symbol_seed(unsigned int base, const std::string& symbol) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : symbol) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return base ^ hash;
+}
+
+void optimize_symbol(Span<const double> closes, const BatchOptions& options, SymbolReport& report,
+                     IndicatorCache& cache) {
+    // Parallelism comes from running symbols side by side
+    GeneticOptimizer optimizer(options.population, options.generations, 0.1, 0.2,
+                               symbol_seed(options.seed, report.symbol), 1);
+    optimizer.set_verbose(false);
+
+    // Each symbol owns its memo file, so jobs never share one; float fitness
+    // values get their own file
+    FitnessMemo memo(backtest_fitness_id(options.precision));
+    std::string memo_path;
+    if (!options.memo_dir.empty()) {
+        memo_path = fitness_memo_path(options.memo_dir, report.symbol, options.precision);
+        memo.load(memo_path);
+        optimizer.set_memo(&memo);
+    }
+    OptimizationResult result = optimizer.optimize(closes, backtest_fitness_for(options.precision), cache);
+    if (!memo_path.empty()) {
+        memo.prune_untouched();
+        memo.save(memo_path);
+    }
+    report.memo_hits = result.memo_hits;
+    report.memo_lookups = result.memo_lookups;
+    report.optimized = true;
+    report.best_params = result.best_params;
+    report.best_fitness = result.best_fitness;
+}
+
+static void run_symbol(RawHistory& raw, const DataSourceConfig& source, const BatchOptions& options,
+                       SymbolReport& report) {
+    PROFILE_ZONE("Symbol");
+    auto start = Clock::now();
+    try {
+        LoadedHistory loaded = materialize_history(std::move(raw), source);
+        Span<const double> closes = loaded.columns().close;
+        report.bars = closes.size();
+        if (closes.size() < options.min_bars) {
+            throw DataException("Insufficient valid data points: " + std::to_string(closes.size()) +
+                                " (need at least " + std::to_string(options.min_bars) + ")");
+        }
+
+        report.backtest = backtest_detailed(closes, options.params);
+
+        if (options.optimize) {
+            IndicatorCache cache;
+            optimize_symbol(closes, options, report, cache);
+        }
+    } catch (const std::exception& e) {
+        report.error = e.what();
+    }
+    report.seconds = seconds_since(start);
+}
+
+BatchReport run_batch(const std::vector<std::string>& symbols, const DataSourceConfig& source,
+                      const BatchOptions& options) {
+    PROFILE_ZONE("Batch Run");
+
+    BatchReport report;
+    report.symbols.resize(symbols.size());
+    if (!options.memo_dir.empty()) {
+        std::filesystem::create_directories(options.memo_dir);
+    }
+    for (size_t i = 0; i < symbols.size(); ++i) report.symbols[i].symbol = symbols[i];
+    auto start = Clock::now();
+
+    // Each symbol becomes a compute job as soon as its history is ready; jobs
+    // land on the least loaded worker and idle workers steal, so a few long
+    // series do not leave the other threads waiting
+    std::vector<RawHistory> raws(symbols.size());
+    WorkStealingPool pool(options.threads);
+    pool.start([&](size_t i) { run_symbol(raws[i], source, options, report.symbols[i]); });
+
+    Clock::time_point compute_start = start;
+    bool computing = false;
+    try {
+        fetch_histories(symbols, source, [&](size_t i, RawHistory&& raw) {
+            if (!computing) {
+                compute_start = Clock::now();
+                computing = true;
+            }
+            double cost = static_cast<double>(raw.size_hint());
+            raws[i] = std::move(raw);
+            pool.submit(i, cost);
+        });
+    } catch (...) {
+        pool.finish();
+        throw;
+    }
+    report.fetch_seconds = seconds_since(start);
+    pool.finish();
+
+    report.wall_seconds = seconds_since(start);
+    report.compute_seconds = computing ? seconds_since(compute_start) : 0.0;
+    report.threads = pool.size();
+    report.steals = pool.steals();
+    return report;
+}
+
+std::vector<std::string> read_symbol_list(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw DataException("Cannot open symbol list: " + path);
+    }
+
+    std::vector<std::string> symbols;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        size_t last = line.find_last_not_of(" \t\r");
+        symbols.push_back(line.substr(first, last - first + 1));
+    }
+    return symbols;
+}
+
+size_t BatchReport::succeeded() const {
+    size_t count = 0;
+    for (const auto& s : symbols) count += s.ok();
+    return count;
+}
+
+size_t BatchReport::total_bars() const {
+    size_t bars = 0;
+    for (const auto& s : symbols) bars += s.bars;
+    return bars;
+}
+
+void write_batch_csv(const BatchReport& report, std::ostream& out) {
+    out << "symbol,bars,triggers,successes,win_rate,fitness,optimized,best_fitness,"
+           "ma_period,rsi_period,rsi_threshold,stop_loss,take_profit,look_ahead,seconds,error\n";
+    out << std::setprecision(10);
+    for (const auto& s : report.symbols) {
+        out << s.symbol << ',' << s.bars << ',' << s.backtest.triggers << ',' << s.backtest.successes << ','
+            << s.backtest.win_rate << ',' << s.backtest.fitness << ',' << (s.optimized ? 1 : 0) << ',';
+        if (s.optimized) {
+            const StrategyParameters& p = s.best_params;
+            out << s.best_fitness << ',' << p.ma_period << ',' << p.rsi_period << ',' << p.rsi_threshold << ','
+                << p.stop_loss << ',' << p.take_profit << ',' << p.look_ahead << ',';
+        } else {
+            out << ",,,,,,,";
+        }
+        // Quote errors; they may contain commas
+        std::string error = s.error;
+        for (size_t pos = error.find('"'); pos != std::string::npos; pos = error.find('"', pos + 2)) {
+            error.insert(pos, 1, '"');
+        }
+        out << s.seconds << ",\"" << error << "\"\n";
+    }
+}
+
+void print_batch_summary(const BatchReport& report, std::ostream& out) {
+    double wall = report.wall_seconds > 0 ? report.wall_seconds : 1e-9;
+    double compute = report.compute_seconds > 0 ? report.compute_seconds : 1e-9;
+
+    out << "\n📦 Batch Summary\n";
+    out << "  Symbols   : " << report.succeeded() << " ok / " << report.symbols.size() << " total\n";
+    out << "  Bars      : " << report.total_bars() << "\n";
+    out << "  Threads   : " << report.threads << " compute + 1 fetch (" << report.steals << " steals)\n";
+    out << std::fixed << std::setprecision(3);
+    out << "  Fetch     : " << report.fetch_seconds << " s\n";
+    out << "  Compute   : " << report.compute_seconds << " s\n";
+    out << "  Wall      : " << report.wall_seconds << " s\n";
+    out << std::setprecision(1);
+    out << "  Throughput: " << report.symbols.size() / wall << " symbols/s, "
+        << report.total_bars() / wall << " bars/s (compute only: "
+        << report.total_bars() / compute << " bars/s)\n";
+
+    size_t memo_hits = 0, memo_lookups = 0;
+    for (const auto& s : report.symbols) {
+        memo_hits += s.memo_hits;
+        memo_lookups += s.memo_lookups;
+    }
+    if (memo_lookups > 0) {
+        out << "  Memo      : " << memo_hits << " of " << memo_lookups << " evaluations reused ("
+            << 100.0 * memo_hits / memo_lookups << "%)\n";
+    }
+
+    for (const auto& s : report.symbols) {
+        if (!s.ok()) out << "  ❌ " << s.symbol << ": " << s.error << "\n";
+    }
+}
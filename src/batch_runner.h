@@ -0,0 +1,70 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <thread>
+#include <cstddef>
+#include "optimizer.h"
+#include "data_source.h"
+
+struct BatchOptions {
+    size_t threads = std::thread::hardware_concurrency();
+    StrategyParameters params;       // strategy backtested on every symbol
+    bool optimize = false;           // also run the GA per symbol
+    size_t population = 30;
+    int generations = 50;
+    unsigned int seed = 42;          // mixed with the symbol for per-symbol runs
+    size_t min_bars = 250;
+    std::string memo_dir;            // per-symbol fitness memos for --optimize; empty = none
+    Precision precision = Precision::Double;  // value type of the GA's backtests
+};
+
+struct SymbolReport {
+    std::string symbol;
+    size_t bars = 0;
+    BacktestResult backtest{0.0, 0.0, 0, 0};
+    bool optimized = false;
+    StrategyParameters best_params;
+    double best_fitness = 0.0;
+    size_t memo_hits = 0;
+    size_t memo_lookups = 0;
+    double seconds = 0.0;            // load + indicators + backtest (+ optimize)
+    std::string error;               // non-empty when the symbol failed
+
+    bool ok() const { return error.empty(); }
+};
+
+struct BatchReport {
+    std::vector<SymbolReport> symbols;   // same order as the input list
+    double fetch_seconds = 0.0;      // until the last history arrived
+    double compute_seconds = 0.0;    // from the first compute job; overlaps fetch
+    double wall_seconds = 0.0;
+    size_t threads = 0;
+    size_t steals = 0;
+
+    size_t succeeded() const;
+    size_t total_bars() const;
+};
+
+// Runs load -> indicators -> backtest (-> optimize) for every symbol. Network
+// fetches for symbols without a local store run concurrently while each
+// symbol is handed to a work-stealing pool of options.threads compute workers
+// as soon as its history is ready: local stores first, largest series first,
+// then responses in arrival order. Per-symbol failures are recorded, not thrown.
+BatchReport run_batch(const std::vector<std::string>& symbols, const DataSourceConfig& source,
+                      const BatchOptions& options);
+
+// GA step of a batch job: seeded from options.seed and the symbol, through the
+// per-symbol memo in options.memo_dir when set. Fills the optimize fields of `report`.
+void optimize_symbol(Span<const double> closes, const BatchOptions& options, SymbolReport& report,
+                     IndicatorCache& cache);
+
+// One symbol per line; blank lines and '#' comments are ignored
+std::vector<std::string> read_symbol_list(const std::string& path);
+
+void write_batch_csv(const BatchReport& report, std::ostream& out);
+void print_batch_summary(const BatchReport& report, std::ostream& out);
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,68 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// Blocking FIFO with a fixed capacity, connecting pipeline stages: a full
+// queue stalls its producers, so a slow stage throttles the ones before it
+// instead of letting work pile up in memory.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t max_items) : capacity(max_items > 0 ? max_items : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Blocks while full; returns false (dropping `item`) once closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [&] { return items.size() < capacity || closed; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        if (items.size() > peak) peak = items.size();
+        not_empty.notify_one();
+        return true;
+    }
+
+    // Blocks while empty; returns false once closed and drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [&] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    // No more pushes; consumers drain what is left
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+    size_t max_size() const { return capacity; }
+
+    // Highest occupancy seen; at capacity means the consumer was the bottleneck
+    size_t high_water() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return peak;
+    }
+
+private:
+    const size_t capacity;
+    mutable std::mutex mutex;
+    std::condition_variable not_empty, not_full;
+    std::deque<T> items;
+    size_t peak = 0;
+    bool closed = false;
+};
+
+#endif // BOUNDED_QUEUE_H
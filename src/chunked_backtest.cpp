@@ -0,0 +1,125 @@
+#include "chunked_backtest.h"
+#include "price_store.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include <algorithm>
+
+ChunkedBacktest::ChunkedBacktest(const StrategyParameters& strategy, size_t bars)
+    : params(strategy),
+      exit_rule(strategy.stop_loss, strategy.take_profit, strategy.look_ahead),
+      total_bars(bars),
+      scan_begin(std::max<size_t>(strategy.ma_period, 1)),
+      scan_end(bars > static_cast<size_t>(strategy.look_ahead) ? bars - strategy.look_ahead : 0),
+      // Same minimum as backtest_detailed
+      enough_data(bars >= static_cast<size_t>(strategy.ma_period + strategy.look_ahead + 50)),
+      entry(CloseAboveSMA(sma_window, strategy.ma_period), MACDBullishCross(),
+            RSIBelow(strategy.rsi_period, strategy.rsi_threshold)),
+      trades(static_cast<size_t>(std::max(strategy.look_ahead, 0)) + 1) {}
+
+void ChunkedBacktest::resolve_open_trades(size_t bar, double close) {
+    size_t index = head;
+    for (size_t k = 0; k < pending; ++k) {
+        OpenTrade& trade = trades[index];
+        if (trade.open) {
+            ExitReason hit = TakeProfitStopLoss<>::level_hit(close, trade.stop, trade.take);
+            if (hit != ExitReason::Expired || bar == trade.entry + params.look_ahead) {
+                trade.reason = hit;
+                trade.open = false;
+            }
+        }
+        if (++index == trades.size()) index = 0;
+    }
+}
+
+// Tallies resolved trades from the front only, so returns are summed in
+// entry order exactly like run_strategy
+void ChunkedBacktest::commit_resolved() {
+    while (pending > 0 && !trades[head].open) {
+        const OpenTrade& trade = trades[head];
+        ++tally.triggers;
+        if (trade.reason == ExitReason::TakeProfit) ++tally.successes;
+        if (trade.reason != ExitReason::Expired) {
+            tally.total_return += exit_rule.trade_return(trade.reason);
+        }
+        if (++head == trades.size()) head = 0;
+        --pending;
+    }
+}
+
+void ChunkedBacktest::feed(Span<const double> closes) {
+    if (closes.size() > total_bars - next_bar) {
+        throw DataException("Chunked backtest fed more bars than declared");
+    }
+    if (!enough_data) {
+        next_bar += closes.size();
+        return;
+    }
+
+    for (size_t k = 0; k < closes.size(); ++k, ++next_bar) {
+        double close = closes[k];
+        if (pending > 0) {
+            resolve_open_trades(next_bar, close);
+            commit_resolved();
+        }
+        // Indicators stop advancing where the entry scan ends
+        if (next_bar >= scan_end) continue;
+        bool fire = entry.update(next_bar, close);
+        if (fire && next_bar >= scan_begin) {
+            size_t tail = head + pending;
+            if (tail >= trades.size()) tail -= trades.size();
+            // With no look-ahead bars a trade expires as it opens
+            bool open = params.look_ahead > 0;
+            trades[tail] = {next_bar, exit_rule.stop_price(close), exit_rule.take_price(close), ExitReason::Expired,
+                            open};
+            ++pending;
+            if (!open) commit_resolved();
+        }
+    }
+}
+
+BacktestResult ChunkedBacktest::finish() const {
+    if (next_bar != total_bars) {
+        throw DataException("Chunked backtest finished before all bars were fed");
+    }
+    if (!enough_data) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+    // Every entry precedes scan_end, so its window closed by the last bar
+    return score_outcomes(tally.triggers, tally.successes, tally.total_return);
+}
+
+BacktestResult backtest_chunked(Span<const double> closes, const StrategyParameters& params, size_t chunk_bars) {
+    if (chunk_bars == 0) {
+        throw DataException("Chunk size must be positive");
+    }
+    try {
+        ChunkedBacktest backtest(params, closes.size());
+        for (size_t begin = 0; begin < closes.size(); begin += chunk_bars) {
+            size_t count = std::min(chunk_bars, closes.size() - begin);
+            backtest.feed(Span<const double>(closes.data() + begin, count));
+        }
+        return backtest.finish();
+    } catch (const CalculationException&) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+}
+
+BacktestResult backtest_chunked(const std::string& store_path, const StrategyParameters& params,
+                                size_t chunk_bars) {
+    if (chunk_bars == 0) {
+        throw DataException("Chunk size must be positive");
+    }
+    PROFILE_ZONE("Chunked backtest");
+    PriceStoreColumnReader reader(store_path, PriceColumn::Close);
+    try {
+        ChunkedBacktest backtest(params, reader.size());
+        std::vector<double> block;
+        block.reserve(std::min(chunk_bars, reader.size()));
+        while (reader.read(block, chunk_bars) > 0) {
+            backtest.feed(block);
+        }
+        return backtest.finish();
+    } catch (const CalculationException&) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+}
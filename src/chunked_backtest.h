@@ -0,0 +1,73 @@
+#ifndef CHUNKED_BACKTEST_H
+#define CHUNKED_BACKTEST_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "span.h"
+#include "optimizer.h"
+#include "strategy_engine.h"
+#include "streaming_indicators.h"
+
+// Bars per block when none is given: 512 KiB of closes
+constexpr size_t DEFAULT_CHUNK_BARS = 65536;
+
+// The fused backtest_detailed fed one block of closes at a time. Indicator
+// state (SMA window, MACD and RSI averages) and trades whose look-ahead
+// window is still open carry across block boundaries, so memory is
+// O(ma_period + look_ahead) plus the caller's block, and the result is
+// identical to backtest_detailed on the whole series whatever the split.
+class ChunkedBacktest {
+private:
+    // One entry waiting for its exit; trades stay in entry order
+    struct OpenTrade {
+        size_t entry;
+        double stop, take;
+        ExitReason reason;
+        bool open;
+    };
+
+    StrategyParameters params;
+    TakeProfitStopLoss<> exit_rule;
+    size_t total_bars;
+    size_t scan_begin, scan_end;   // entry bars, as in backtest_detailed
+    size_t next_bar = 0;
+    bool enough_data;
+
+    StreamingSMA sma_window{1};
+    AllOf<CloseAboveSMA, MACDBullishCross, RSIBelow> entry;
+
+    // Ring of at most look_ahead + 1 trades, oldest at `head`
+    std::vector<OpenTrade> trades;
+    size_t head = 0, pending = 0;
+    TradeTally tally;
+
+    void resolve_open_trades(size_t bar, double close);
+    void commit_resolved();
+
+public:
+    // `total_bars` is the full series length; the entry scan ends
+    // look_ahead bars before it. Throws CalculationException for invalid
+    // indicator periods.
+    ChunkedBacktest(const StrategyParameters& strategy, size_t total_bars);
+
+    // The next closes in order; throws DataException past total_bars
+    void feed(Span<const double> closes);
+
+    size_t bars_seen() const { return next_bar; }
+    size_t open_trades() const { return pending; }
+
+    // Result once all total_bars have been fed (DataException otherwise)
+    BacktestResult finish() const;
+};
+
+// backtest_detailed(closes, params) computed chunk_bars at a time
+BacktestResult backtest_chunked(Span<const double> closes, const StrategyParameters& params,
+                                size_t chunk_bars = DEFAULT_CHUNK_BARS);
+
+// Same over the close column of a price store file, read with pread into one
+// reused chunk_bars buffer; never holds the whole series
+BacktestResult backtest_chunked(const std::string& store_path, const StrategyParameters& params,
+                                size_t chunk_bars = DEFAULT_CHUNK_BARS);
+
+#endif // CHUNKED_BACKTEST_H
@@ -0,0 +1,53 @@
+#ifndef COMPENSATED_SUM_H
+#define COMPENSATED_SUM_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// Error-free addition (Neumaier): adds x to sum, accumulating the rounding error in comp.
+// Shared by the batch and streaming SMA so both produce bit-identical results.
+template <typename T>
+inline void compensated_add(T& sum, T& comp, T x) {
+    T t = sum + x;
+    if (std::fabs(sum) >= std::fabs(x)) {
+        comp += (sum - t) + x;
+    } else {
+        comp += (x - t) + sum;
+    }
+    sum = t;
+}
+
+// Non-finite values of a rolling window. They are kept out of the running
+// sum (enter/leave return 0 for them) and counted here instead, so one NaN
+// or Inf only affects the windows that contain it. While any remain, they
+// alone decide the window sum, as they would in direct summation.
+struct NonFiniteWindow {
+    size_t nan = 0, pos_inf = 0, neg_inf = 0;
+
+    template <typename T>
+    T enter(T x) { return count(x, 1); }
+    template <typename T>
+    T leave(T x) { return count(x, static_cast<size_t>(-1)); }
+
+    bool clean() const { return nan + pos_inf + neg_inf == 0; }
+
+    // Sum of a window that is not clean
+    template <typename T>
+    T sum() const {
+        if (nan > 0 || (pos_inf > 0 && neg_inf > 0)) return std::numeric_limits<T>::quiet_NaN();
+        return pos_inf > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+    }
+
+private:
+    template <typename T>
+    T count(T x, size_t delta) {
+        if (std::isfinite(x)) return x;
+        if (std::isnan(x)) nan += delta;
+        else if (x > 0) pos_inf += delta;
+        else neg_inf += delta;
+        return T(0);
+    }
+};
+
+#endif // COMPENSATED_SUM_H
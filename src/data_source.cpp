@@ -0,0 +1,149 @@
+#include "data_source.h"
+#include "batch_fetcher.h"
+#include "price_parser.h"
+#include "exceptions.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+DataSourceConfig DataSourceConfig::from_env() {
+    DataSourceConfig config;
+    if (const char* dir = std::getenv("PRICE_STORE_DIR")) config.store_dir = dir;
+    if (const char* dir = std::getenv("RESPONSE_CACHE_DIR")) config.response_cache_dir = dir;
+    if (const char* key = std::getenv("API_KEY")) config.api_key = key;
+    return config;
+}
+
+std::string DataSourceConfig::store_path(const std::string& symbol) const {
+    if (store_dir.empty()) return {};
+    if (!is_valid_symbol(symbol)) {
+        throw DataException("Invalid symbol: " + symbol);
+    }
+    return (fs::path(store_dir) / (symbol + ".atps")).string();
+}
+
+size_t RawHistory::size_hint() const {
+    if (!store_path.empty()) {
+        std::error_code ec;
+        auto bytes = fs::file_size(store_path, ec);
+        // Stores hold 48 bytes per bar; weigh them like ~150-byte JSON records
+        return ec ? 0 : static_cast<size_t>(bytes) * 3;
+    }
+    return body.size();
+}
+
+std::vector<RawHistory> fetch_histories(const std::vector<std::string>& symbols, const DataSourceConfig& config) {
+    std::vector<RawHistory> raws(symbols.size());
+    fetch_histories(symbols, config, [&](size_t index, RawHistory&& raw) { raws[index] = std::move(raw); });
+    return raws;
+}
+
+void fetch_histories(const std::vector<std::string>& symbols, const DataSourceConfig& config,
+                     const HistoryCallback& on_ready) {
+    std::vector<RawHistory> local;  // stores, handed out largest first
+    std::vector<size_t> local_owner;
+    std::vector<std::string> urls;
+    std::vector<size_t> url_owner;
+
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        RawHistory raw;
+        raw.symbol = symbols[i];
+        if (!is_valid_symbol(symbols[i])) {
+            raw.error = "Invalid symbol: " + symbols[i];
+            on_ready(i, std::move(raw));
+            continue;
+        }
+        std::string path = config.store_path(symbols[i]);
+        if (!path.empty() && fs::exists(path)) {
+            raw.store_path = path;
+            local.push_back(std::move(raw));
+            local_owner.push_back(i);
+            continue;
+        }
+        urls.push_back(historical_price_url(symbols[i], config.api_key));
+        url_owner.push_back(i);
+    }
+
+    std::vector<size_t> order(local.size());
+    std::vector<size_t> hints(local.size());
+    for (size_t k = 0; k < local.size(); ++k) {
+        order[k] = k;
+        hints[k] = local[k].size_hint();
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return hints[a] > hints[b]; });
+    for (size_t k : order) on_ready(local_owner[k], std::move(local[k]));
+
+    if (urls.empty()) return;
+
+    if (config.api_key.empty() && config.response_cache_dir.empty()) {
+        for (size_t i : url_owner) {
+            RawHistory raw;
+            raw.symbol = symbols[i];
+            raw.error = "API key not set. Please set the API_KEY environment variable.";
+            on_ready(i, std::move(raw));
+        }
+        return;
+    }
+
+    // Without a key only cached responses can be served; a request with an
+    // empty apikey would just come back as an error from the API
+    FetchOptions options;
+    options.max_in_flight = config.max_in_flight;
+    options.cache_dir = config.response_cache_dir;
+    options.cache_only = config.api_key.empty();
+
+    fetch_each(urls, options, [&](size_t k, FetchResult&& fetched) {
+        RawHistory raw;
+        raw.symbol = symbols[url_owner[k]];
+        if (!fetched.ok()) {
+            raw.error = config.api_key.empty()
+                ? "API key not set and no cached response for " + raw.symbol
+                : "Request failed: " + fetched.error;
+        } else if (fetched.body.empty()) {
+            raw.error = "Empty response received from API";
+        } else {
+            raw.body = std::move(fetched.body);
+            raw.from_cache = fetched.from_cache;
+        }
+        on_ready(url_owner[k], std::move(raw));
+    });
+}
+
+LoadedHistory materialize_history(RawHistory raw, const DataSourceConfig& config) {
+    if (!raw.ok()) {
+        throw APIException(raw.error);
+    }
+
+    LoadedHistory loaded;
+    if (!raw.store_path.empty()) {
+        loaded.store = std::make_unique<MappedPriceStore>(raw.store_path);
+        loaded.series.symbol = loaded.store->symbol();
+        loaded.origin = HistoryOrigin::PriceStore;
+        loaded.total_records = loaded.store->size();
+        return loaded;
+    }
+
+    ParsedHistory parsed = parse_price_history(raw.body, raw.symbol);
+    loaded.series = std::move(parsed.series);
+    loaded.origin = raw.from_cache ? HistoryOrigin::ResponseCache : HistoryOrigin::Network;
+    loaded.total_records = parsed.total_records;
+    loaded.skipped_records = parsed.skipped_records;
+
+    if (!config.store_dir.empty()) {
+        fs::create_directories(config.store_dir);
+        loaded.saved_store = config.store_path(raw.symbol);
+        write_price_store(loaded.saved_store, loaded.series);
+    }
+    return loaded;
+}
+
+PriceColumns LoadedHistory::columns() const {
+    return store ? store->columns() : PriceColumns(series);
+}
+
+LoadedHistory load_history(const std::string& symbol, const DataSourceConfig& config) {
+    return materialize_history(std::move(fetch_histories({symbol}, config).front()), config);
+}
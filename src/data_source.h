@@ -0,0 +1,74 @@
+#ifndef DATA_SOURCE_H
+#define DATA_SOURCE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include "price_store.h"
+
+// Where price histories come from, in order of preference: a converted .atps
+// file in store_dir, a cached raw response in response_cache_dir, then the API.
+struct DataSourceConfig {
+    std::string store_dir;            // PRICE_STORE_DIR; empty disables the store
+    std::string response_cache_dir;   // RESPONSE_CACHE_DIR; empty disables the cache
+    std::string api_key;              // API_KEY
+    size_t max_in_flight = 8;
+
+    static DataSourceConfig from_env();
+    // <store_dir>/<symbol>.atps; throws DataException unless is_valid_symbol
+    std::string store_path(const std::string& symbol) const;
+};
+
+enum class HistoryOrigin { PriceStore, ResponseCache, Network };
+
+// Result of the I/O step: either a store file to map or a raw API body to parse
+struct RawHistory {
+    std::string symbol;
+    std::string store_path;   // set when a converted store already exists
+    std::string body;
+    bool from_cache = false;
+    std::string error;
+
+    bool ok() const { return error.empty(); }
+    // Relative processing cost, for scheduling
+    size_t size_hint() const;
+};
+
+struct LoadedHistory {
+    PriceSeries series;                      // parsed bars; empty when mapped
+    std::unique_ptr<MappedPriceStore> store; // mapped store, when origin is PriceStore
+    HistoryOrigin origin = HistoryOrigin::Network;
+    size_t total_records = 0;
+    size_t skipped_records = 0;
+    std::string saved_store;  // store file written while loading, if any
+
+    // Bars from whichever of `store` and `series` holds them, without copying
+    PriceColumns columns() const;
+};
+
+// I/O step for many symbols: existing stores are located, everything else is
+// downloaded concurrently (through the response cache). Never throws for a
+// single symbol; failures, including symbols rejected by is_valid_symbol,
+// are reported in RawHistory::error.
+std::vector<RawHistory> fetch_histories(const std::vector<std::string>& symbols, const DataSourceConfig& config);
+
+// Same I/O step, handing each history to on_ready(index into `symbols`, raw)
+// on the calling thread as soon as it is available: failures and existing
+// stores at once (largest store first), then responses as they arrive from
+// the cache or the network, so parsing and backtests need not wait for the
+// slowest download.
+using HistoryCallback = std::function<void(size_t, RawHistory&&)>;
+void fetch_histories(const std::vector<std::string>& symbols, const DataSourceConfig& config,
+                     const HistoryCallback& on_ready);
+
+// CPU step: maps the store (its columns are read in place) or parses the
+// body, converting fresh responses into the store when store_dir is set.
+// Throws on failure.
+LoadedHistory materialize_history(RawHistory raw, const DataSourceConfig& config);
+
+// Both steps for one symbol
+LoadedHistory load_history(const std::string& symbol, const DataSourceConfig& config);
+
+#endif // DATA_SOURCE_H
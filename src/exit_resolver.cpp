@@ -0,0 +1,134 @@
+#include "exit_resolver.h"
+#include "exceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// A NaN bar never hits a level in the sequential loop, so it must never
+// dominate a block: it counts as -inf for the max tables and +inf for the min
+static double max_skipping_nan(double a, double b) {
+    if (std::isnan(a)) a = -std::numeric_limits<double>::infinity();
+    if (std::isnan(b)) b = -std::numeric_limits<double>::infinity();
+    return std::max(a, b);
+}
+
+static double min_skipping_nan(double a, double b) {
+    if (std::isnan(a)) a = std::numeric_limits<double>::infinity();
+    if (std::isnan(b)) b = std::numeric_limits<double>::infinity();
+    return std::min(a, b);
+}
+
+ExitResolver::ExitResolver(Span<const double> p, int max_window) : prices(p) {
+    if (max_window <= 0) {
+        throw CalculationException("Exit window must be positive");
+    }
+
+    // Levels 1..K where 2^K <= max_window; level 0 is the price series itself
+    Span<const double> prev_max = prices;
+    Span<const double> prev_min = prices;
+    for (size_t width = 2; width <= static_cast<size_t>(max_window) && width <= prices.size(); width *= 2) {
+        size_t half = width / 2;
+        size_t count = prices.size() - width + 1;
+        std::vector<double> max_level(count), min_level(count);
+        for (size_t i = 0; i < count; ++i) {
+            max_level[i] = max_skipping_nan(prev_max[i], prev_max[i + half]);
+            min_level[i] = min_skipping_nan(prev_min[i], prev_min[i + half]);
+        }
+        max_table.push_back(std::move(max_level));
+        min_table.push_back(std::move(min_level));
+        prev_max = max_table.back();
+        prev_min = min_table.back();
+    }
+}
+
+size_t ExitResolver::first_at_or_above(size_t lo, size_t hi, double x) const {
+    size_t pos = lo;
+    size_t top = max_table.size();
+    size_t top_width = size_t(1) << top;
+
+    // Skip whole top-level blocks that stay below x (only needed when the
+    // window is longer than the tables cover)
+    while (pos + top_width - 1 <= hi) {
+        Span<const double> level = top == 0 ? prices : Span<const double>(max_table[top - 1]);
+        if (level[pos] >= x) break;
+        pos += top_width;
+    }
+    // Then descend: each block size is tried at most once. Skip a block
+    // unless it holds a hit, so a NaN bar at level 0 is stepped over
+    for (size_t k = top + 1; k-- > 0;) {
+        size_t width = size_t(1) << k;
+        if (pos + width - 1 > hi) continue;
+        Span<const double> level = k == 0 ? prices : Span<const double>(max_table[k - 1]);
+        if (!(level[pos] >= x)) pos += width;
+    }
+    return pos <= hi ? pos : npos;
+}
+
+size_t ExitResolver::first_at_or_below(size_t lo, size_t hi, double x) const {
+    size_t pos = lo;
+    size_t top = min_table.size();
+    size_t top_width = size_t(1) << top;
+
+    while (pos + top_width - 1 <= hi) {
+        Span<const double> level = top == 0 ? prices : Span<const double>(min_table[top - 1]);
+        if (level[pos] <= x) break;
+        pos += top_width;
+    }
+    for (size_t k = top + 1; k-- > 0;) {
+        size_t width = size_t(1) << k;
+        if (pos + width - 1 > hi) continue;
+        Span<const double> level = k == 0 ? prices : Span<const double>(min_table[k - 1]);
+        if (!(level[pos] <= x)) pos += width;
+    }
+    return pos <= hi ? pos : npos;
+}
+
+ExitOutcome ExitResolver::resolve(size_t entry, double stop_price, double take_price, int look_ahead) const {
+    if (prices.empty()) {
+        return {ExitReason::Expired, 0};
+    }
+    size_t lo = entry + 1;
+    size_t hi = std::min(entry + static_cast<size_t>(std::max(look_ahead, 0)), prices.size() - 1);
+    if (look_ahead <= 0 || lo > hi) {
+        return {ExitReason::Expired, std::min(entry, prices.size() - 1)};
+    }
+
+    size_t take_at = first_at_or_above(lo, hi, take_price);
+    // The stop only matters if it is hit strictly before the take-profit bar
+    size_t stop_hi = take_at == npos ? hi : take_at - 1;
+    size_t stop_at = lo <= stop_hi ? first_at_or_below(lo, stop_hi, stop_price) : npos;
+
+    if (stop_at != npos) return {ExitReason::StopLoss, stop_at};
+    if (take_at != npos) return {ExitReason::TakeProfit, take_at};
+    return {ExitReason::Expired, hi};
+}
+
+std::vector<ExitOutcome> ExitResolver::resolve_batch(const std::vector<size_t>& entries,
+                                                     const ExitLevels& levels, int look_ahead) const {
+    std::vector<ExitOutcome> outcomes;
+    resolve_batch(entries, levels, look_ahead, outcomes);
+    return outcomes;
+}
+
+void ExitResolver::resolve_batch(const std::vector<size_t>& entries, const ExitLevels& levels, int look_ahead,
+                                 std::vector<ExitOutcome>& outcomes) const {
+    outcomes.clear();
+    outcomes.reserve(entries.size());
+    for (size_t entry : entries) {
+        double entry_price = prices[entry];
+        double stop_price = entry_price * (1.0 - levels.stop_loss);
+        double take_price = entry_price * (1.0 + levels.take_profit);
+        outcomes.push_back(resolve(entry, stop_price, take_price, look_ahead));
+    }
+}
+
+std::vector<std::vector<ExitOutcome>> ExitResolver::resolve_batch(const std::vector<size_t>& entries,
+                                                                  const std::vector<ExitLevels>& levels,
+                                                                  int look_ahead) const {
+    std::vector<std::vector<ExitOutcome>> outcomes;
+    outcomes.reserve(levels.size());
+    for (const ExitLevels& level : levels) {
+        outcomes.push_back(resolve_batch(entries, level, look_ahead));
+    }
+    return outcomes;
+}
@@ -0,0 +1,65 @@
+#ifndef EXIT_RESOLVER_H
+#define EXIT_RESOLVER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "span.h"
+
+enum class ExitReason : uint8_t { TakeProfit, StopLoss, Expired };
+
+struct ExitOutcome {
+    ExitReason reason;
+    size_t exit_index;  // bar that hit the level; entry + look_ahead (clamped) when expired
+};
+
+// Rolling max/min table size for resolvers shared through IndicatorCache;
+// covers the GA's look_ahead range (5-20 bars)
+constexpr int EXIT_TABLE_WINDOW = 32;
+
+// Stop-loss / take-profit pair expressed as fractions of the entry price
+struct ExitLevels {
+    double stop_loss;
+    double take_profit;
+};
+
+// Answers "first bar in (entry, entry + look_ahead] with price >= take or
+// price <= stop" in O(log max_window) using power-of-two rolling max/min
+// tables. Take-profit wins when both levels are hit on the same bar, matching
+// the sequential look-ahead loops. Memory is O(n log max_window); windows
+// longer than max_window are still answered exactly, just in more steps.
+// NaN closes never hit a level, as in the loops.
+// The resolver keeps a view of `prices`, which must outlive it.
+class ExitResolver {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    ExitResolver(Span<const double> prices, int max_window = EXIT_TABLE_WINDOW);
+
+    ExitOutcome resolve(size_t entry, double stop_price, double take_price, int look_ahead) const;
+
+    // One outcome per entry, with levels derived from each entry's price
+    std::vector<ExitOutcome> resolve_batch(const std::vector<size_t>& entries,
+                                           const ExitLevels& levels, int look_ahead) const;
+    // Same, overwriting `outcomes` so a kept buffer is reused
+    void resolve_batch(const std::vector<size_t>& entries, const ExitLevels& levels, int look_ahead,
+                       std::vector<ExitOutcome>& outcomes) const;
+
+    // outcomes[k][t] is the exit of entries[t] under levels[k]
+    std::vector<std::vector<ExitOutcome>> resolve_batch(const std::vector<size_t>& entries,
+                                                        const std::vector<ExitLevels>& levels,
+                                                        int look_ahead) const;
+
+    size_t size() const { return prices.size(); }
+
+private:
+    // Smallest j in [lo, hi] with prices[j] >= x (or <= x for the min variant), else npos
+    size_t first_at_or_above(size_t lo, size_t hi, double x) const;
+    size_t first_at_or_below(size_t lo, size_t hi, double x) const;
+
+    Span<const double> prices;
+    // max_table[k][i] = max(prices[i .. i + 2^(k+1))), likewise for min
+    std::vector<std::vector<double>> max_table, min_table;
+};
+
+#endif // EXIT_RESOLVER_H
@@ -0,0 +1,252 @@
+#include "fitness_memo.h"
+#include "exceptions.h"
+#include "atomic_file.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char MEMO_MAGIC[4] = {'A', 'T', 'F', 'M'};
+const uint32_t MEMO_VERSION = 2;  // 2: fitness id, run stamps
+
+struct MemoHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t fitness_id;
+    uint32_t run;
+    uint32_t reserved;
+    uint64_t entry_count;
+    uint64_t population_count;
+};
+
+struct MemoRecord {
+    uint64_t series;
+    int32_t ma_period, rsi_period, look_ahead;
+    uint32_t last_run;
+    uint64_t rsi_threshold, stop_loss, take_profit;
+    double fitness;
+};
+
+struct PopulationRecord {
+    int32_t ma_period, rsi_period, look_ahead, reserved;
+    double rsi_threshold, stop_loss, take_profit;
+};
+
+static_assert(sizeof(MemoHeader) == 40, "memo header layout");
+static_assert(sizeof(MemoRecord) == 56, "memo record layout");
+static_assert(sizeof(PopulationRecord) == 40, "population record layout");
+
+uint64_t canonical_bits(double value) {
+    if (value == 0.0) value = 0.0;  // folds -0.0
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+MemoKey MemoKey::make(uint64_t fitness_id, uint64_t series_id, const StrategyParameters& params) {
+    return {fitness_id,
+            series_id,
+            params.ma_period,
+            params.rsi_period,
+            params.look_ahead,
+            canonical_bits(params.rsi_threshold),
+            canonical_bits(params.stop_loss),
+            canonical_bits(params.take_profit)};
+}
+
+size_t MemoKeyHash::operator()(const MemoKey& k) const {
+    uint64_t h = k.series;
+    for (uint64_t v : {k.fitness, static_cast<uint64_t>(k.ma_period), static_cast<uint64_t>(k.rsi_period),
+                       static_cast<uint64_t>(k.look_ahead), k.rsi_threshold, k.stop_loss, k.take_profit}) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return static_cast<size_t>(h);
+}
+
+FitnessMemo::FitnessMemo(uint64_t fitness_id, size_t max_entries)
+    : fitness_id(fitness_id), max_entries(max_entries) {}
+
+bool FitnessMemo::lookup(uint64_t series_id, const StrategyParameters& params, double& fitness) {
+    std::lock_guard<std::mutex> lock(mutex);
+    touched.insert(series_id);
+    auto it = entries.find(MemoKey::make(fitness_id, series_id, params));
+    if (it == entries.end()) {
+        ++misses;
+        return false;
+    }
+    ++hits;
+    it->second.last_run = run;
+    fitness = it->second.fitness;
+    return true;
+}
+
+void FitnessMemo::store(uint64_t series_id, const StrategyParameters& params, double fitness) {
+    std::lock_guard<std::mutex> lock(mutex);
+    touched.insert(series_id);
+    entries[MemoKey::make(fitness_id, series_id, params)] = {fitness, run};
+}
+
+MemoStats FitnessMemo::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {hits, misses, entries.size()};
+}
+
+void FitnessMemo::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    hits = 0;
+    misses = 0;
+}
+
+void FitnessMemo::set_population(std::vector<StrategyParameters> ranked) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ranked_population = std::move(ranked);
+}
+
+std::vector<StrategyParameters> FitnessMemo::population() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return ranked_population;
+}
+
+size_t FitnessMemo::prune_untouched() {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t removed = 0;
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (touched.count(it->first.series) == 0) {
+            it = entries.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+bool FitnessMemo::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // A memo from an older format is stale, not corrupt: start afresh
+    MemoHeader header{};
+    if (bytes.size() >= 8 && std::memcmp(bytes.data(), MEMO_MAGIC, sizeof(header.magic)) == 0) {
+        uint32_t version;
+        std::memcpy(&version, bytes.data() + sizeof(header.magic), sizeof(version));
+        if (version < MEMO_VERSION) return false;
+    }
+
+    bool valid = bytes.size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        valid = std::memcmp(header.magic, MEMO_MAGIC, sizeof(header.magic)) == 0 &&
+                header.version == MEMO_VERSION &&
+                header.entry_count <= bytes.size() / sizeof(MemoRecord) &&
+                header.population_count <= bytes.size() / sizeof(PopulationRecord) &&
+                bytes.size() == sizeof(header) + header.entry_count * sizeof(MemoRecord) +
+                                    header.population_count * sizeof(PopulationRecord);
+    }
+    if (!valid) {
+        throw DataException("Not a valid fitness memo: " + path);
+    }
+
+    // Fitness values from another fitness function (or an older backtest)
+    // are wrong here; its population is still a good warm start
+    std::unordered_map<MemoKey, Entry, MemoKeyHash> loaded;
+    const char* cursor = bytes.data() + sizeof(header);
+    if (header.fitness_id == fitness_id) {
+        loaded.reserve(header.entry_count);
+        for (uint64_t i = 0; i < header.entry_count; ++i, cursor += sizeof(MemoRecord)) {
+            MemoRecord r;
+            std::memcpy(&r, cursor, sizeof(r));
+            loaded[{fitness_id, r.series, r.ma_period, r.rsi_period, r.look_ahead, r.rsi_threshold, r.stop_loss,
+                    r.take_profit}] = {r.fitness, r.last_run};
+        }
+    } else {
+        cursor += header.entry_count * sizeof(MemoRecord);
+    }
+    std::vector<StrategyParameters> population;
+    for (uint64_t i = 0; i < header.population_count; ++i, cursor += sizeof(PopulationRecord)) {
+        PopulationRecord r;
+        std::memcpy(&r, cursor, sizeof(r));
+        StrategyParameters params;
+        params.ma_period = r.ma_period;
+        params.rsi_period = r.rsi_period;
+        params.look_ahead = r.look_ahead;
+        params.rsi_threshold = r.rsi_threshold;
+        params.stop_loss = r.stop_loss;
+        params.take_profit = r.take_profit;
+        population.push_back(params);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries = std::move(loaded);
+    ranked_population = std::move(population);
+    touched.clear();
+    run = header.run + 1;
+    return true;
+}
+
+void FitnessMemo::save(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    MemoHeader header{};
+    std::memcpy(header.magic, MEMO_MAGIC, sizeof(header.magic));
+    header.version = MEMO_VERSION;
+    header.fitness_id = fitness_id;
+    header.run = run;
+
+    // Over the cap, keep the entries used in the most recent runs
+    using Item = std::pair<const MemoKey, Entry>;
+    std::vector<const Item*> kept;
+    kept.reserve(entries.size());
+    for (const Item& item : entries) kept.push_back(&item);
+    if (kept.size() > max_entries) {
+        std::nth_element(kept.begin(), kept.begin() + max_entries, kept.end(),
+                         [](const Item* a, const Item* b) { return a->second.last_run > b->second.last_run; });
+        kept.resize(max_entries);
+    }
+    header.entry_count = kept.size();
+    header.population_count = ranked_population.size();
+
+    const std::string tmp_path = unique_temp_path(path);
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw DataException("Cannot open fitness memo for writing: " + tmp_path);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const Item* item : kept) {
+            const MemoKey& key = item->first;
+            MemoRecord r{key.series, key.ma_period, key.rsi_period, key.look_ahead, item->second.last_run,
+                         key.rsi_threshold, key.stop_loss, key.take_profit, item->second.fitness};
+            out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+        }
+        for (const StrategyParameters& p : ranked_population) {
+            PopulationRecord r{p.ma_period, p.rsi_period, p.look_ahead, 0,
+                               p.rsi_threshold, p.stop_loss, p.take_profit};
+            out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+        }
+        if (!out) {
+            throw DataException("Failed writing fitness memo: " + tmp_path);
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw DataException("Cannot move fitness memo into place: " + path);
+    }
+}
+
+std::string fitness_memo_path(const std::string& dir, const std::string& symbol, Precision precision) {
+    if (!is_valid_symbol(symbol)) {
+        throw DataException("Invalid symbol for fitness memo: " + symbol);
+    }
+    const char* suffix = precision == Precision::Float ? ".f32.atfm" : ".atfm";
+    return (std::filesystem::path(dir) / (symbol + suffix)).string();
+}
@@ -0,0 +1,103 @@
+#ifndef FITNESS_MEMO_H
+#define FITNESS_MEMO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "optimizer.h"
+
+// Canonical form of one evaluation: the fitness function id, the series
+// fingerprint and every parameter, doubles compared by bit pattern (with
+// -0.0 folded into 0.0)
+struct MemoKey {
+    uint64_t fitness;
+    uint64_t series;
+    int32_t ma_period, rsi_period, look_ahead;
+    uint64_t rsi_threshold, stop_loss, take_profit;
+
+    static MemoKey make(uint64_t fitness_id, uint64_t series_id, const StrategyParameters& params);
+
+    bool operator==(const MemoKey& other) const {
+        return fitness == other.fitness && series == other.series && ma_period == other.ma_period &&
+               rsi_period == other.rsi_period &&
+               look_ahead == other.look_ahead && rsi_threshold == other.rsi_threshold &&
+               stop_loss == other.stop_loss && take_profit == other.take_profit;
+    }
+};
+
+struct MemoKeyHash {
+    size_t operator()(const MemoKey& k) const;
+};
+
+struct MemoStats {
+    size_t hits;
+    size_t misses;
+    size_t entries;
+
+    double hit_rate() const { return hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0; }
+};
+
+// Default cap on saved entries, about 56 MB of memo file
+constexpr size_t DEFAULT_MEMO_MAX_ENTRIES = size_t(1) << 20;
+
+// Thread-safe fitness memo for repeated optimizations. Entries persist in a
+// compact binary file together with the last run's ranked population, so a
+// later run on the same data skips every evaluation it has seen and a run on
+// extended data (a new fingerprint) can still warm-start from it. The file
+// header records the fitness id: loading a memo saved for another fitness
+// function, or an older BACKTEST_FITNESS_VERSION, keeps only the population.
+// save() writes at most max_entries entries, dropping those least recently
+// used across runs.
+class FitnessMemo {
+public:
+    explicit FitnessMemo(uint64_t fitness_id = backtest_fitness_id(Precision::Double),
+                         size_t max_entries = DEFAULT_MEMO_MAX_ENTRIES);
+
+    // True and sets `fitness` when (series, params) was evaluated before
+    bool lookup(uint64_t series_id, const StrategyParameters& params, double& fitness);
+    void store(uint64_t series_id, const StrategyParameters& params, double fitness);
+
+    MemoStats stats() const;
+    void reset_stats();
+
+    // Last run's population, best first
+    void set_population(std::vector<StrategyParameters> ranked);
+    std::vector<StrategyParameters> population() const;
+
+    // Drops entries for series not looked up or stored since construction or
+    // load(), e.g. yesterday's shorter history; returns the number removed
+    size_t prune_untouched();
+
+    // False when `path` does not exist; throws DataException on a bad file
+    bool load(const std::string& path);
+    // Written to a temporary file and renamed into place
+    void save(const std::string& path) const;
+
+private:
+    struct Entry {
+        double fitness;
+        uint32_t last_run;  // run that last stored or hit it
+    };
+
+    const uint64_t fitness_id;
+    const size_t max_entries;
+    mutable std::mutex mutex;
+    uint32_t run = 1;       // one more than the loaded file's
+    std::unordered_map<MemoKey, Entry, MemoKeyHash> entries;
+    std::unordered_set<uint64_t> touched;
+    std::vector<StrategyParameters> ranked_population;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+// <dir>/<SYMBOL>.atfm (<SYMBOL>.f32.atfm for float fitness), the per-symbol
+// memo used by the batch and interactive modes; throws DataException unless
+// is_valid_symbol(symbol)
+std::string fitness_memo_path(const std::string& dir, const std::string& symbol,
+                              Precision precision = Precision::Double);
+
+#endif // FITNESS_MEMO_H
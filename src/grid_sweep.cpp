@@ -0,0 +1,300 @@
+#include "grid_sweep.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include "indicator_lanes.h"
+#include "exit_resolver.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+static std::vector<int> int_lattice(int lo, int hi, int step) {
+    std::vector<int> values;
+    for (int v = lo; v <= hi; v += step) values.push_back(v);
+    return values;
+}
+
+static std::vector<double> real_lattice(double lo, double step, size_t count) {
+    std::vector<double> values(count);
+    for (size_t k = 0; k < count; ++k) values[k] = lo + step * k;
+    return values;
+}
+
+size_t GridAxes::size() const {
+    return ma_periods.size() * rsi_periods.size() * rsi_thresholds.size() *
+           stop_losses.size() * take_profits.size() * look_aheads.size();
+}
+
+GridAxes GridAxes::default_axes() {
+    GridAxes axes;
+    axes.ma_periods = int_lattice(50, 300, 10);
+    axes.rsi_periods = int_lattice(10, 20, 1);
+    axes.rsi_thresholds = real_lattice(60.0, 2.5, 9);
+    axes.stop_losses = real_lattice(0.005, 0.005, 10);
+    axes.take_profits = real_lattice(0.005, 0.005, 10);
+    axes.look_aheads = int_lattice(5, 20, 5);
+    return axes;
+}
+
+ResultCube::ResultCube(GridAxes grid_axes) : grid(std::move(grid_axes)) {
+    dims[0] = grid.ma_periods.size();
+    dims[1] = grid.rsi_periods.size();
+    dims[2] = grid.rsi_thresholds.size();
+    dims[3] = grid.stop_losses.size();
+    dims[4] = grid.take_profits.size();
+    dims[5] = grid.look_aheads.size();
+    fitness_values.assign(grid.size(), -1000.0);
+    trigger_counts.assign(grid.size(), 0);
+    success_counts.assign(grid.size(), 0);
+}
+
+size_t ResultCube::index(const GridPoint& p) const {
+    size_t coords[6] = {p.ma, p.rsi, p.threshold, p.stop_loss, p.take_profit, p.look_ahead};
+    size_t idx = 0;
+    for (int a = 0; a < 6; ++a) idx = idx * dims[a] + coords[a];
+    return idx;
+}
+
+GridPoint ResultCube::point(size_t index) const {
+    size_t coords[6];
+    for (int a = 5; a >= 0; --a) {
+        coords[a] = index % dims[a];
+        index /= dims[a];
+    }
+    return {coords[0], coords[1], coords[2], coords[3], coords[4], coords[5]};
+}
+
+StrategyParameters ResultCube::params(size_t index) const {
+    GridPoint p = point(index);
+    StrategyParameters params;
+    params.ma_period = grid.ma_periods[p.ma];
+    params.rsi_period = grid.rsi_periods[p.rsi];
+    params.rsi_threshold = grid.rsi_thresholds[p.threshold];
+    params.stop_loss = grid.stop_losses[p.stop_loss];
+    params.take_profit = grid.take_profits[p.take_profit];
+    params.look_ahead = grid.look_aheads[p.look_ahead];
+    return params;
+}
+
+void ResultCube::set(size_t index, double fitness, uint32_t triggers, uint32_t successes) {
+    fitness_values[index] = fitness;
+    trigger_counts[index] = triggers;
+    success_counts[index] = successes;
+}
+
+size_t ResultCube::best() const {
+    return std::distance(fitness_values.begin(), std::max_element(fitness_values.begin(), fitness_values.end()));
+}
+
+std::vector<size_t> ResultCube::top(size_t k) const {
+    std::vector<size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    k = std::min(k, order.size());
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](size_t a, size_t b) {
+        return fitness_values[a] != fitness_values[b] ? fitness_values[a] > fitness_values[b] : a < b;
+    });
+    order.resize(k);
+    return order;
+}
+
+std::vector<double> ResultCube::neighborhood_mean(size_t radius) const {
+    std::vector<double> sums = fitness_values;
+    std::vector<double> line, prefix;
+
+    // Box sum along one axis at a time; the box is separable so six passes
+    // give the full 6-D neighbourhood sum
+    size_t stride = size();
+    for (int a = 0; a < 6; ++a) {
+        size_t d = dims[a];
+        stride /= d;
+        line.resize(d);
+        prefix.resize(d + 1);
+        for (size_t outer = 0; outer < size() / (d * stride); ++outer) {
+            for (size_t inner = 0; inner < stride; ++inner) {
+                size_t base = outer * d * stride + inner;
+                prefix[0] = 0.0;
+                for (size_t i = 0; i < d; ++i) prefix[i + 1] = prefix[i] + sums[base + i * stride];
+                for (size_t i = 0; i < d; ++i) {
+                    size_t lo = i > radius ? i - radius : 0;
+                    size_t hi = std::min(i + radius, d - 1);
+                    line[i] = prefix[hi + 1] - prefix[lo];
+                }
+                for (size_t i = 0; i < d; ++i) sums[base + i * stride] = line[i];
+            }
+        }
+    }
+
+    // Divide by the clipped box volume, the product of per-axis extents
+    for (size_t idx = 0; idx < size(); ++idx) {
+        size_t rest = idx, volume = 1;
+        for (int a = 5; a >= 0; --a) {
+            size_t i = rest % dims[a];
+            rest /= dims[a];
+            size_t lo = i > radius ? i - radius : 0;
+            size_t hi = std::min(i + radius, dims[a] - 1);
+            volume *= hi - lo + 1;
+        }
+        sums[idx] /= volume;
+    }
+    return sums;
+}
+
+size_t ResultCube::most_robust(size_t radius) const {
+    auto means = neighborhood_mean(radius);
+    return std::distance(means.begin(), std::max_element(means.begin(), means.end()));
+}
+
+GridSweepReport grid_sweep(Span<const double> prices, const GridAxes& axes, size_t threads) {
+    PROFILE_ZONE("Grid Sweep");
+    auto start = std::chrono::steady_clock::now();
+
+    if (axes.size() == 0) {
+        throw CalculationException("Grid sweep needs at least one value on every axis");
+    }
+
+    GridSweepReport report{ResultCube(axes)};
+    ResultCube& cube = report.cube;
+    const size_t n = prices.size();
+    const size_t n_ma = axes.ma_periods.size(), n_rsi = axes.rsi_periods.size();
+    const size_t n_thr = axes.rsi_thresholds.size(), n_sl = axes.stop_losses.size();
+    const size_t n_tp = axes.take_profits.size(), n_look = axes.look_aheads.size();
+
+    ThreadPool pool(threads > 0 ? threads : std::thread::hardware_concurrency());
+    IndicatorCache cache;
+    uint64_t series_id = series_fingerprint(prices);
+
+    // Stage 1: every SMA period once, and all RSI periods in one multi-lane pass
+    std::vector<IndicatorCache::Series> smas(n_ma);
+    IndicatorMatrix rsis;
+    {
+        PROFILE_ZONE("Sweep Indicators");
+        rsis = calc_rsi_lanes(prices, axes.rsi_periods);
+        pool.parallel_for(n_ma, [&](size_t i) {
+            if (static_cast<size_t>(axes.ma_periods[i]) <= n) smas[i] = cache.sma(prices, series_id, axes.ma_periods[i]);
+        });
+    }
+
+    // Stage 2: MACD crossovers, the entry candidates shared by every trigger set
+    auto macd = cache.macd(prices, series_id);
+    std::vector<size_t> events;
+    for (size_t i = 1; i < n; ++i) {
+        if (macd->macd[i] > macd->signal[i] && macd->macd[i - 1] <= macd->signal[i - 1]) events.push_back(i);
+    }
+    const size_t n_events = events.size();
+    report.signal_events = n_events;
+
+    // Stage 3: exit outcome of every event under every (stop, take, look)
+    // combination, laid out [combo][event] for the accumulation loop below
+    const size_t n_combos = n_sl * n_tp * n_look;
+    std::vector<ExitReason> outcomes(n_combos * n_events);
+    {
+        PROFILE_ZONE("Sweep Exits");
+        auto exits = cache.exit_resolver(prices, series_id, EXIT_TABLE_WINDOW);
+        pool.parallel_for(n_combos, [&](size_t c) {
+            size_t l = c % n_look, t = c / n_look % n_tp, s = c / (n_look * n_tp);
+            ExitLevels levels{axes.stop_losses[s], axes.take_profits[t]};
+            auto resolved = exits->resolve_batch(events, levels, axes.look_aheads[l]);
+            for (size_t e = 0; e < n_events; ++e) outcomes[c * n_events + e] = resolved[e].reason;
+        });
+    }
+
+    // Events usable at each look-ahead: entry + look_ahead must be inside the series
+    std::vector<size_t> usable_events(n_look);
+    for (size_t l = 0; l < n_look; ++l) {
+        size_t look = static_cast<size_t>(axes.look_aheads[l]);
+        usable_events[l] = n > look ? std::lower_bound(events.begin(), events.end(), n - look) - events.begin() : 0;
+    }
+
+    // Stage 4: each (ma, rsi) pair owns a contiguous block of the cube
+    {
+        PROFILE_ZONE("Sweep Accumulate");
+        pool.parallel_for(n_ma * n_rsi, [&](size_t pair) {
+            size_t mi = pair / n_rsi, ri = pair % n_rsi;
+            size_t ma = static_cast<size_t>(axes.ma_periods[mi]);
+
+            std::vector<size_t> candidates, entries;
+            if (smas[mi]) {
+                const std::vector<double>& sma = *smas[mi];
+                for (size_t e = 0; e < n_events; ++e) {
+                    size_t i = events[e];
+                    if (i >= ma && prices[i] > sma[i]) candidates.push_back(e);
+                }
+            }
+            Span<const double> rsi = rsis.row(ri);
+
+            for (size_t ti = 0; ti < n_thr; ++ti) {
+                entries.clear();
+                for (size_t e : candidates) {
+                    if (rsi[events[e]] < axes.rsi_thresholds[ti]) entries.push_back(e);
+                }
+
+                for (size_t si = 0; si < n_sl; ++si) {
+                    for (size_t tpi = 0; tpi < n_tp; ++tpi) {
+                        for (size_t l = 0; l < n_look; ++l) {
+                            size_t cell = cube.index({mi, ri, ti, si, tpi, l});
+                            // has_enough_data in the single backtest
+                            if (n < ma + axes.look_aheads[l] + 50) {
+                                cube.set(cell, -1000.0, 0, 0);
+                                continue;
+                            }
+
+                            size_t m = std::lower_bound(entries.begin(), entries.end(), usable_events[l]) - entries.begin();
+                            const ExitReason* row = &outcomes[((si * n_tp + tpi) * n_look + l) * n_events];
+                            double stop = axes.stop_losses[si], take = axes.take_profits[tpi];
+                            size_t successes = 0;
+                            double total_return = 0.0;
+                            for (size_t q = 0; q < m; ++q) {
+                                ExitReason reason = row[entries[q]];
+                                if (reason == ExitReason::TakeProfit) {
+                                    ++successes;
+                                    total_return += take;
+                                } else if (reason == ExitReason::StopLoss) {
+                                    total_return -= stop;
+                                }
+                            }
+                            BacktestResult r = score_outcomes(m, successes, total_return);
+                            cube.set(cell, r.fitness, static_cast<uint32_t>(r.triggers),
+                                     static_cast<uint32_t>(r.successes));
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    report.trigger_sets = n_ma * n_rsi * n_thr;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+static void print_cell(const ResultCube& cube, size_t idx, std::ostream& out) {
+    StrategyParameters p = cube.params(idx);
+    double win_rate = cube.triggers(idx) > 0 ? 100.0 * cube.successes(idx) / cube.triggers(idx) : 0.0;
+    out << "  MA " << std::setw(3) << p.ma_period << "  RSI " << std::setw(2) << p.rsi_period
+        << " < " << std::setprecision(1) << std::setw(4) << p.rsi_threshold
+        << "  SL " << std::setprecision(2) << std::setw(4) << p.stop_loss * 100 << "%"
+        << "  TP " << std::setw(4) << p.take_profit * 100 << "%"
+        << "  look " << std::setw(2) << p.look_ahead
+        << " | fitness " << std::setw(7) << cube.fitness(idx)
+        << "  trades " << std::setw(4) << cube.triggers(idx)
+        << "  win " << std::setprecision(1) << win_rate << "%\n";
+}
+
+void print_grid_sweep(const GridSweepReport& report, std::ostream& out, size_t top_k) {
+    const ResultCube& cube = report.cube;
+    out << std::fixed;
+    out << "\n🔳 Grid Sweep: " << cube.size() << " combinations in " << std::setprecision(2)
+        << report.seconds << " s (" << std::setprecision(0) << report.combinations_per_second() * 60.0 / 1e6
+        << "M/min)\n";
+    out << "  " << report.signal_events << " crossover events, " << report.trigger_sets << " trigger sets\n";
+
+    out << "\n🏆 Top " << top_k << " combinations:\n";
+    for (size_t idx : cube.top(top_k)) print_cell(cube, idx, out);
+
+    auto means = cube.neighborhood_mean(1);
+    size_t robust = std::distance(means.begin(), std::max_element(means.begin(), means.end()));
+    out << "\n🛡️ Most robust region (mean fitness of +/-1 step neighbourhood "
+        << std::setprecision(2) << means[robust] << "):\n";
+    print_cell(cube, robust, out);
+}
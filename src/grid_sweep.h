@@ -0,0 +1,87 @@
+#ifndef GRID_SWEEP_H
+#define GRID_SWEEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "optimizer.h"
+
+// Values swept along each StrategyParameters field
+struct GridAxes {
+    std::vector<int> ma_periods;
+    std::vector<int> rsi_periods;
+    std::vector<double> rsi_thresholds;
+    std::vector<double> stop_losses;
+    std::vector<double> take_profits;
+    std::vector<int> look_aheads;
+
+    size_t size() const;
+
+    // The GA's ranges on a regular lattice (~1M combinations)
+    static GridAxes default_axes();
+};
+
+// Axis positions of one grid cell
+struct GridPoint {
+    size_t ma, rsi, threshold, stop_loss, take_profit, look_ahead;
+};
+
+// Dense row-major cube of backtest results, one cell per parameter
+// combination; the last axis (look_ahead) varies fastest.
+class ResultCube {
+public:
+    explicit ResultCube(GridAxes grid_axes);
+
+    const GridAxes& axes() const { return grid; }
+    size_t size() const { return fitness_values.size(); }
+
+    size_t index(const GridPoint& p) const;
+    GridPoint point(size_t index) const;
+    StrategyParameters params(size_t index) const;
+
+    double fitness(size_t index) const { return fitness_values[index]; }
+    uint32_t triggers(size_t index) const { return trigger_counts[index]; }
+    uint32_t successes(size_t index) const { return success_counts[index]; }
+    const std::vector<double>& fitness_data() const { return fitness_values; }
+
+    size_t best() const;
+    // Indices of the k best cells, best first
+    std::vector<size_t> top(size_t k) const;
+    // Mean fitness over the box of +/- radius steps on every axis (clipped at
+    // the edges), computed with separable running sums
+    std::vector<double> neighborhood_mean(size_t radius) const;
+    // Cell whose neighbourhood mean is highest: a parameter region that stays
+    // good when every value is nudged, rather than an isolated spike
+    size_t most_robust(size_t radius = 1) const;
+
+    void set(size_t index, double fitness, uint32_t triggers, uint32_t successes);
+
+private:
+    GridAxes grid;
+    size_t dims[6];
+    std::vector<double> fitness_values;
+    std::vector<uint32_t> trigger_counts, success_counts;
+};
+
+struct GridSweepReport {
+    ResultCube cube;
+    size_t signal_events = 0;   // MACD crossovers shared by every trigger set
+    size_t trigger_sets = 0;    // distinct (ma, rsi, threshold) trigger lists
+    double seconds = 0.0;
+
+    double combinations_per_second() const { return seconds > 0.0 ? cube.size() / seconds : 0.0; }
+};
+
+// Backtests every combination in `axes`. Work is factored by what each stage
+// depends on: SMA once per period, every RSI period in one multi-lane pass
+// (indicator_lanes.h), MACD crossover events once, exit
+// outcomes once per (event, stop, take, look_ahead) through the rolling
+// max/min tables, and each (ma, rsi, threshold) trigger set is a filtered
+// subset of the events that only accumulates looked-up outcomes. Every cell
+// equals backtest_detailed(prices, params, cache) bit-for-bit.
+GridSweepReport grid_sweep(Span<const double> prices, const GridAxes& axes, size_t threads = 0);
+
+void print_grid_sweep(const GridSweepReport& report, std::ostream& out, size_t top_k = 5);
+
+#endif // GRID_SWEEP_H
@@ -0,0 +1,173 @@
+#include "indicator_cache.h"
+#include <cstring>
+#include <optional>
+
+uint64_t series_fingerprint(Span<const double> prices) {
+    // FNV-1a over the raw bytes, seeded with the length
+    uint64_t hash = 1469598103934665603ULL ^ prices.size();
+    for (double p : prices) {
+        uint64_t bits;
+        std::memcpy(&bits, &p, sizeof(bits));
+        hash ^= bits;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+size_t IndicatorKeyHash::operator()(const IndicatorKey& k) const {
+    uint64_t h = k.series;
+    h ^= static_cast<uint64_t>(k.kind) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(k.p1) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(k.p2) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(k.p3) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return static_cast<size_t>(h);
+}
+
+template <typename T, typename Compute>
+std::shared_ptr<const T> IndicatorCache::lookup(
+    std::unordered_map<IndicatorKey, std::shared_future<std::shared_ptr<const T>>, IndicatorKeyHash>& map,
+    const IndicatorKey& key, Compute compute) {
+
+    // The promise's shared state is only created on a miss, so hits do not allocate
+    std::optional<std::promise<std::shared_ptr<const T>>> promise;
+    std::shared_future<std::shared_ptr<const T>> future;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = map.find(key);
+        if (it != map.end()) {
+            ++hits;
+            future = it->second;
+        } else {
+            ++misses;
+            promise.emplace();
+            map.emplace(key, promise->get_future().share());
+        }
+    }
+    if (future.valid()) {
+        return future.get();
+    }
+
+    // Compute outside the lock so other keys are not blocked
+    try {
+        auto value = std::make_shared<const T>(compute());
+        promise->set_value(value);
+        return value;
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            map.erase(key);
+        }
+        promise->set_exception(std::current_exception());
+        throw;
+    }
+}
+
+IndicatorCache::Series IndicatorCache::sma(Span<const double> prices, uint64_t series_id, int period) {
+    return lookup(series_map, {series_id, IndicatorKind::SMA, period, 0, 0},
+                  [&] { return calc_sma(prices, period); });
+}
+
+IndicatorCache::Series IndicatorCache::rsi(Span<const double> prices, uint64_t series_id, int period) {
+    return lookup(series_map, {series_id, IndicatorKind::RSI, period, 0, 0},
+                  [&] { return calc_rsi(prices, period); });
+}
+
+IndicatorCache::MACDPtr IndicatorCache::macd(Span<const double> prices, uint64_t series_id,
+                                             int fast, int slow, int sig) {
+    return lookup(macd_map, {series_id, IndicatorKind::MACD, fast, slow, sig},
+                  [&] { return calc_macd(prices, fast, slow, sig); });
+}
+
+IndicatorCache::ExitResolverPtr IndicatorCache::exit_resolver(Span<const double> prices,
+                                                              uint64_t series_id, int max_window) {
+    return lookup(exit_map, {series_id, IndicatorKind::ExitTables, max_window, 0, 0},
+                  [&] { return ExitResolver(prices, max_window); });
+}
+
+IndicatorCache::FloatSeries IndicatorCache::prices_f32(Span<const double> prices, uint64_t series_id) {
+    return lookup(float_series_map, {series_id, IndicatorKind::Prices, 0, 0, 0},
+                  [&] { return std::vector<float>(prices.begin(), prices.end()); });
+}
+
+IndicatorCache::FloatSeries IndicatorCache::sma_f32(Span<const double> prices, uint64_t series_id,
+                                                    int period) {
+    return lookup(float_series_map, {series_id, IndicatorKind::SMA, period, 0, 0},
+                  [&] { return calc_sma(*prices_f32(prices, series_id), period); });
+}
+
+IndicatorCache::FloatSeries IndicatorCache::rsi_f32(Span<const double> prices, uint64_t series_id,
+                                                    int period) {
+    return lookup(float_series_map, {series_id, IndicatorKind::RSI, period, 0, 0},
+                  [&] { return calc_rsi(*prices_f32(prices, series_id), period); });
+}
+
+IndicatorCache::FloatMACDPtr IndicatorCache::macd_f32(Span<const double> prices, uint64_t series_id,
+                                                      int fast, int slow, int sig) {
+    return lookup(float_macd_map, {series_id, IndicatorKind::MACD, fast, slow, sig},
+                  [&] { return calc_macd(*prices_f32(prices, series_id), fast, slow, sig); });
+}
+
+uint64_t IndicatorCache::series_id(Span<const double> prices) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const SeriesId& known : series_ids) {
+            if (known.data == prices.data() && known.size == prices.size()) return known.id;
+        }
+    }
+    return series_fingerprint(prices);
+}
+
+uint64_t IndicatorCache::register_series(Span<const double> prices) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (SeriesId& known : series_ids) {
+            if (known.data == prices.data() && known.size == prices.size()) {
+                ++known.registrations;
+                return known.id;
+            }
+        }
+    }
+    // Hash outside the lock, then check again: a racing registration of the
+    // same buffer may have added it meanwhile
+    uint64_t id = series_fingerprint(prices);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (SeriesId& known : series_ids) {
+        if (known.data == prices.data() && known.size == prices.size()) {
+            ++known.registrations;
+            return known.id;
+        }
+    }
+    series_ids.push_back({prices.data(), prices.size(), id, 1});
+    return id;
+}
+
+void IndicatorCache::unregister_series(Span<const double> prices) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < series_ids.size(); ++i) {
+        SeriesId& known = series_ids[i];
+        if (known.data == prices.data() && known.size == prices.size()) {
+            if (--known.registrations == 0) {
+                series_ids[i] = series_ids.back();
+                series_ids.pop_back();
+            }
+            return;
+        }
+    }
+}
+
+CacheStats IndicatorCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {hits, misses,
+            series_map.size() + macd_map.size() + exit_map.size() + float_series_map.size() + float_macd_map.size()};
+}
+
+void IndicatorCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    series_map.clear();
+    macd_map.clear();
+    exit_map.clear();
+    float_series_map.clear();
+    float_macd_map.clear();
+    series_ids.clear();
+    hits = misses = 0;
+}
@@ -0,0 +1,118 @@
+#ifndef INDICATOR_CACHE_H
+#define INDICATOR_CACHE_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "indicators.h"
+#include "exit_resolver.h"
+
+// 64-bit fingerprint identifying a price series by content
+uint64_t series_fingerprint(Span<const double> prices);
+
+enum class IndicatorKind : uint8_t { SMA, RSI, MACD, ExitTables, Prices };
+
+struct IndicatorKey {
+    uint64_t series;
+    IndicatorKind kind;
+    int p1, p2, p3;
+
+    bool operator==(const IndicatorKey& other) const {
+        return series == other.series && kind == other.kind &&
+               p1 == other.p1 && p2 == other.p2 && p3 == other.p3;
+    }
+};
+
+struct IndicatorKeyHash {
+    size_t operator()(const IndicatorKey& k) const;
+};
+
+struct CacheStats {
+    size_t hits;
+    size_t misses;
+    size_t entries;
+};
+
+// Thread-safe memo of indicator arrays keyed by (series, kind, parameters).
+// Each distinct key is computed exactly once; concurrent requests for a key
+// that is still being computed wait for the first computation to finish.
+class IndicatorCache {
+public:
+    using Series = std::shared_ptr<const std::vector<double>>;
+    using MACDPtr = std::shared_ptr<const MACD>;
+    using ExitResolverPtr = std::shared_ptr<const ExitResolver>;
+    using FloatSeries = std::shared_ptr<const std::vector<float>>;
+    using FloatMACDPtr = std::shared_ptr<const BasicMACD<float>>;
+
+    Series sma(Span<const double> prices, uint64_t series_id, int period);
+    Series rsi(Span<const double> prices, uint64_t series_id, int period);
+    MACDPtr macd(Span<const double> prices, uint64_t series_id,
+                 int fast = 12, int slow = 26, int sig = 9);
+    // The resolver views `prices`, so that series must outlive the cache
+    ExitResolverPtr exit_resolver(Span<const double> prices, uint64_t series_id, int max_window);
+
+    // Float32 copy of the series, converted once, and indicators computed on it in float
+    FloatSeries prices_f32(Span<const double> prices, uint64_t series_id);
+    FloatSeries sma_f32(Span<const double> prices, uint64_t series_id, int period);
+    FloatSeries rsi_f32(Span<const double> prices, uint64_t series_id, int period);
+    FloatMACDPtr macd_f32(Span<const double> prices, uint64_t series_id,
+                          int fast = 12, int slow = 26, int sig = 9);
+
+    // series_fingerprint(prices). A registered series is answered from its
+    // (buffer, length) without rehashing; anything else is hashed per call.
+    uint64_t series_id(Span<const double> prices);
+
+    // Registers `prices` for series_id until the matching unregister_series.
+    // The caller keeps the buffer alive and unchanged while registered, since
+    // the registry trusts its address. Registrations of one buffer nest.
+    uint64_t register_series(Span<const double> prices);
+    void unregister_series(Span<const double> prices);
+
+    // Registers a series for the lifetime of the scope
+    class ScopedSeries {
+    public:
+        ScopedSeries(IndicatorCache& cache, Span<const double> prices)
+            : cache(cache), prices(prices), series_id(cache.register_series(prices)) {}
+        ~ScopedSeries() { cache.unregister_series(prices); }
+        ScopedSeries(const ScopedSeries&) = delete;
+        ScopedSeries& operator=(const ScopedSeries&) = delete;
+
+        uint64_t id() const { return series_id; }
+
+    private:
+        IndicatorCache& cache;
+        Span<const double> prices;
+        uint64_t series_id;
+    };
+
+    CacheStats stats() const;
+    void clear();
+
+private:
+    template <typename T, typename Compute>
+    std::shared_ptr<const T> lookup(
+        std::unordered_map<IndicatorKey, std::shared_future<std::shared_ptr<const T>>, IndicatorKeyHash>& map,
+        const IndicatorKey& key, Compute compute);
+
+    mutable std::mutex mutex;
+    std::unordered_map<IndicatorKey, std::shared_future<Series>, IndicatorKeyHash> series_map;
+    std::unordered_map<IndicatorKey, std::shared_future<MACDPtr>, IndicatorKeyHash> macd_map;
+    std::unordered_map<IndicatorKey, std::shared_future<ExitResolverPtr>, IndicatorKeyHash> exit_map;
+    std::unordered_map<IndicatorKey, std::shared_future<FloatSeries>, IndicatorKeyHash> float_series_map;
+    std::unordered_map<IndicatorKey, std::shared_future<FloatMACDPtr>, IndicatorKeyHash> float_macd_map;
+    struct SeriesId {
+        const double* data;
+        size_t size;
+        uint64_t id;
+        size_t registrations;
+    };
+    std::vector<SeriesId> series_ids;  // a handful per run (one per racing rung)
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+#endif // INDICATOR_CACHE_H
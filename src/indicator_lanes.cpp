@@ -0,0 +1,347 @@
+#include "indicator_lanes.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include <algorithm>
+#include <limits>
+#include <string>
+
+// The vector kernels use GCC/Clang vector extensions and are compiled for
+// AVX2 / AVX-512F through target attributes, so the rest of the build keeps
+// its baseline flags. AVX-512F brings FMA with it, so contraction is switched
+// off for the kernels: a*b + c must round twice, exactly like the scalar code.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define INDICATOR_LANES_X86 1
+typedef double Lanes4 __attribute__((vector_size(4 * sizeof(double))));
+typedef double Lanes8 __attribute__((vector_size(8 * sizeof(double))));
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#define LANES_TARGET(isa) __attribute__((target(isa)))
+#else
+#define LANES_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#endif
+#else
+#define INDICATOR_LANES_X86 0
+#endif
+
+namespace {
+
+void validate_periods(const std::vector<int>& periods, const char* what) {
+    for (int period : periods) {
+        if (period <= 0) {
+            throw CalculationException(std::string(what) + " period must be positive");
+        }
+    }
+}
+
+// Every kernel writes all of its cells, so a reused matrix is not cleared
+void shape_matrix(IndicatorMatrix& m, size_t rows, size_t bars) {
+    m.rows = rows;
+    m.bars = bars;
+    m.values.resize(rows * bars);
+}
+
+std::vector<double*> row_pointers(IndicatorMatrix& m) {
+    std::vector<double*> rows(m.rows);
+    for (size_t k = 0; k < m.rows; ++k) rows[k] = m.values.data() + k * m.bars;
+    return rows;
+}
+
+size_t lane_width(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX512: return 8;
+    case SimdLevel::AVX2: return 4;
+    default: return 1;
+    }
+}
+
+// Wilder RSI of one period over bars [0, upto), operation for operation as
+// calc_rsi. Leaves the smoothed averages in gain/loss so a vector kernel can
+// continue from bar `upto`. Rows of series shorter than period + 1 are all NaN.
+void rsi_scalar(Span<const double> closes, int period, double* row, size_t upto, double& gain, double& loss) {
+    size_t p = static_cast<size_t>(period);
+    gain = 0.0;
+    loss = 0.0;
+    std::fill(row, row + std::min(p, closes.size()), std::numeric_limits<double>::quiet_NaN());
+    if (closes.size() < p + 1) return;
+
+    for (size_t i = 1; i <= p; ++i) {
+        double change = closes[i] - closes[i - 1];
+        if (change > 0) gain += change;
+        else loss -= change;
+    }
+    gain /= period;
+    loss /= period;
+    row[p] = 100.0 - (100.0 / (1.0 + (gain / loss)));
+
+    for (size_t i = p + 1; i < upto; ++i) {
+        double change = closes[i] - closes[i - 1];
+        if (change > 0) {
+            gain = (gain * (period - 1) + change) / period;
+            loss = (loss * (period - 1)) / period;
+        } else {
+            gain = (gain * (period - 1)) / period;
+            loss = (loss * (period - 1) - change) / period;
+        }
+        row[i] = 100.0 - (100.0 / (1.0 + (gain / loss)));
+    }
+}
+
+void ema_scalar(Span<const double> closes, int period, double* row) {
+    double k = 2.0 / (period + 1.0);
+    double ema = closes[0];
+    row[0] = ema;
+    for (size_t i = 1; i < closes.size(); ++i) {
+        ema = closes[i] * k + ema * (1.0 - k);
+        row[i] = ema;
+    }
+}
+
+void macd_scalar(Span<const double> closes, const MACDParams& set, double* macd, double* signal) {
+    double k_fast = 2.0 / (set.fast + 1.0);
+    double k_slow = 2.0 / (set.slow + 1.0);
+    double k_sig = 2.0 / (set.signal + 1.0);
+    double ema_fast = closes[0], ema_slow = closes[0], sig = 0.0;
+    macd[0] = signal[0] = 0.0;
+    for (size_t i = 1; i < closes.size(); ++i) {
+        ema_fast = closes[i] * k_fast + ema_fast * (1.0 - k_fast);
+        ema_slow = closes[i] * k_slow + ema_slow * (1.0 - k_slow);
+        double m = ema_fast - ema_slow;
+        sig = m * k_sig + sig * (1.0 - k_sig);
+        macd[i] = m;
+        signal[i] = sig;
+    }
+}
+
+#if INDICATOR_LANES_X86
+
+// Kernels are always inlined into the target-attributed entry points below,
+// which is what compiles their vector operations to AVX2 / AVX-512.
+// `lanes` <= lane count; unused lanes repeat the last parameter set.
+// x - V{} broadcasts x to every lane; subtracting +0 leaves every value,
+// -0 included, unchanged.
+
+template <typename V>
+__attribute__((always_inline)) inline void rsi_kernel(Span<const double> closes, const int* periods, size_t lanes,
+                                                      double* const* rows) {
+    constexpr size_t W = sizeof(V) / sizeof(double);
+    const size_t n = closes.size();
+
+    // Scalar warm-up up to the longest period, after which every lane is in
+    // the Wilder phase and the bar's up/down branch is shared by all lanes
+    size_t start = static_cast<size_t>(*std::max_element(periods, periods + lanes));
+    size_t upto = std::min(start + 1, n);
+    V gain, loss, prev_weight, period;
+    for (size_t j = 0; j < W; ++j) {
+        size_t lane = std::min(j, lanes - 1);
+        if (j < lanes) {
+            double g, l;
+            rsi_scalar(closes, periods[lane], rows[lane], upto, g, l);
+            gain[j] = g;
+            loss[j] = l;
+        } else {
+            gain[j] = gain[lanes - 1];
+            loss[j] = loss[lanes - 1];
+        }
+        prev_weight[j] = periods[lane] - 1;
+        period[j] = periods[lane];
+    }
+
+    const V hundred = 100.0 - V{}, one = 1.0 - V{};
+    for (size_t i = upto; i < n; ++i) {
+        double change = closes[i] - closes[i - 1];
+        if (change > 0) {
+            gain = (gain * prev_weight + (change - V{})) / period;
+            loss = (loss * prev_weight) / period;
+        } else {
+            gain = (gain * prev_weight) / period;
+            loss = (loss * prev_weight - (change - V{})) / period;
+        }
+        V rsi = hundred - (hundred / (one + (gain / loss)));
+        for (size_t j = 0; j < lanes; ++j) rows[j][i] = rsi[j];
+    }
+}
+
+template <typename V>
+__attribute__((always_inline)) inline void ema_kernel(Span<const double> closes, const int* periods, size_t lanes,
+                                                      double* const* rows) {
+    constexpr size_t W = sizeof(V) / sizeof(double);
+    V k, keep;
+    for (size_t j = 0; j < W; ++j) {
+        k[j] = 2.0 / (periods[std::min(j, lanes - 1)] + 1.0);
+        keep[j] = 1.0 - k[j];
+    }
+    V ema = closes[0] - V{};
+    for (size_t j = 0; j < lanes; ++j) rows[j][0] = closes[0];
+    for (size_t i = 1; i < closes.size(); ++i) {
+        ema = (closes[i] - V{}) * k + ema * keep;
+        for (size_t j = 0; j < lanes; ++j) rows[j][i] = ema[j];
+    }
+}
+
+template <typename V>
+__attribute__((always_inline)) inline void macd_kernel(Span<const double> closes, const MACDParams* sets, size_t lanes,
+                                                       double* const* macd_rows, double* const* signal_rows) {
+    constexpr size_t W = sizeof(V) / sizeof(double);
+    V k_fast, keep_fast, k_slow, keep_slow, k_sig, keep_sig;
+    for (size_t j = 0; j < W; ++j) {
+        const MACDParams& set = sets[std::min(j, lanes - 1)];
+        k_fast[j] = 2.0 / (set.fast + 1.0);
+        k_slow[j] = 2.0 / (set.slow + 1.0);
+        k_sig[j] = 2.0 / (set.signal + 1.0);
+        keep_fast[j] = 1.0 - k_fast[j];
+        keep_slow[j] = 1.0 - k_slow[j];
+        keep_sig[j] = 1.0 - k_sig[j];
+    }
+    V ema_fast = closes[0] - V{}, ema_slow = ema_fast, sig = V{};
+    for (size_t j = 0; j < lanes; ++j) macd_rows[j][0] = signal_rows[j][0] = 0.0;
+    for (size_t i = 1; i < closes.size(); ++i) {
+        V close = closes[i] - V{};
+        ema_fast = close * k_fast + ema_fast * keep_fast;
+        ema_slow = close * k_slow + ema_slow * keep_slow;
+        V m = ema_fast - ema_slow;
+        sig = m * k_sig + sig * keep_sig;
+        for (size_t j = 0; j < lanes; ++j) {
+            macd_rows[j][i] = m[j];
+            signal_rows[j][i] = sig[j];
+        }
+    }
+}
+
+LANES_TARGET("avx2")
+void rsi_avx2(Span<const double> closes, const int* periods, size_t lanes, double* const* rows) {
+    rsi_kernel<Lanes4>(closes, periods, lanes, rows);
+}
+
+LANES_TARGET("avx512f")
+void rsi_avx512(Span<const double> closes, const int* periods, size_t lanes, double* const* rows) {
+    rsi_kernel<Lanes8>(closes, periods, lanes, rows);
+}
+
+LANES_TARGET("avx2")
+void ema_avx2(Span<const double> closes, const int* periods, size_t lanes, double* const* rows) {
+    ema_kernel<Lanes4>(closes, periods, lanes, rows);
+}
+
+LANES_TARGET("avx512f")
+void ema_avx512(Span<const double> closes, const int* periods, size_t lanes, double* const* rows) {
+    ema_kernel<Lanes8>(closes, periods, lanes, rows);
+}
+
+LANES_TARGET("avx2")
+void macd_avx2(Span<const double> closes, const MACDParams* sets, size_t lanes,
+               double* const* macd_rows, double* const* signal_rows) {
+    macd_kernel<Lanes4>(closes, sets, lanes, macd_rows, signal_rows);
+}
+
+LANES_TARGET("avx512f")
+void macd_avx512(Span<const double> closes, const MACDParams* sets, size_t lanes,
+                 double* const* macd_rows, double* const* signal_rows) {
+    macd_kernel<Lanes8>(closes, sets, lanes, macd_rows, signal_rows);
+}
+
+#endif // INDICATOR_LANES_X86
+
+} // namespace
+
+SimdLevel detected_simd_level() {
+#if INDICATOR_LANES_X86
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX512: return "AVX-512";
+    case SimdLevel::AVX2: return "AVX2";
+    default: return "scalar";
+    }
+}
+
+void calc_rsi_lanes(Span<const double> closes, const std::vector<int>& periods, IndicatorMatrix& out,
+                    SimdLevel level) {
+    PROFILE_ZONE("RSI Lanes");
+    validate_periods(periods, "RSI");
+    shape_matrix(out, periods.size(), closes.size());
+    if (closes.empty()) return;
+    std::vector<double*> rows = row_pointers(out);
+
+    size_t width = lane_width(std::min(level, detected_simd_level()));
+    for (size_t k = 0; k < periods.size(); k += width) {
+        size_t lanes = std::min(width, periods.size() - k);
+#if INDICATOR_LANES_X86
+        if (width == 8) { rsi_avx512(closes, &periods[k], lanes, &rows[k]); continue; }
+        if (width == 4) { rsi_avx2(closes, &periods[k], lanes, &rows[k]); continue; }
+#endif
+        double gain, loss;
+        rsi_scalar(closes, periods[k], rows[k], closes.size(), gain, loss);
+    }
+}
+
+void calc_ema_lanes(Span<const double> closes, const std::vector<int>& periods, IndicatorMatrix& out,
+                    SimdLevel level) {
+    PROFILE_ZONE("EMA Lanes");
+    validate_periods(periods, "EMA");
+    shape_matrix(out, periods.size(), closes.size());
+    if (closes.empty()) return;
+    std::vector<double*> rows = row_pointers(out);
+
+    size_t width = lane_width(std::min(level, detected_simd_level()));
+    for (size_t k = 0; k < periods.size(); k += width) {
+        size_t lanes = std::min(width, periods.size() - k);
+#if INDICATOR_LANES_X86
+        if (width == 8) { ema_avx512(closes, &periods[k], lanes, &rows[k]); continue; }
+        if (width == 4) { ema_avx2(closes, &periods[k], lanes, &rows[k]); continue; }
+#endif
+        ema_scalar(closes, periods[k], rows[k]);
+    }
+}
+
+void calc_macd_lanes(Span<const double> closes, const std::vector<MACDParams>& sets, MACDMatrix& out,
+                     SimdLevel level) {
+    PROFILE_ZONE("MACD Lanes");
+    for (const MACDParams& set : sets) {
+        if (set.fast <= 0 || set.slow <= 0 || set.signal <= 0) {
+            throw CalculationException("MACD periods must be positive");
+        }
+    }
+    shape_matrix(out.macd, sets.size(), closes.size());
+    shape_matrix(out.signal, sets.size(), closes.size());
+    if (closes.empty()) return;
+    std::vector<double*> macd_rows = row_pointers(out.macd), signal_rows = row_pointers(out.signal);
+
+    size_t width = lane_width(std::min(level, detected_simd_level()));
+    for (size_t k = 0; k < sets.size(); k += width) {
+        size_t lanes = std::min(width, sets.size() - k);
+#if INDICATOR_LANES_X86
+        if (width == 8) { macd_avx512(closes, &sets[k], lanes, &macd_rows[k], &signal_rows[k]); continue; }
+        if (width == 4) { macd_avx2(closes, &sets[k], lanes, &macd_rows[k], &signal_rows[k]); continue; }
+#endif
+        macd_scalar(closes, sets[k], macd_rows[k], signal_rows[k]);
+    }
+}
+
+IndicatorMatrix calc_rsi_lanes(Span<const double> closes, const std::vector<int>& periods, SimdLevel level) {
+    IndicatorMatrix out;
+    calc_rsi_lanes(closes, periods, out, level);
+    return out;
+}
+
+IndicatorMatrix calc_ema_lanes(Span<const double> closes, const std::vector<int>& periods, SimdLevel level) {
+    IndicatorMatrix out;
+    calc_ema_lanes(closes, periods, out, level);
+    return out;
+}
+
+MACDMatrix calc_macd_lanes(Span<const double> closes, const std::vector<MACDParams>& sets, SimdLevel level) {
+    MACDMatrix out;
+    calc_macd_lanes(closes, sets, out, level);
+    return out;
+}
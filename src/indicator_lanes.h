@@ -0,0 +1,62 @@
+#ifndef INDICATOR_LANES_H
+#define INDICATOR_LANES_H
+
+#include <vector>
+#include <cstddef>
+#include "span.h"
+
+// EMA, MACD and Wilder RSI are recurrent along time, so they cannot be
+// vectorized across bars. These kernels vectorize across parameter sets
+// instead: each SIMD lane carries one period (or MACD triple) and all lanes
+// advance one bar per step. Every row equals the scalar calc_* result
+// bit-for-bit; the lanes use plain multiply/add/divide, never FMA.
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+// Widest level this CPU supports (checked once); Scalar off x86-64
+SimdLevel detected_simd_level();
+const char* simd_level_name(SimdLevel level);
+
+// Period-major matrix: row k is the full-length series for parameter set k,
+// so row(k)[i] is bar i. Rows are contiguous for direct indexing.
+struct IndicatorMatrix {
+    size_t rows = 0;
+    size_t bars = 0;
+    std::vector<double> values;
+
+    Span<const double> row(size_t k) const { return Span<const double>(values.data() + k * bars, bars); }
+    double at(size_t k, size_t i) const { return values[k * bars + i]; }
+};
+
+struct MACDParams {
+    int fast = 12;
+    int slow = 26;
+    int signal = 9;
+};
+
+// Rows follow the order of the parameter sets
+struct MACDMatrix {
+    IndicatorMatrix macd, signal;
+};
+
+// Each kernel runs at min(level, detected_simd_level()): 8 lanes with
+// AVX-512, 4 with AVX2, one parameter set at a time otherwise.
+// Row k of calc_rsi_lanes equals calc_rsi(closes, periods[k])
+IndicatorMatrix calc_rsi_lanes(Span<const double> closes, const std::vector<int>& periods,
+                               SimdLevel level = detected_simd_level());
+// Row k is the EMA seeded with closes[0], as inside calc_macd
+IndicatorMatrix calc_ema_lanes(Span<const double> closes, const std::vector<int>& periods,
+                               SimdLevel level = detected_simd_level());
+// Row k equals calc_macd(closes, sets[k].fast, sets[k].slow, sets[k].signal)
+MACDMatrix calc_macd_lanes(Span<const double> closes, const std::vector<MACDParams>& sets,
+                           SimdLevel level = detected_simd_level());
+
+// Output-matrix forms: `out` is reshaped and overwritten, reusing its storage
+void calc_rsi_lanes(Span<const double> closes, const std::vector<int>& periods, IndicatorMatrix& out,
+                    SimdLevel level = detected_simd_level());
+void calc_ema_lanes(Span<const double> closes, const std::vector<int>& periods, IndicatorMatrix& out,
+                    SimdLevel level = detected_simd_level());
+void calc_macd_lanes(Span<const double> closes, const std::vector<MACDParams>& sets, MACDMatrix& out,
+                     SimdLevel level = detected_simd_level());
+
+#endif // INDICATOR_LANES_H
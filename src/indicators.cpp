@@ -1,84 +1,162 @@
 #include "indicators.h"
 #include "exceptions.h"
-#include "benchmark.h"
+#include "profiler.h"
+#include "compensated_sum.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <limits>
 
-// SMA calculation
-std::vector<double> calc_sma(const std::vector<double>& v, int period) {
-    // Uncomment the following line to enable benchmarking
-    // BENCHMARK("SMA Internal Calculation");
-    
+template <typename T>
+static void validate_sma_input(Span<const T> v, int period) {
     if (period <= 0) {
         throw CalculationException("SMA period must be positive");
     }
     if (v.empty()) {
         throw CalculationException("Cannot calculate SMA on empty data");
     }
+}
 
-    std::vector<double> out(v.size(), std::numeric_limits<double>::quiet_NaN());
-    if (v.size() < static_cast<size_t>(period)) return out;
+// SMA calculation
+// O(n) rolling window sum. The window sum is carried with Neumaier
+// compensation so drift does not accumulate over long series, and NaN/Inf
+// values are counted apart from it (NonFiniteWindow), so they only affect
+// the windows that contain them. Against direct
+// per-window summation the error is a few ulps of T for prices of similar
+// magnitude: about 1e-15 relative for double and 1e-6 for float. It grows
+// when the series spans orders of magnitude, since the running sum carries
+// rounding from the largest values it has seen.
+template <typename T>
+void calc_sma(Span<const T> v, int period, std::vector<T>& out) {
+    PROFILE_ZONE("SMA");
+    
+    validate_sma_input(v, period);
+
+    out.assign(v.size(), std::numeric_limits<T>::quiet_NaN());
+    if (v.size() < static_cast<size_t>(period)) return;
 
-    for (size_t i = period - 1; i < v.size(); ++i) {
-        double sum = 0.0;
-        for (int j = 0; j < period; ++j) {
-            sum += v[i - j];
+    T sum = 0, comp = 0;
+    NonFiniteWindow non_finite;
+    for (size_t i = 0; i < v.size(); ++i) {
+        compensated_add(sum, comp, non_finite.enter(v[i]));
+        if (i >= static_cast<size_t>(period)) {
+            compensated_add(sum, comp, -non_finite.leave(v[i - period]));
+        }
+        if (i + 1 >= static_cast<size_t>(period)) {
+            out[i] = (non_finite.clean() ? sum + comp : non_finite.sum<T>()) / period;
+        }
+    }
+}
+
+template <typename T>
+std::vector<T> calc_sma(Span<const T> v, int period) {
+    std::vector<T> out;
+    calc_sma(v, period, out);
+    return out;
+}
+
+// Batch SMA for many periods over one shared double-double prefix-sum array
+std::vector<std::vector<double>> calc_sma_multi(Span<const double> v, const std::vector<int>& periods) {
+    for (int period : periods) {
+        validate_sma_input(v, period);
+    }
+
+    // prefix_hi[i] + prefix_lo[i] is the compensated sum of the finite
+    // values of v[0..i), and prefix_bad[i] counts the others
+    std::vector<double> prefix_hi(v.size() + 1), prefix_lo(v.size() + 1);
+    std::vector<size_t> prefix_bad(v.size() + 1);
+    double sum = 0.0, comp = 0.0;
+    NonFiniteWindow non_finite;
+    prefix_hi[0] = prefix_lo[0] = 0.0;
+    prefix_bad[0] = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        compensated_add(sum, comp, non_finite.enter(v[i]));
+        prefix_hi[i + 1] = sum;
+        prefix_lo[i + 1] = comp;
+        prefix_bad[i + 1] = prefix_bad[i] + !std::isfinite(v[i]);
+    }
+
+    std::vector<std::vector<double>> out(periods.size(),
+        std::vector<double>(v.size(), std::numeric_limits<double>::quiet_NaN()));
+    for (size_t i = 0; i < v.size(); ++i) {
+        for (size_t k = 0; k < periods.size(); ++k) {
+            size_t period = static_cast<size_t>(periods[k]);
+            if (i + 1 < period) continue;
+            size_t start = i + 1 - period;
+            if (prefix_bad[i + 1] != prefix_bad[start]) {
+                // Rare: recount this window's non-finite values directly
+                NonFiniteWindow bad;
+                for (size_t j = start; j <= i; ++j) bad.enter(v[j]);
+                out[k][i] = bad.sum<double>() / periods[k];
+                continue;
+            }
+            double window = (prefix_hi[i + 1] - prefix_hi[start]) + (prefix_lo[i + 1] - prefix_lo[start]);
+            out[k][i] = window / periods[k];
         }
-        out[i] = sum / period;
     }
     return out;
 }
 
 // MACD calculation
-MACD calc_macd(const std::vector<double>& closes, int fast, int slow, int signal_period) {
-    // Uncomment the following line to enable benchmarking
-    // BENCHMARK("MACD Internal Calculation");
+// The fast and slow EMAs are carried as running values; only the MACD and
+// signal lines are stored.
+template <typename T>
+void calc_macd(Span<const T> closes, int fast, int slow, int signal_period, BasicMACD<T>& out) {
+    PROFILE_ZONE("MACD");
 
-    std::vector<double> macd(closes.size()), ema_fast(closes.size()), ema_slow(closes.size());
-    if (closes.empty()) return {macd, macd};
+    out.macd.resize(closes.size());
+    out.signal.resize(closes.size());
+    if (closes.empty()) return;
 
-    ema_fast[0] = ema_slow[0] = closes[0];
+    T k_fast = T(2) / (fast + T(1));
+    T k_slow = T(2) / (slow + T(1));
+    T ema_fast = closes[0], ema_slow = closes[0];
+    out.macd[0] = 0;
     for (size_t i = 1; i < closes.size(); ++i) {
-        double k_fast = 2.0 / (fast + 1.0);
-        double k_slow = 2.0 / (slow + 1.0);
-        ema_fast[i] = closes[i] * k_fast + ema_fast[i - 1] * (1.0 - k_fast);
-        ema_slow[i] = closes[i] * k_slow + ema_slow[i - 1] * (1.0 - k_slow);
-        macd[i] = ema_fast[i] - ema_slow[i];
+        ema_fast = closes[i] * k_fast + ema_fast * (T(1) - k_fast);
+        ema_slow = closes[i] * k_slow + ema_slow * (T(1) - k_slow);
+        out.macd[i] = ema_fast - ema_slow;
     }
 
-    std::vector<double> signal(closes.size());
-    signal[0] = macd[0];
+    T k_sig = T(2) / (signal_period + T(1));
+    out.signal[0] = out.macd[0];
     for (size_t i = 1; i < closes.size(); ++i) {
-        double k_sig = 2.0 / (signal_period + 1.0);
-        signal[i] = macd[i] * k_sig + signal[i - 1] * (1.0 - k_sig);
+        out.signal[i] = out.macd[i] * k_sig + out.signal[i - 1] * (T(1) - k_sig);
     }
+}
 
-    return {macd, signal};
+template <typename T>
+BasicMACD<T> calc_macd(Span<const T> closes, int fast, int slow, int signal_period) {
+    BasicMACD<T> out;
+    calc_macd(closes, fast, slow, signal_period, out);
+    return out;
 }
 
 // RSI calculation
-std::vector<double> calc_rsi(const std::vector<double>& closes, int period) {
-    // Uncomment the following line to enable benchmarking
-    // BENCHMARK("RSI Internal Calculation");
+template <typename T>
+void calc_rsi(Span<const T> closes, int period, std::vector<T>& rsi) {
+    PROFILE_ZONE("RSI");
 
-    std::vector<double> rsi(closes.size(), std::numeric_limits<double>::quiet_NaN());
-    if (closes.size() < period + 1) return rsi;
+    if (period <= 0) {
+        throw CalculationException("RSI period must be positive");
+    }
+    size_t p = static_cast<size_t>(period);
+    rsi.assign(closes.size(), std::numeric_limits<T>::quiet_NaN());
+    if (closes.size() < p + 1) return;
 
-    double gain = 0.0, loss = 0.0;
-    for (size_t i = 1; i <= period; ++i) {
-        double change = closes[i] - closes[i - 1];
+    T gain = 0, loss = 0;
+    for (size_t i = 1; i <= p; ++i) {
+        T change = closes[i] - closes[i - 1];
         if (change > 0) gain += change;
         else loss -= change;
     }
 
     gain /= period;
     loss /= period;
-    rsi[period] = 100.0 - (100.0 / (1.0 + (gain / loss)));
+    rsi[p] = T(100) - (T(100) / (T(1) + (gain / loss)));
 
-    for (size_t i = period + 1; i < closes.size(); ++i) {
-        double change = closes[i] - closes[i - 1];
+    for (size_t i = p + 1; i < closes.size(); ++i) {
+        T change = closes[i] - closes[i - 1];
         if (change > 0) {
             gain = (gain * (period - 1) + change) / period;
             loss = (loss * (period - 1)) / period;
@@ -86,8 +164,26 @@ std::vector<double> calc_rsi(const std::vector<double>& closes, int period) {
             gain = (gain * (period - 1)) / period;
             loss = (loss * (period - 1) - change) / period;
         }
-        rsi[i] = 100.0 - (100.0 / (1.0 + (gain / loss)));
+        rsi[i] = T(100) - (T(100) / (T(1) + (gain / loss)));
     }
+}
 
+template <typename T>
+std::vector<T> calc_rsi(Span<const T> closes, int period) {
+    std::vector<T> rsi;
+    calc_rsi(closes, period, rsi);
     return rsi;
-}
\ No newline at end of file
+}
+
+template std::vector<double> calc_sma<double>(Span<const double>, int);
+template std::vector<float> calc_sma<float>(Span<const float>, int);
+template MACD calc_macd<double>(Span<const double>, int, int, int);
+template BasicMACD<float> calc_macd<float>(Span<const float>, int, int, int);
+template std::vector<double> calc_rsi<double>(Span<const double>, int);
+template std::vector<float> calc_rsi<float>(Span<const float>, int);
+template void calc_sma<double>(Span<const double>, int, std::vector<double>&);
+template void calc_sma<float>(Span<const float>, int, std::vector<float>&);
+template void calc_macd<double>(Span<const double>, int, int, int, MACD&);
+template void calc_macd<float>(Span<const float>, int, int, int, BasicMACD<float>&);
+template void calc_rsi<double>(Span<const double>, int, std::vector<double>&);
+template void calc_rsi<float>(Span<const float>, int, std::vector<float>&);
\ No newline at end of file
@@ -2,15 +2,58 @@
 #define INDICATORS_H
 
 #include <vector>
+#include "span.h"
+
+// Indicators are templated on the value type T (double or float; both are
+// instantiated in indicators.cpp). Arithmetic runs in T, so float halves the
+// memory traffic of long series at some cost in accuracy.
 
 // SMA calculation
-std::vector<double> calc_sma(const std::vector<double>& v, int period);
+template <typename T>
+std::vector<T> calc_sma(Span<const T> v, int period);
+
+// SMA for several periods in one pass; out[k] matches calc_sma<double>(v,
+// periods[k]) to within 1e-12 relative
+std::vector<std::vector<double>> calc_sma_multi(Span<const double> v, const std::vector<int>& periods);
 
 // MACD calculation
-struct MACD { std::vector<double> macd, signal; };
-MACD calc_macd(const std::vector<double>& c, int fast = 12, int slow = 26, int sig = 9);
+template <typename T>
+struct BasicMACD { std::vector<T> macd, signal; };
+using MACD = BasicMACD<double>;
+
+template <typename T>
+BasicMACD<T> calc_macd(Span<const T> c, int fast = 12, int slow = 26, int sig = 9);
 
 // RSI calculation
-std::vector<double> calc_rsi(const std::vector<double>& closes, int period = 14);
+template <typename T>
+std::vector<T> calc_rsi(Span<const T> closes, int period = 14);
+
+// Output-buffer forms: results are written into `out`, which is resized to
+// the input length. A buffer that already has the capacity is reused, so
+// repeated calls through the same buffers do no heap allocation.
+template <typename T>
+void calc_sma(Span<const T> v, int period, std::vector<T>& out);
+
+template <typename T>
+void calc_macd(Span<const T> c, int fast, int slow, int sig, BasicMACD<T>& out);
+
+template <typename T>
+void calc_rsi(Span<const T> closes, int period, std::vector<T>& out);
+
+// std::vector callers deduce T from the element type
+template <typename T>
+std::vector<T> calc_sma(const std::vector<T>& v, int period) {
+    return calc_sma(Span<const T>(v), period);
+}
+
+template <typename T>
+BasicMACD<T> calc_macd(const std::vector<T>& c, int fast = 12, int slow = 26, int sig = 9) {
+    return calc_macd(Span<const T>(c), fast, slow, sig);
+}
+
+template <typename T>
+std::vector<T> calc_rsi(const std::vector<T>& closes, int period = 14) {
+    return calc_rsi(Span<const T>(closes), period);
+}
 
-#endif // INDICATORS_H
\ No newline at end of file
+#endif // INDICATORS_H
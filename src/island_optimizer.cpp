@@ -0,0 +1,167 @@
+#include "island_optimizer.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+namespace {
+
+struct Island {
+    std::mt19937 gen;
+    std::vector<StrategyParameters> population;
+    std::vector<double> fitness;
+    std::vector<double> history;   // best fitness of each generation
+    StrategyParameters best_params;
+    double best_fitness = -1e6;
+};
+
+std::vector<size_t> rank_best_first(const std::vector<double>& fitness) {
+    std::vector<size_t> order(fitness.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return fitness[a] > fitness[b]; });
+    return order;
+}
+
+} // namespace
+
+IslandOptimizer::IslandOptimizer(const IslandOptions& island_options) : options(island_options) {
+    if (options.islands == 0 || options.population_per_island < 2) {
+        throw CalculationException("Island model needs at least one island of two individuals");
+    }
+}
+
+IslandResult IslandOptimizer::optimize(Span<const double> prices, CachedFitnessFunction fitness_func) {
+    IndicatorCache cache;
+    return optimize(prices, std::move(fitness_func), cache);
+}
+
+IslandResult IslandOptimizer::optimize(Span<const double> prices, CachedFitnessFunction fitness_func,
+                                       IndicatorCache& cache) {
+    PROFILE_ZONE("Island Optimization");
+    // Evaluations look the series up by buffer instead of rehashing it
+    IndicatorCache::ScopedSeries registered(cache, prices);
+
+    const size_t k_islands = options.islands;
+    const size_t pop = options.population_per_island;
+    const size_t elite_count = std::max<size_t>(1, static_cast<size_t>(pop * options.elite_ratio));
+
+    std::vector<Island> islands(k_islands);
+    for (size_t k = 0; k < k_islands; ++k) {
+        std::seed_seq seq{options.seed, static_cast<unsigned int>(k)};
+        islands[k].gen.seed(seq);
+        islands[k].population.resize(pop);
+        islands[k].fitness.assign(pop, 0.0);
+        for (auto& individual : islands[k].population) {
+            individual = StrategyParameters::random(islands[k].gen);
+        }
+    }
+
+    // Runs `count` generations on one island; after a migration the epoch
+    // starts by breeding from the (already scored) mixed population
+    auto advance = [&](size_t k, int count, bool breed_first) {
+        PROFILE_ZONE("Island Epoch");
+        Island& island = islands[k];
+        for (int g = 0; g < count; ++g) {
+            if (g > 0 || breed_first) {
+                island.population = breed_generation(island.population, rank_best_first(island.fitness),
+                                                     elite_count, options.mutation_rate, island.gen);
+            }
+            for (size_t i = 0; i < pop; ++i) {
+                island.fitness[i] = fitness_func(prices, island.population[i], cache);
+            }
+            size_t best = std::max_element(island.fitness.begin(), island.fitness.end()) - island.fitness.begin();
+            island.history.push_back(island.fitness[best]);
+            if (island.fitness[best] > island.best_fitness) {
+                island.best_fitness = island.fitness[best];
+                island.best_params = island.population[best];
+            }
+        }
+    };
+
+    IslandResult result;
+    std::seed_seq migration_seq{options.seed, static_cast<unsigned int>(k_islands), 0x5eedu};
+    std::mt19937 migration_gen(migration_seq);
+
+    // Emigrants are snapshotted before any island receives, so the order of
+    // links does not matter
+    auto migrate = [&]() {
+        PROFILE_ZONE("Migration");
+        size_t migrants = std::min(options.migrants, pop - elite_count);
+        std::vector<std::vector<size_t>> emigrants(k_islands);
+        for (size_t k = 0; k < k_islands; ++k) {
+            auto order = rank_best_first(islands[k].fitness);
+            emigrants[k].assign(order.begin(), order.begin() + migrants);
+        }
+
+        std::vector<std::vector<std::pair<StrategyParameters, double>>> arrivals(k_islands);
+        auto send = [&](size_t from, size_t to) {
+            for (size_t i : emigrants[from]) {
+                arrivals[to].emplace_back(islands[from].population[i], islands[from].fitness[i]);
+            }
+        };
+        if (options.topology == MigrationTopology::Ring) {
+            for (size_t k = 0; k < k_islands; ++k) send(k, (k + 1) % k_islands);
+        } else if (options.topology == MigrationTopology::FullyConnected) {
+            for (size_t from = 0; from < k_islands; ++from) {
+                for (size_t to = 0; to < k_islands; ++to) {
+                    if (from != to) send(from, to);
+                }
+            }
+        } else {
+            std::vector<size_t> targets(k_islands);
+            std::iota(targets.begin(), targets.end(), 0);
+            std::shuffle(targets.begin(), targets.end(), migration_gen);
+            for (size_t k = 0; k < k_islands; ++k) {
+                send(k, targets[k] != k ? targets[k] : (k + 1) % k_islands);
+            }
+        }
+
+        // Arrivals replace the worst residents, never the elites
+        for (size_t k = 0; k < k_islands; ++k) {
+            Island& island = islands[k];
+            auto order = rank_best_first(island.fitness);
+            size_t slots = std::min(arrivals[k].size(), pop - elite_count);
+            for (size_t j = 0; j < slots; ++j) {
+                size_t victim = order[pop - 1 - j];
+                island.population[victim] = arrivals[k][j].first;
+                island.fitness[victim] = arrivals[k][j].second;
+            }
+            result.migrations += slots;
+        }
+    };
+
+    size_t threads = options.threads > 0
+                         ? options.threads
+                         : std::min<size_t>(k_islands, std::max(1u, std::thread::hardware_concurrency()));
+    ThreadPool pool(threads);
+
+    int interval = options.migration_interval > 0 ? options.migration_interval : options.generations;
+    int done = 0;
+    while (done < options.generations) {
+        int count = std::min(interval, options.generations - done);
+        bool breed_first = done > 0;
+        pool.parallel_for(k_islands, [&](size_t k) { advance(k, count, breed_first); });
+        done += count;
+        if (done < options.generations && k_islands > 1) migrate();
+    }
+
+    // Merge in island order so ties resolve the same way every run
+    result.best.best_fitness = -1e6;
+    result.best.generations = options.generations;
+    for (int g = 0; g < options.generations; ++g) {
+        double best = -1e6;
+        for (const Island& island : islands) best = std::max(best, island.history[g]);
+        result.best.fitness_history.push_back(best);
+    }
+    for (const Island& island : islands) {
+        result.island_best.push_back(island.best_fitness);
+        if (island.best_fitness > result.best.best_fitness) {
+            result.best.best_fitness = island.best_fitness;
+            result.best.best_params = island.best_params;
+        }
+    }
+    result.best.bar_evaluations = k_islands * pop * options.generations * prices.size();
+    result.best.full_bar_evaluations = result.best.bar_evaluations;
+    return result;
+}
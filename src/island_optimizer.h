@@ -0,0 +1,55 @@
+#ifndef ISLAND_OPTIMIZER_H
+#define ISLAND_OPTIMIZER_H
+
+#include <vector>
+#include <cstddef>
+#include "optimizer.h"
+
+// Where each island's emigrants go at a migration step
+enum class MigrationTopology {
+    Ring,            // island i sends to i + 1
+    FullyConnected,  // every island sends to every other island
+    Random           // a fresh seeded permutation pairs sources and targets
+};
+
+struct IslandOptions {
+    size_t islands = 4;
+    size_t population_per_island = 30;
+    int generations = 50;
+    int migration_interval = 5;   // generations between migrations
+    size_t migrants = 2;          // best individuals copied per link
+    MigrationTopology topology = MigrationTopology::Ring;
+    double mutation_rate = 0.1;
+    double elite_ratio = 0.2;
+    unsigned int seed = 42;
+    size_t threads = 0;           // 0 = one per island, capped at hardware
+};
+
+struct IslandResult {
+    // Global best; fitness_history is the best of each generation over all islands
+    OptimizationResult best;
+    std::vector<double> island_best;  // best fitness each island found
+    size_t migrations = 0;            // individuals copied between islands
+};
+
+// Island-model GA: K sub-populations evolve independently (same selection,
+// crossover and mutation as GeneticOptimizer) and exchange their best
+// individuals every migration_interval generations, replacing the target's
+// worst. Islands only synchronize at migrations, so throughput scales with
+// islands up to the core count. Each island draws from its own seeded
+// generator and migration runs on the calling thread, so a seed reproduces
+// the run for any thread count.
+class IslandOptimizer {
+private:
+    IslandOptions options;
+
+public:
+    explicit IslandOptimizer(const IslandOptions& island_options);
+
+    // The fitness function is called concurrently from several islands
+    IslandResult optimize(Span<const double> prices, CachedFitnessFunction fitness_func);
+    IslandResult optimize(Span<const double> prices, CachedFitnessFunction fitness_func,
+                          IndicatorCache& cache);
+};
+
+#endif // ISLAND_OPTIMIZER_H
@@ -1,152 +1,520 @@
 #include <iostream>
+#include <iomanip>
 #include <string>
 #include <vector>
-#include <nlohmann/json.hpp>
-#include "utils.h"
+#include <fstream>
+#include <cstdlib>
+#include <memory>
+#include <filesystem>
 #include "indicators.h"
 #include "strategy.h"
 #include "exceptions.h"
-#include "benchmark.h"
+#include "profiler.h"
+#include "perf_counters.h"
 #include "optimizer.h"
+#include "data_source.h"
+#include "batch_runner.h"
+#include "walk_forward.h"
+#include "grid_sweep.h"
+#include "fitness_memo.h"
+#include "pipeline.h"
+#include "chunked_backtest.h"
+#include "portfolio_simulator.h"
+#include "utils.h"
 
-using json = nlohmann::json;
+// Loads the price history for `symbol`. When PRICE_STORE_DIR is set, a
+// previously converted <dir>/<SYMBOL>.atps file is memory-mapped instead of
+// calling the API, and fresh API responses are converted into that store.
+// Raw API responses are also cached on disk when RESPONSE_CACHE_DIR is set.
+// Mapped stores are read in place through LoadedHistory::columns().
+static LoadedHistory load_symbol(const std::string& symbol, StageCounters* perf) {
+    DataSourceConfig config = DataSourceConfig::from_env();
+    LoadedHistory loaded;
+    {
+        PROFILE_ZONE("Data Fetching & Parsing");
+        RawHistory raw;
+        {
+            ScopedStage stage(perf, "fetch");
+            raw = std::move(fetch_histories({symbol}, config).front());
+        }
+        ScopedStage stage(perf, "parse");
+        loaded = materialize_history(std::move(raw), config);
+        stage.set_bars(loaded.columns().size());
+    }
 
-int main() {
-    try {
-        // Uncomment to enable Total Execution Time benchmarking
-        // BENCHMARK("Total Execution Time");
-        
-        const char* apiKey = std::getenv("API_KEY");
-        if (!apiKey) {
-            throw APIException("API key not set. Please set the API_KEY environment variable.");
+    if (loaded.origin == HistoryOrigin::PriceStore) {
+        std::cout << "✅ Loaded " << loaded.total_records << " records from price store\n";
+        return loaded;
+    }
+    if (loaded.origin == HistoryOrigin::ResponseCache) {
+        std::cout << "✅ Using cached API response\n";
+    }
+
+    std::cout << "✅ Total records: " << loaded.total_records << "\n";
+
+    if (loaded.skipped_records > 0) {
+        std::cout << "⚠️ Skipped " << loaded.skipped_records << " records due to missing close prices\n";
+    }
+    if (!loaded.saved_store.empty()) {
+        std::cout << "💾 Saved price store " << loaded.saved_store << "\n";
+    }
+
+    return loaded;
+}
+
+static void print_usage() {
+    std::cout << "Usage:\n"
+              << "  AlgoTrader                      interactive single-symbol session\n"
+              << "  AlgoTrader --batch <symbols>    backtest every symbol in the file\n"
+              << "      [--optimize] [--threads N] [--report results.csv] [--memo-dir DIR]\n"
+              << "      [--float]                   float32 backtests inside the GA\n"
+              << "  AlgoTrader --walk-forward <SYMBOL>  out-of-sample walk-forward optimization\n"
+              << "      [--train BARS] [--test BARS] [--step BARS] [--anchored] [--threads N]\n"
+              << "  AlgoTrader --sweep <SYMBOL>        exhaustive parameter grid (~1M combinations)\n"
+              << "      [--threads N] [--top K]\n"
+              << "  AlgoTrader --job <job.json>       headless pipelined run described by a job file\n"
+              << "      [--json results.json] [--csv results.csv]\n"
+              << "  AlgoTrader --portfolio <symbols>  one portfolio trading every symbol on shared capital\n"
+              << "      [--capital USD] [--fraction F] [--max-positions N] [--equity curve.csv]\n"
+              << "  AlgoTrader --chunked <file.atps>  default-strategy backtest streamed from a price store\n"
+              << "      [--chunk BARS]              bars read per block (default 65536)\n"
+              << "Profiling (either mode; also ALGO_PROFILE=1, ALGO_PROFILE_TRACE=<file>):\n"
+              << "  --profile                       print a zone timing summary on exit\n"
+              << "  --profile-trace <trace.json>    also write a Chrome trace\n"
+              << "  --perf                          per-stage hardware counters for any mode\n"
+              << "                                  (IPC, misses per bar; also ALGO_PERF=1)\n"
+              << "FITNESS_MEMO_DIR=<dir> keeps per-symbol fitness memos for optimizer warm starts\n";
+}
+
+// Non-interactive multi-symbol run
+static int run_batch_mode(const std::vector<std::string>& args, StageCounters* perf) {
+    std::string symbols_path, report_path;
+    BatchOptions options;
+    if (const char* dir = std::getenv("FITNESS_MEMO_DIR")) options.memo_dir = dir;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--batch" && i + 1 < args.size()) {
+            symbols_path = args[++i];
+        } else if (arg == "--optimize") {
+            options.optimize = true;
+        } else if (arg == "--threads" && i + 1 < args.size()) {
+            options.threads = std::stoul(args[++i]);
+        } else if (arg == "--report" && i + 1 < args.size()) {
+            report_path = args[++i];
+        } else if (arg == "--memo-dir" && i + 1 < args.size()) {
+            options.memo_dir = args[++i];
+        } else if (arg == "--float") {
+            options.precision = Precision::Float;
+        } else {
+            print_usage();
+            return 1;
         }
+    }
 
-        std::string symbol;
-        std::cout << "Enter stock symbol: ";
-        std::cin >> symbol;
+    auto symbols = read_symbol_list(symbols_path);
+    if (symbols.empty()) {
+        throw DataException("Symbol list is empty: " + symbols_path);
+    }
 
-        const std::string url = "https://financialmodelingprep.com/api/v3/historical-price-full/" + symbol + "?serietype=line&apikey=" + std::string(apiKey);
+    BatchReport report;
+    {
+        // Fetch and compute overlap, so the batch is measured as one stage
+        ScopedStage stage(perf, "batch");
+        report = run_batch(symbols, DataSourceConfig::from_env(), options);
+        stage.set_bars(report.total_bars());
+    }
 
-        // Use the http_get function to fetch data
-        std::string readBuffer;
-        json j;
-        nlohmann::json historical;  // Fixed: specify the type instead of auto
-        
-        {
-            // Uncomment to enable Data Fetching & Parsing benchmarking
-            // BENCHMARK("Data Fetching & Parsing");
-            readBuffer = http_get(url);
+    if (!report_path.empty()) {
+        std::ofstream out(report_path);
+        if (!out) {
+            throw DataException("Cannot write report: " + report_path);
+        }
+        write_batch_csv(report, out);
+        std::cout << "💾 Wrote " << report_path << "\n";
+    } else {
+        write_batch_csv(report, std::cout);
+    }
+    print_batch_summary(report, std::cout);
+    return report.succeeded() == report.symbols.size() ? 0 : 2;
+}
 
-            if (readBuffer.empty()) {
-                throw APIException("Empty response received from API");
-            }
+// Optimizes rolling/anchored train windows and scores them out-of-sample
+static int run_walk_forward_mode(const std::vector<std::string>& args, StageCounters* perf) {
+    std::string symbol;
+    WalkForwardOptions options;
 
-            try {
-                j = json::parse(readBuffer);
-            } catch (json::parse_error& e) {
-                throw DataException("JSON parse error: " + std::string(e.what()));
-            }
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--walk-forward" && i + 1 < args.size()) {
+            symbol = args[++i];
+        } else if (arg == "--train" && i + 1 < args.size()) {
+            options.train_bars = std::stoul(args[++i]);
+        } else if (arg == "--test" && i + 1 < args.size()) {
+            options.test_bars = std::stoul(args[++i]);
+        } else if (arg == "--step" && i + 1 < args.size()) {
+            options.step_bars = std::stoul(args[++i]);
+        } else if (arg == "--anchored") {
+            options.mode = WindowMode::Anchored;
+        } else if (arg == "--threads" && i + 1 < args.size()) {
+            options.threads = std::stoul(args[++i]);
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
 
-            if (!j.contains("historical") || !j["historical"].is_array()) {
-                throw DataException("JSON does not contain valid 'historical' array");
-            }
+    if (symbol.empty()) {
+        print_usage();
+        return 1;
+    }
 
-            historical = j["historical"];
-            if (historical.empty()) {
-                throw DataException("Historical data is empty");
-            }
+    LoadedHistory history = load_symbol(symbol, perf);
+    Span<const double> closes = history.columns().close;
+    WalkForwardReport report;
+    {
+        ScopedStage stage(perf, "walk-forward", closes.size());
+        report = walk_forward(closes, options);
+    }
+    print_walk_forward(report, std::cout);
+    return 0;
+}
+
+// Backtests the full default parameter lattice and reports best/robust cells
+static int run_sweep_mode(const std::vector<std::string>& args, StageCounters* perf) {
+    std::string symbol;
+    size_t threads = 0, top_k = 5;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--sweep" && i + 1 < args.size()) {
+            symbol = args[++i];
+        } else if (arg == "--threads" && i + 1 < args.size()) {
+            threads = std::stoul(args[++i]);
+        } else if (arg == "--top" && i + 1 < args.size()) {
+            top_k = std::stoul(args[++i]);
+        } else {
+            print_usage();
+            return 1;
         }
+    }
+    if (symbol.empty()) {
+        print_usage();
+        return 1;
+    }
 
-        std::cout << "✅ Total records: " << historical.size() << "\n";
+    LoadedHistory history = load_symbol(symbol, perf);
+    Span<const double> closes = history.columns().close;
+    // GridSweepReport has no empty state, so the stage wraps a lambda
+    GridSweepReport report = [&] {
+        ScopedStage stage(perf, "sweep", closes.size());
+        return grid_sweep(closes, GridAxes::default_axes(), threads);
+    }();
+    print_grid_sweep(report, std::cout, top_k);
+    return 0;
+}
 
-        // Parse closes from oldest to newest
-        std::vector<double> closes;
-        int skipped_count = 0;
-        for (auto it = historical.rbegin(); it != historical.rend(); ++it) {
-            if (it->contains("close") && !(*it)["close"].is_null()) {
-                closes.push_back((*it)["close"]);
-            } else if (it->contains("Close") && !(*it)["Close"].is_null()) {
-                closes.push_back((*it)["Close"]);
-            } else {
-                skipped_count++;
-                continue;
+// Headless run of a job file through the staged pipeline
+static int run_job_mode(const std::vector<std::string>& args, StageCounters* perf) {
+    std::string job_path, json_path, csv_path;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--job" && i + 1 < args.size()) {
+            job_path = args[++i];
+        } else if (arg == "--json" && i + 1 < args.size()) {
+            json_path = args[++i];
+        } else if (arg == "--csv" && i + 1 < args.size()) {
+            csv_path = args[++i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    PipelineJob job = load_job_file(job_path);
+    if (!json_path.empty()) job.json_path = json_path;
+    if (!csv_path.empty()) job.csv_path = csv_path;
+
+    PipelineReport report;
+    {
+        // Stages run concurrently; print_pipeline_stages breaks the time down
+        ScopedStage stage(perf, "pipeline");
+        report = run_pipeline(job);
+        stage.set_bars(report.batch.total_bars());
+    }
+
+    if (!job.json_path.empty()) {
+        std::ofstream out(job.json_path);
+        if (!out) {
+            throw DataException("Cannot write report: " + job.json_path);
+        }
+        write_pipeline_json(report, out);
+        std::cout << "💾 Wrote " << job.json_path << "\n";
+    }
+    if (!job.csv_path.empty()) {
+        std::ofstream out(job.csv_path);
+        if (!out) {
+            throw DataException("Cannot write report: " + job.csv_path);
+        }
+        write_batch_csv(report.batch, out);
+        std::cout << "💾 Wrote " << job.csv_path << "\n";
+    }
+    if (job.json_path.empty() && job.csv_path.empty()) {
+        write_pipeline_json(report, std::cout);
+    }
+    print_batch_summary(report.batch, std::cout);
+    print_pipeline_stages(report, std::cout);
+    return report.batch.succeeded() == report.batch.symbols.size() ? 0 : 2;
+}
+
+// Event-driven simulation of one portfolio across every listed symbol
+static int run_portfolio_mode(const std::vector<std::string>& args, StageCounters* perf) {
+    std::string symbols_path, equity_path;
+    PortfolioOptions options;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--portfolio" && i + 1 < args.size()) {
+            symbols_path = args[++i];
+        } else if (arg == "--capital" && i + 1 < args.size()) {
+            options.initial_capital = std::stod(args[++i]);
+        } else if (arg == "--fraction" && i + 1 < args.size()) {
+            options.position_fraction = std::stod(args[++i]);
+        } else if (arg == "--max-positions" && i + 1 < args.size()) {
+            options.max_positions = std::stoul(args[++i]);
+        } else if (arg == "--equity" && i + 1 < args.size()) {
+            equity_path = args[++i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    auto symbols = read_symbol_list(symbols_path);
+    if (symbols.empty()) {
+        throw DataException("Symbol list is empty: " + symbols_path);
+    }
+
+    DataSourceConfig config = DataSourceConfig::from_env();
+    std::vector<RawHistory> raws;
+    {
+        ScopedStage stage(perf, "fetch");
+        raws = fetch_histories(symbols, config);
+    }
+    std::vector<LoadedHistory> histories;
+    std::vector<PriceColumns> universe;
+    {
+        ScopedStage stage(perf, "parse");
+        for (RawHistory& raw : raws) {
+            std::string symbol = raw.symbol;
+            try {
+                if (!raw.ok()) throw DataException(raw.error);
+                histories.push_back(materialize_history(std::move(raw), config));
+            } catch (const TradingException& e) {
+                std::cout << "  ❌ " << symbol << ": " << e.what() << "\n";
             }
         }
+        size_t bars = 0;
+        for (const LoadedHistory& history : histories) {
+            universe.push_back(history.columns());
+            bars += universe.back().size();
+        }
+        stage.set_bars(bars);
+    }
+    std::cout << "✅ Loaded " << universe.size() << " of " << symbols.size() << " symbols\n";
 
-        if (skipped_count > 0) {
-            std::cout << "⚠️ Skipped " << skipped_count << " records due to missing close prices\n";
+    PortfolioReport report;
+    {
+        ScopedStage stage(perf, "portfolio");
+        report = simulate_portfolio(universe, options);
+        stage.set_bars(report.bar_events);
+    }
+    print_portfolio_report(report, std::cout);
+    if (!equity_path.empty()) {
+        std::ofstream out(equity_path);
+        if (!out) {
+            throw DataException("Cannot write report: " + equity_path);
         }
+        write_equity_csv(report, out);
+        std::cout << "💾 Wrote " << equity_path << "\n";
+    }
+    return universe.size() == symbols.size() ? 0 : 2;
+}
 
-        if (closes.size() < 250) {
-            throw DataException("Insufficient valid data points: " + std::to_string(closes.size()) + " (need at least 250)");
+// Backtest of a price store too long to load, read block by block
+static int run_chunked_mode(const std::vector<std::string>& args, StageCounters* perf) {
+    std::string store_path;
+    size_t chunk_bars = DEFAULT_CHUNK_BARS;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--chunked" && i + 1 < args.size()) {
+            store_path = args[++i];
+        } else if (arg == "--chunk" && i + 1 < args.size()) {
+            chunk_bars = std::stoul(args[++i]);
+        } else {
+            print_usage();
+            return 1;
         }
+    }
+    if (store_path.empty()) {
+        print_usage();
+        return 1;
+    }
 
-        std::cout << "✅ Valid records: " << closes.size() << "\n";
+    BacktestResult result;
+    {
+        ScopedStage stage(perf, "chunked backtest", PriceStoreColumnReader(store_path).size());
+        result = backtest_chunked(store_path, StrategyParameters{}, chunk_bars);
+    }
+    std::cout << "📦 Streamed " << store_path << " in blocks of " << chunk_bars << " bars\n";
+    std::cout << "\n📊 Default Strategy Performance:\n";
+    std::cout << "  Triggers: " << result.triggers << "\n";
+    std::cout << "  Successes: " << result.successes << "\n";
+    std::cout << "  Win Rate: " << std::fixed << std::setprecision(2) << result.win_rate << "%\n";
+    std::cout << "  Fitness Score: " << result.fitness << "\n";
+    return 0;
+}
 
-        // For strategies that need high/low, use close prices as approximation
-        std::vector<double> highs = closes;
-        std::vector<double> lows = closes;
+// Interactive single-symbol session
+// `perf` is null unless stage counters were requested.
+static int run_interactive(StageCounters* perf) {
+    PROFILE_ZONE("Total Execution Time");
 
-        const int MA_PERIOD = 200;
-        const int RSI_PERIOD = 14;
-        const int LOOK_AHEAD = 10;
-        const double STOP_LOSS_PERCENT = 0.01;
-        const double TAKE_PROFIT_PERCENT = 0.02;
+    std::string symbol;
+    std::cout << "Enter stock symbol: ";
+    std::cin >> symbol;
+    if (!is_valid_symbol(symbol)) {
+        throw DataException("Invalid symbol: " + symbol + " (expected 1-15 of A-Z, a-z, 0-9, '.', '-')");
+    }
 
-        std::vector<double> sma200;
-        MACD macd;
-        std::vector<double> rsi;
+    LoadedHistory history = load_symbol(symbol, perf);
+    PriceColumns bars = history.columns();
+    Span<const double> closes = bars.close;
 
+    if (closes.size() < 250) {
+        throw DataException("Insufficient valid data points: " + std::to_string(closes.size()) + " (need at least 250)");
+    }
+
+    std::cout << "✅ Valid records: " << closes.size() << "\n";
+
+    StrategyParameters strategy;
+    strategy.ma_period = 200;
+    strategy.rsi_period = 14;
+    strategy.rsi_threshold = 70.0;
+    strategy.look_ahead = 10;
+    strategy.stop_loss = 0.01;
+    strategy.take_profit = 0.02;
+    validate_strategy_parameters(strategy, closes.size());
+
+    {
+        PROFILE_ZONE("Strategy Backtesting");
+        ScopedStage stage(perf, "backtest", closes.size());
+        backtest_strategy(closes, strategy);
+    }
+
+    {
+        // Same rule with capital and overlapping positions, exits checked
+        // against each bar's real high and low
+        ScopedStage stage(perf, "portfolio", closes.size());
+        PortfolioOptions portfolio;
+        portfolio.params = strategy;
+        print_portfolio_report(simulate_portfolio({bars}, portfolio), std::cout);
+    }
+
+    std::cout << "\n🤖 Running Parameter Optimization...\n";
+    std::string optimize_choice;
+    std::cout << "Run genetic algorithm optimization? (y/n): ";
+    std::cin >> optimize_choice;
+
+    if (optimize_choice == "y" || optimize_choice == "Y") {
+        OptimizationResult opt_result;
         {
-            // BENCHMARK("All Indicator Calculations");
-            {
-                // BENCHMARK("SMA Calculation");
-                sma200 = calc_sma(closes, MA_PERIOD);
-            }
-            {
-                // BENCHMARK("MACD Calculation");
-                macd = calc_macd(closes);
+            // Bars are counted per fitness evaluation (bar-evaluations)
+            ScopedStage stage(perf, "optimize");
+            GeneticOptimizer optimizer(30, 50); // 30 population, 50 generations
+
+            // Reuse earlier evaluations and warm-start from the last run's population
+            FitnessMemo memo;
+            std::string memo_path;
+            if (const char* dir = std::getenv("FITNESS_MEMO_DIR")) {
+                std::filesystem::create_directories(dir);
+                memo_path = fitness_memo_path(dir, symbol);
+                if (memo.load(memo_path)) {
+                    std::cout << "🧠 Loaded fitness memo " << memo_path << "\n";
+                }
+                optimizer.set_memo(&memo);
             }
-            {
-                // BENCHMARK("RSI Calculation");
-                rsi = calc_rsi(closes, RSI_PERIOD);
+            opt_result = optimizer.optimize(closes, cached_backtest_fitness);
+            stage.set_bars(opt_result.bar_evaluations);
+            if (!memo_path.empty()) {
+                memo.prune_untouched();
+                memo.save(memo_path);
+                std::cout << "💾 Saved fitness memo " << memo_path << "\n";
             }
         }
+        
+        std::cout << "\n📊 Testing Optimized vs Original Parameters:\n";
 
-        // Validate indicator calculations
-        if (sma200.empty() || macd.macd.empty() || rsi.empty()) {
-            throw CalculationException("Failed to calculate technical indicators");
+        std::cout << "\n🎯 Optimized Strategy Results:\n";
+        {
+            ScopedStage stage(perf, "backtest optimized", closes.size());
+            backtest_strategy(closes, opt_result.best_params);
         }
+        std::cout << "Fitness Score: " << opt_result.best_fitness << " (vs default strategy)\n";
+    }
 
-        {
-            // Uncomment to enable strategy backtesting
-            // BENCHMARK("Strategy Backtesting");
-            backtest_strategy(closes, sma200, rsi, macd.macd, macd.signal, LOOK_AHEAD, STOP_LOSS_PERCENT, TAKE_PROFIT_PERCENT);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    try {
+        // Static so it outlives the main thread's thread_local curl handle
+        static CurlGlobal curl;
+
+        // Profiling flags are stripped before mode dispatch
+        Profiler::init_from_env();
+        const char* perf_env = std::getenv("ALGO_PERF");
+        bool perf_enabled = perf_env && *perf_env && std::string(perf_env) != "0";
+        std::vector<std::string> args;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--perf") {
+                perf_enabled = true;
+            } else if (arg == "--profile") {
+                Profiler::set_enabled(true);
+            } else if (arg == "--profile-trace" && i + 1 < argc) {
+                Profiler::set_trace_path(argv[++i]);
+                Profiler::set_enabled(true);
+            } else {
+                args.push_back(arg);
+            }
         }
 
-        std::cout << "\n🤖 Running Parameter Optimization...\n";
-        std::string optimize_choice;
-        std::cout << "Run genetic algorithm optimization? (y/n): ";
-        std::cin >> optimize_choice;
+        // Opened before any worker threads exist so they are counted too
+        std::unique_ptr<StageCounters> perf;
+        if (perf_enabled) perf = std::make_unique<StageCounters>();
 
-        if (optimize_choice == "y" || optimize_choice == "Y") {
-            GeneticOptimizer optimizer(30, 50); // 30 population, 50 generations
-            auto opt_result = optimizer.optimize(closes, backtest_fitness);
-            
-            std::cout << "\n📊 Testing Optimized vs Original Parameters:\n";
-            
-            // Test optimized parameters
-            auto opt_sma = calc_sma(closes, opt_result.best_params.ma_period);
-            auto opt_macd = calc_macd(closes);
-            auto opt_rsi = calc_rsi(closes, opt_result.best_params.rsi_period);
-            
-            std::cout << "\n🎯 Optimized Strategy Results:\n";
-            // You can create a version of backtest_strategy that accepts parameters
-            // For now, just show the fitness improvement
-            std::cout << "Fitness Score: " << opt_result.best_fitness << " (vs default strategy)\n";
-        }
-
-        return 0;
+        int status;
+        if (args.empty()) {
+            status = run_interactive(perf.get());
+        } else if (args.front() == "--walk-forward") {
+            status = run_walk_forward_mode(args, perf.get());
+        } else if (args.front() == "--sweep") {
+            status = run_sweep_mode(args, perf.get());
+        } else if (args.front() == "--job") {
+            status = run_job_mode(args, perf.get());
+        } else if (args.front() == "--portfolio") {
+            status = run_portfolio_mode(args, perf.get());
+        } else if (args.front() == "--chunked") {
+            status = run_chunked_mode(args, perf.get());
+        } else {
+            status = run_batch_mode(args, perf.get());
+        }
+        if (perf) perf->print_report(std::cout);
+        Profiler::report(std::cout);
+        return status;
 
     } catch (const TradingException& e) {
         std::cerr << "❌ Trading Error: " << e.what() << "\n";
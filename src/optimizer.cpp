@@ -1,9 +1,17 @@
 #include "optimizer.h"
 #include "indicators.h"
-#include "benchmark.h"
+#include "strategy.h"
+#include "strategy_engine.h"
+#include "profiler.h"
+#include "fitness_memo.h"
+#include "backtest_workspace.h"
+#include "exit_resolver.h"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <numeric>
 
 void StrategyParameters::mutate(std::mt19937& gen, double mutation_rate) {
     std::uniform_real_distribution<> dis(0.0, 1.0);
@@ -37,52 +45,176 @@ StrategyParameters StrategyParameters::crossover(const StrategyParameters& paren
     return child;
 }
 
-GeneticOptimizer::GeneticOptimizer(size_t pop_size, int max_gen, double mut_rate, double elite)
+StrategyParameters StrategyParameters::random(std::mt19937& gen) {
+    std::uniform_int_distribution<> ma_dist(50, 300);
+    std::uniform_int_distribution<> rsi_dist(10, 20);
+    std::uniform_real_distribution<> threshold_dist(60.0, 80.0);
+    std::uniform_real_distribution<> percent_dist(0.005, 0.05);
+    std::uniform_int_distribution<> look_dist(5, 20);
+
+    StrategyParameters p;
+    p.ma_period = ma_dist(gen);
+    p.rsi_period = rsi_dist(gen);
+    p.rsi_threshold = threshold_dist(gen);
+    p.stop_loss = percent_dist(gen);
+    p.take_profit = percent_dist(gen);
+    p.look_ahead = look_dist(gen);
+    return p;
+}
+
+std::vector<StrategyParameters> breed_generation(const std::vector<StrategyParameters>& population,
+                                                 const std::vector<size_t>& ranked, size_t elite_count,
+                                                 double mutation_rate, std::mt19937& gen) {
+    std::vector<StrategyParameters> next;
+    next.reserve(population.size());
+
+    // Keep elite individuals
+    for (size_t i = 0; i < elite_count; ++i) {
+        next.push_back(population[ranked[i]]);
+    }
+
+    // Generate offspring
+    std::uniform_int_distribution<size_t> parent_dist(0, elite_count - 1);
+    while (next.size() < population.size()) {
+        size_t parent1_idx = ranked[parent_dist(gen)];
+        size_t parent2_idx = ranked[parent_dist(gen)];
+
+        auto child = StrategyParameters::crossover(population[parent1_idx], population[parent2_idx], gen);
+        child.mutate(gen, mutation_rate);
+        next.push_back(child);
+    }
+    return next;
+}
+
+GeneticOptimizer::GeneticOptimizer(size_t pop_size, int max_gen, double mut_rate, double elite,
+                                   unsigned int seed, size_t num_threads)
     : population_size(pop_size), max_generations(max_gen), mutation_rate(mut_rate), 
-      elite_ratio(elite), gen(std::random_device{}()) {}
+      elite_ratio(elite), gen(seed) {
+    if (num_threads > 1) {
+        pool = std::make_unique<ThreadPool>(num_threads);
+    }
+}
+
+OptimizationResult GeneticOptimizer::optimize(Span<const double> prices, FitnessFunction fitness_func) {
+    IndicatorCache unused;
+    return optimize(prices,
+                    [&](Span<const double> p, const StrategyParameters& params, IndicatorCache&) {
+                        return fitness_func(p, params);
+                    },
+                    unused);
+}
+
+OptimizationResult GeneticOptimizer::optimize(Span<const double> prices, CachedFitnessFunction fitness_func) {
+    IndicatorCache cache;
+    return optimize(prices, std::move(fitness_func), cache);
+}
 
-OptimizationResult GeneticOptimizer::optimize(
-    const std::vector<double>& prices,
-    std::function<double(const std::vector<double>&, const StrategyParameters&)> fitness_func) {
+OptimizationResult GeneticOptimizer::optimize(Span<const double> prices, CachedFitnessFunction fitness_func,
+                                              IndicatorCache& cache) {
     
-    BENCHMARK("Genetic Algorithm Optimization");
+    PROFILE_ZONE("Genetic Algorithm Optimization");
     
     // Initialize population
     std::vector<StrategyParameters> population(population_size);
     std::vector<double> fitness(population_size);
-    
-    // Random parameter ranges
-    std::uniform_int_distribution<> ma_dist(50, 300);
-    std::uniform_int_distribution<> rsi_dist(10, 20);
-    std::uniform_real_distribution<> threshold_dist(60.0, 80.0);
-    std::uniform_real_distribution<> percent_dist(0.005, 0.05);
-    std::uniform_int_distribution<> look_dist(5, 20);
-    
-    // Create initial population
     for (auto& individual : population) {
-        individual.ma_period = ma_dist(gen);
-        individual.rsi_period = rsi_dist(gen);
-        individual.rsi_threshold = threshold_dist(gen);
-        individual.stop_loss = percent_dist(gen);
-        individual.take_profit = percent_dist(gen);
-        individual.look_ahead = look_dist(gen);
+        individual = StrategyParameters::random(gen);
+    }
+    MemoStats memo_before{0, 0, 0};
+    if (memo) {
+        memo_before = memo->stats();
+        auto seeds = memo->population();
+        size_t warm = std::min(seeds.size(), population_size / 2);
+        std::copy(seeds.begin(), seeds.begin() + warm, population.begin());
     }
     
     OptimizationResult result;
     result.best_fitness = -1e6;
+
+    // Racing rungs as prefix views of `prices`; the last rung is always
+    // `prices` itself
+    std::vector<Span<const double>> prefixes;
+    if (racing.enabled) {
+        for (double fraction : racing.rungs) {
+            size_t bars = std::max(static_cast<size_t>(fraction * prices.size()), racing.min_bars);
+            if (bars >= prices.size()) break;
+            if (prefixes.empty() || bars > prefixes.back().size()) {
+                prefixes.push_back(prices.subspan(0, bars));
+            }
+        }
+    }
+    size_t elite_count = static_cast<size_t>(population_size * elite_ratio);
+    // Rung at which each individual was last scored; selection ranks it first
+    std::vector<size_t> rung(population_size, 0);
+    // Series id per rung, registered with the cache for this run so
+    // evaluations find it without rehashing; also the memo keys. Slots
+    // answered by the memo skip their bar-evaluations.
+    std::vector<std::unique_ptr<IndicatorCache::ScopedSeries>> registered;
+    std::vector<uint64_t> series_ids;
+    for (const auto& prefix : prefixes) {
+        registered.push_back(std::make_unique<IndicatorCache::ScopedSeries>(cache, prefix));
+        series_ids.push_back(registered.back()->id());
+    }
+    registered.push_back(std::make_unique<IndicatorCache::ScopedSeries>(cache, prices));
+    series_ids.push_back(registered.back()->id());
+    std::vector<char> from_memo(population_size, 0);
     
-    std::cout << "\n🧬 Starting Genetic Algorithm Optimization...\n";
-    std::cout << "Population: " << population_size << ", Generations: " << max_generations << "\n\n";
+    if (verbose) {
+        std::cout << "\n🧬 Starting Genetic Algorithm Optimization...\n";
+        std::cout << "Population: " << population_size << ", Generations: " << max_generations << "\n\n";
+    }
     
+    std::vector<size_t> alive;
     for (int generation = 0; generation < max_generations; ++generation) {
-        // Evaluate fitness for each individual
-        for (size_t i = 0; i < population_size; ++i) {
-            fitness[i] = fitness_func(prices, population[i]);
+        PROFILE_ZONE("Generation");
+
+        // Evaluate fitness for each individual; each index writes only its own slot.
+        // Without racing there is a single rung: everyone on the full series.
+        alive.resize(population_size);
+        std::iota(alive.begin(), alive.end(), 0);
+        for (size_t r = 0; r <= prefixes.size(); ++r) {
+            Span<const double> series = r < prefixes.size() ? prefixes[r] : prices;
+            auto evaluate = [&](size_t k) {
+                size_t i = alive[k];
+                if (memo) {
+                    from_memo[i] = memo->lookup(series_ids[r], population[i], fitness[i]);
+                    if (from_memo[i]) return;
+                }
+                PROFILE_ZONE("Fitness Evaluation");
+                fitness[i] = fitness_func(series, population[i], cache);
+                if (memo) memo->store(series_ids[r], population[i], fitness[i]);
+            };
+            {
+                PROFILE_ZONE("Evaluate Population");
+                if (pool) {
+                    pool->parallel_for(alive.size(), evaluate);
+                } else {
+                    for (size_t k = 0; k < alive.size(); ++k) evaluate(k);
+                }
+            }
+            size_t computed = alive.size();
+            for (size_t i : alive) computed -= from_memo[i];
+            result.bar_evaluations += computed * series.size();
+            for (size_t i : alive) rung[i] = r;
+            if (r == prefixes.size()) break;
+
+            // Advance the best keep_fraction (never fewer than the elites)
+            size_t keep = static_cast<size_t>(std::ceil(alive.size() * racing.keep_fraction));
+            keep = std::min(alive.size(), std::max({keep, elite_count, size_t{1}}));
+            std::stable_sort(alive.begin(), alive.end(),
+                             [&](size_t a, size_t b) { return fitness[a] > fitness[b]; });
+            alive.resize(keep);
         }
+        result.full_bar_evaluations += population_size * prices.size();
         
-        // Find best individual
-        auto best_it = std::max_element(fitness.begin(), fitness.end());
-        size_t best_idx = std::distance(fitness.begin(), best_it);
+        // Find best individual among those scored on the full series
+        size_t best_idx = population_size;
+        for (size_t i = 0; i < population_size; ++i) {
+            if (rung[i] == prefixes.size() && (best_idx == population_size || fitness[i] > fitness[best_idx])) {
+                best_idx = i;
+            }
+        }
+        auto best_it = fitness.begin() + best_idx;
         
         if (fitness[best_idx] > result.best_fitness) {
             result.best_fitness = fitness[best_idx];
@@ -92,7 +224,7 @@ OptimizationResult GeneticOptimizer::optimize(
         result.fitness_history.push_back(*best_it);
         
         // Print progress every 10 generations
-        if (generation % 10 == 0 || generation == max_generations - 1) {
+        if (verbose && (generation % 10 == 0 || generation == max_generations - 1)) {
             std::cout << "Generation " << std::setw(3) << generation 
                       << " | Best Fitness: " << std::fixed << std::setprecision(2) 
                       << *best_it << " | Avg: " 
@@ -101,35 +233,27 @@ OptimizationResult GeneticOptimizer::optimize(
         }
         
         // Selection and reproduction
-        std::vector<StrategyParameters> new_population;
-        
-        // Keep elite individuals
+        PROFILE_ZONE("Selection & Breeding");
         std::vector<size_t> indices(population_size);
         std::iota(indices.begin(), indices.end(), 0);
-        std::sort(indices.begin(), indices.end(), 
-                  [&](size_t a, size_t b) { return fitness[a] > fitness[b]; });
-        
-        size_t elite_count = static_cast<size_t>(population_size * elite_ratio);
-        for (size_t i = 0; i < elite_count; ++i) {
-            new_population.push_back(population[indices[i]]);
-        }
+        std::sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+            return rung[a] != rung[b] ? rung[a] > rung[b] : fitness[a] > fitness[b];
+        });
         
-        // Generate offspring
-        std::uniform_int_distribution<size_t> parent_dist(0, elite_count - 1);
-        while (new_population.size() < population_size) {
-            size_t parent1_idx = indices[parent_dist(gen)];
-            size_t parent2_idx = indices[parent_dist(gen)];
-            
-            auto child = StrategyParameters::crossover(population[parent1_idx], 
-                                                     population[parent2_idx], gen);
-            child.mutate(gen, mutation_rate);
-            new_population.push_back(child);
+        if (generation == max_generations - 1) {
+            for (size_t i : indices) result.final_population.push_back(population[i]);
         }
-        
-        population = std::move(new_population);
+        population = breed_generation(population, indices, elite_count, mutation_rate, gen);
     }
     
     result.generations = max_generations;
+    if (memo) {
+        MemoStats memo_after = memo->stats();
+        result.memo_hits = memo_after.hits - memo_before.hits;
+        result.memo_lookups = result.memo_hits + memo_after.misses - memo_before.misses;
+        memo->set_population(result.final_population);
+    }
+    if (!verbose) return result;
     
     std::cout << "\n🎯 Optimization Complete!\n";
     std::cout << "Best Parameters:\n";
@@ -140,8 +264,28 @@ OptimizationResult GeneticOptimizer::optimize(
     std::cout << "  Take Profit: " << result.best_params.take_profit * 100 << "%\n";
     std::cout << "  Look Ahead: " << result.best_params.look_ahead << " days\n";
 
+    if (!prefixes.empty()) {
+        std::cout << "  Racing: " << result.bar_evaluations << " of " << result.full_bar_evaluations
+                  << " bar-evaluations (" << std::fixed << std::setprecision(1)
+                  << 100.0 * (1.0 - static_cast<double>(result.bar_evaluations) / result.full_bar_evaluations)
+                  << "% saved)\n";
+    }
+
+    if (memo) {
+        std::cout << "  Fitness Memo: " << result.memo_hits << " hits of " << result.memo_lookups
+                  << " lookups (" << std::fixed << std::setprecision(1)
+                  << (result.memo_lookups > 0 ? 100.0 * result.memo_hits / result.memo_lookups : 0.0)
+                  << "%), " << memo->stats().entries << " entries\n";
+    }
+
+    CacheStats cache_stats = cache.stats();
+    if (cache_stats.hits + cache_stats.misses > 0) {
+        std::cout << "  Indicator Cache: " << cache_stats.hits << " hits, "
+                  << cache_stats.misses << " computations\n";
+    }
+
     // Calculate and display actual optimized performance
-    auto opt_result = backtest_detailed(prices, result.best_params);
+    auto opt_result = backtest_detailed(prices, result.best_params, cache);
     std::cout << "\n📊 Optimized Strategy Performance:\n";
     std::cout << "  Triggers: " << opt_result.triggers << "\n";
     std::cout << "  Successes: " << opt_result.successes << "\n";
@@ -151,71 +295,204 @@ OptimizationResult GeneticOptimizer::optimize(
     return result;
 }
 
-// Detailed backtest function that returns full results
-
-BacktestResult backtest_detailed(const std::vector<double>& prices, const StrategyParameters& params) {
+// Turns trigger and exit tallies into the fitness score
+BacktestResult score_outcomes(size_t triggers, size_t successes, double total_return) {
     BacktestResult result{-1000.0, 0.0, 0, 0};
-    
-    if (prices.size() < params.ma_period + params.look_ahead + 50) {
+    if (triggers == 0) {
+        result.fitness = -100.0;
         return result;
     }
     
+    double win_rate = static_cast<double>(successes) / triggers;
+    double avg_return = total_return / triggers;
+    
+    result.fitness = win_rate * 100.0 + avg_return * 1000.0;
+    result.win_rate = win_rate * 100.0;
+    result.triggers = triggers;
+    result.successes = successes;
+    result.total_return = total_return;
+    
+    return result;
+}
+
+static BacktestResult score_tally(const TradeTally& tally) {
+    return score_outcomes(tally.triggers, tally.successes, tally.total_return);
+}
+
+// The shared entry rule over precomputed arrays in T
+template <typename T>
+static auto array_entry(Span<const T> prices, Span<const T> sma, const BasicMACD<T>& macd, Span<const T> rsi,
+                        double rsi_threshold) {
+    return all_of(SeriesAboveSMA<T>(prices, sma), SeriesMACDCross<T>(macd), SeriesRSIBelow<T>(rsi, rsi_threshold));
+}
+
+static bool has_enough_data(Span<const double> prices, const StrategyParameters& params) {
+    return prices.size() >= static_cast<size_t>(params.ma_period + params.look_ahead + 50);
+}
+
+// Detailed backtest function that returns full results
+
+BacktestResult backtest_detailed(Span<const double> prices, const StrategyParameters& params) {
+    if (!has_enough_data(prices, params)) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+    
+    PROFILE_ZONE("Backtest");
     try {
-        auto sma = calc_sma(prices, params.ma_period);
-        auto macd = calc_macd(prices);
-        auto rsi = calc_rsi(prices, params.rsi_period);
-        
-        size_t triggers = 0, successes = 0;
-        double total_return = 0.0;
-        
-        for (size_t i = params.ma_period; i + params.look_ahead < prices.size(); ++i) {
-            bool above_ma = prices[i] > sma[i];
-            bool bullish_macd = macd.macd[i] > macd.signal[i] && 
-                               macd.macd[i-1] <= macd.signal[i-1];
-            bool rsi_condition = rsi[i] < params.rsi_threshold;
-            
-            if (above_ma && bullish_macd && rsi_condition) {
-                ++triggers;
-                
-                double entry_price = prices[i];
-                double stop_loss = entry_price * (1.0 - params.stop_loss);
-                double take_profit = entry_price * (1.0 + params.take_profit);
-                
-                for (size_t j = i + 1; j <= i + params.look_ahead && j < prices.size(); ++j) {
-                    if (prices[j] >= take_profit) {
-                        ++successes;
-                        total_return += params.take_profit;
-                        break;
-                    }
-                    if (prices[j] <= stop_loss) {
-                        total_return -= params.stop_loss;
-                        break;
-                    }
-                }
-            }
+        // Fused scan: no full-length indicator arrays are materialized, and
+        // each entry's exit is resolved as it fires
+        BacktestWorkspace& ws = BacktestWorkspace::for_thread();
+        auto entry = all_of(CloseAboveSMA(ws.sma_stream, params.ma_period), MACDBullishCross(),
+                            RSIBelow(params.rsi_period, params.rsi_threshold));
+        TakeProfitStopLoss<> exit(params.stop_loss, params.take_profit, params.look_ahead);
+        return score_tally(run_strategy(entry, exit, Span<const double>(prices), params.ma_period,
+                                        prices.size() - params.look_ahead));
+    } catch (...) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+}
+
+BacktestResult backtest_detailed(Span<const double> prices, const StrategyParameters& params,
+                                 IndicatorCache& cache) {
+    if (!has_enough_data(prices, params)) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+    return backtest_window(prices, params, cache, cache.series_id(prices), 0, prices.size());
+}
+
+BacktestResult backtest_window(Span<const double> prices, const StrategyParameters& params,
+                               IndicatorCache& cache, uint64_t series_id, size_t begin, size_t end) {
+    // Same minimum as has_enough_data: 50 scan bars after warm-up and look-ahead
+    size_t scan_begin = std::max(begin, static_cast<size_t>(params.ma_period));
+    if (end > prices.size() || scan_begin + params.look_ahead + 50 > end) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+
+    PROFILE_ZONE("Backtest");
+    try {
+        IndicatorCache::Series sma, rsi;
+        IndicatorCache::MACDPtr macd;
+        IndicatorCache::ExitResolverPtr exits;
+        {
+            PROFILE_ZONE("Indicator Lookup");
+            sma = cache.sma(prices, series_id, params.ma_period);
+            macd = cache.macd(prices, series_id);
+            rsi = cache.rsi(prices, series_id, params.rsi_period);
+            exits = cache.exit_resolver(prices, series_id, EXIT_TABLE_WINDOW);
         }
-        
-        if (triggers == 0) {
-            result.fitness = -100.0;
-            return result;
+        auto entry = array_entry<double>(prices, *sma, *macd, *rsi, params.rsi_threshold);
+        ResolvedTakeProfitStopLoss exit(*exits, params.stop_loss, params.take_profit, params.look_ahead);
+        return score_tally(run_strategy(entry, exit, Span<const double>(prices), scan_begin, end - params.look_ahead));
+    } catch (...) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+}
+
+void prefetch_indicators(Span<const double> prices, const StrategyParameters& params,
+                         IndicatorCache& cache, uint64_t series_id) {
+    // Series too short for a period are left to backtest_window to report
+    try {
+        cache.sma(prices, series_id, params.ma_period);
+        cache.macd(prices, series_id);
+        cache.rsi(prices, series_id, params.rsi_period);
+        cache.exit_resolver(prices, series_id, EXIT_TABLE_WINDOW);
+    } catch (...) {
+    }
+}
+
+// Indicators into the workspace's T buffers
+template <typename T>
+static void fill_indicators(Span<const T> prices, const StrategyParameters& params, BacktestWorkspace& ws) {
+    IndicatorBuffers<T>& buffers = ws.buffers<T>();
+    calc_sma(prices, params.ma_period, buffers.sma);
+    calc_macd(prices, 12, 26, 9, buffers.macd);
+    calc_rsi(prices, params.rsi_period, buffers.rsi);
+}
+
+template <typename T>
+std::vector<size_t> entry_triggers(Span<const T> prices, const StrategyParameters& params) {
+    BacktestWorkspace& ws = BacktestWorkspace::for_thread();
+    fill_indicators(prices, params, ws);
+    IndicatorBuffers<T>& buffers = ws.buffers<T>();
+    auto entry = array_entry<T>(prices, buffers.sma, buffers.macd, buffers.rsi, params.rsi_threshold);
+    size_t end = prices.size() > static_cast<size_t>(params.look_ahead) ? prices.size() - params.look_ahead : 0;
+    scan_entries(entry, prices, params.ma_period, end, ws.triggers);
+    return ws.triggers;
+}
+
+template <typename T>
+BacktestResult backtest_arrays(Span<const T> prices, const StrategyParameters& params, BacktestWorkspace& ws) {
+    if (prices.size() < static_cast<size_t>(params.ma_period + params.look_ahead + 50)) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+
+    PROFILE_ZONE("Backtest");
+    try {
+        fill_indicators(prices, params, ws);
+        IndicatorBuffers<T>& buffers = ws.buffers<T>();
+        auto entry = array_entry<T>(prices, buffers.sma, buffers.macd, buffers.rsi, params.rsi_threshold);
+        TakeProfitStopLoss<T> exit(params.stop_loss, params.take_profit, params.look_ahead);
+        return score_tally(run_strategy(entry, exit, prices, params.ma_period, prices.size() - params.look_ahead));
+    } catch (...) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+}
+
+template <typename T>
+BacktestResult backtest_arrays(Span<const T> prices, const StrategyParameters& params) {
+    return backtest_arrays(prices, params, BacktestWorkspace::for_thread());
+}
+
+template std::vector<size_t> entry_triggers<double>(Span<const double>, const StrategyParameters&);
+template std::vector<size_t> entry_triggers<float>(Span<const float>, const StrategyParameters&);
+template BacktestResult backtest_arrays<double>(Span<const double>, const StrategyParameters&);
+template BacktestResult backtest_arrays<float>(Span<const float>, const StrategyParameters&);
+template BacktestResult backtest_arrays<double>(Span<const double>, const StrategyParameters&, BacktestWorkspace&);
+template BacktestResult backtest_arrays<float>(Span<const float>, const StrategyParameters&, BacktestWorkspace&);
+
+BacktestResult backtest_detailed_f32(Span<const double> prices, const StrategyParameters& params,
+                                     IndicatorCache& cache) {
+    if (!has_enough_data(prices, params)) {
+        return {-1000.0, 0.0, 0, 0};
+    }
+
+    PROFILE_ZONE("Backtest");
+    try {
+        uint64_t series_id = cache.series_id(prices);
+        IndicatorCache::FloatSeries closes, sma, rsi;
+        IndicatorCache::FloatMACDPtr macd;
+        {
+            PROFILE_ZONE("Indicator Lookup");
+            closes = cache.prices_f32(prices, series_id);
+            sma = cache.sma_f32(prices, series_id, params.ma_period);
+            macd = cache.macd_f32(prices, series_id);
+            rsi = cache.rsi_f32(prices, series_id, params.rsi_period);
         }
-        
-        double win_rate = static_cast<double>(successes) / triggers;
-        double avg_return = total_return / triggers;
-        
-        result.fitness = win_rate * 100.0 + avg_return * 1000.0;
-        result.win_rate = win_rate * 100.0;
-        result.triggers = triggers;
-        result.successes = successes;
-        
-        return result;
-        
+        Span<const float> view(*closes);
+        auto entry = array_entry<float>(view, *sma, *macd, *rsi, params.rsi_threshold);
+        TakeProfitStopLoss<float> exit(params.stop_loss, params.take_profit, params.look_ahead);
+        return score_tally(run_strategy(entry, exit, view, params.ma_period, view.size() - params.look_ahead));
     } catch (...) {
-        return result;
+        return {-1000.0, 0.0, 0, 0};
     }
 }
 
+double cached_float_backtest_fitness(Span<const double> prices, const StrategyParameters& params,
+                                     IndicatorCache& cache) {
+    return backtest_detailed_f32(prices, params, cache).fitness;
+}
+
+CachedFitnessFunction backtest_fitness_for(Precision precision) {
+    if (precision == Precision::Float) return cached_float_backtest_fitness;
+    return cached_backtest_fitness;
+}
+
 // Original function for compatibility
-double backtest_fitness(const std::vector<double>& prices, const StrategyParameters& params) {
+double backtest_fitness(Span<const double> prices, const StrategyParameters& params) {
     return backtest_detailed(prices, params).fitness;
-}
\ No newline at end of file
+}
+
+double cached_backtest_fitness(Span<const double> prices, const StrategyParameters& params,
+                               IndicatorCache& cache) {
+    return backtest_detailed(prices, params, cache).fitness;
+}
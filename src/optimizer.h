@@ -4,6 +4,12 @@
 #include <vector>
 #include <functional>
 #include <random>
+#include <memory>
+#include "indicator_cache.h"
+#include "thread_pool.h"
+
+class FitnessMemo;
+struct BacktestWorkspace;
 
 struct StrategyParameters {
     int ma_period = 200;
@@ -18,15 +24,49 @@ struct StrategyParameters {
     static StrategyParameters crossover(const StrategyParameters& parent1, 
                                        const StrategyParameters& parent2, 
                                        std::mt19937& gen);
+    // Every field drawn uniformly from the GA's search ranges
+    static StrategyParameters random(std::mt19937& gen);
 };
 
+// Next generation from `population` ranked best-first by `ranked`: the top
+// `elite_count` survive unchanged and the rest are mutated crossovers of two
+// random elites. elite_count must be at least 1.
+std::vector<StrategyParameters> breed_generation(const std::vector<StrategyParameters>& population,
+                                                 const std::vector<size_t>& ranked, size_t elite_count,
+                                                 double mutation_rate, std::mt19937& gen);
+
 struct OptimizationResult {
     StrategyParameters best_params;
     double best_fitness;
     std::vector<double> fitness_history;
     int generations;
+    size_t bar_evaluations = 0;        // bars backtested across every fitness call
+    size_t full_bar_evaluations = 0;   // the same run without racing
+    size_t memo_hits = 0;              // evaluations answered by the fitness memo
+    size_t memo_lookups = 0;
+    std::vector<StrategyParameters> final_population;  // last generation, best first
 };
 
+// Successive halving inside each generation: everyone is scored on the first
+// rungs[0] of the series, the best keep_fraction advance to the next longer
+// prefix, and so on up to the full series. Only full-series scores are ranked
+// for selection; survivors never drop below the elite count. Prefixes are
+// views of the series (nothing is copied) but separate series to the fitness
+// function and the indicator cache.
+struct RacingOptions {
+    bool enabled = false;
+    std::vector<double> rungs = {0.25, 0.5, 1.0};  // fractions of the series; 1.0 is appended if missing
+    double keep_fraction = 0.5;
+    size_t min_bars = 500;                          // shortest prefix evaluated
+};
+
+using FitnessFunction =
+    std::function<double(Span<const double>, const StrategyParameters&)>;
+
+// Fitness function that may pull indicators from the run-wide cache
+using CachedFitnessFunction =
+    std::function<double(Span<const double>, const StrategyParameters&, IndicatorCache&)>;
+
 class GeneticOptimizer {
 private:
     size_t population_size;
@@ -34,26 +74,111 @@ private:
     double mutation_rate;
     double elite_ratio;
     std::mt19937 gen;
+    std::unique_ptr<ThreadPool> pool;
+    bool verbose = true;
+    RacingOptions racing;
+    FitnessMemo* memo = nullptr;
     
 public:
+    // All random draws come from `seed` on the calling thread, so a fixed
+    // seed reproduces the run for any `num_threads`. With more than one
+    // thread the fitness function must be safe to call concurrently.
     GeneticOptimizer(size_t pop_size = 50, int max_gen = 100, 
-                    double mut_rate = 0.1, double elite = 0.2);
+                    double mut_rate = 0.1, double elite = 0.2,
+                    unsigned int seed = std::random_device{}(), size_t num_threads = 1);
+
+    void set_verbose(bool enabled) { verbose = enabled; }
+    void set_racing(const RacingOptions& options) { racing = options; }
+    // Evaluations are answered from and recorded in `fitness_memo`. Up to half
+    // of the initial population is seeded from its saved population (the
+    // rest stays random for diversity) and the run's final ranked population
+    // is left in it for the next warm start. Results match an unmemoized run
+    // as long as the fitness function is deterministic.
+    void set_memo(FitnessMemo* fitness_memo) { memo = fitness_memo; }
     
-    OptimizationResult optimize(
-        const std::vector<double>& prices,
-        std::function<double(const std::vector<double>&, const StrategyParameters&)> fitness_func);
+    OptimizationResult optimize(Span<const double> prices, FitnessFunction fitness_func);
+
+    // Shares one IndicatorCache across every evaluation of the run
+    OptimizationResult optimize(Span<const double> prices, CachedFitnessFunction fitness_func);
+    OptimizationResult optimize(Span<const double> prices, CachedFitnessFunction fitness_func,
+                                IndicatorCache& cache);
 };
 
 // Fitness function for backtesting
-double backtest_fitness(const std::vector<double>& prices, const StrategyParameters& params);
+double backtest_fitness(Span<const double> prices, const StrategyParameters& params);
+double cached_backtest_fitness(Span<const double> prices, const StrategyParameters& params,
+                               IndicatorCache& cache);
 
 struct BacktestResult {
     double fitness;
     double win_rate;
     size_t triggers;
     size_t successes;
+    double total_return = 0.0;  // sum of per-trade returns (fraction of entry price)
 };
 
-BacktestResult backtest_detailed(const std::vector<double>& prices, const StrategyParameters& params);
+// Fitness from trade tallies: win rate (percent) plus 1000x the average
+// return per trade; -100 when there were no trades. `total_return` must be
+// accumulated in trade order for results to match backtest_detailed bit-for-bit.
+BacktestResult score_outcomes(size_t triggers, size_t successes, double total_return);
+
+// Both forms keep their scan and exit buffers in BacktestWorkspace::for_thread(),
+// so once a thread's workspace (and, cached, the indicators) are warm a call
+// makes no heap allocation. The cached form keys indicators on
+// cache.series_id(prices): hashed per call unless the caller registered the
+// series with the cache, as the optimizers do for the length of a run.
+BacktestResult backtest_detailed(Span<const double> prices, const StrategyParameters& params);
+BacktestResult backtest_detailed(Span<const double> prices, const StrategyParameters& params,
+                                 IndicatorCache& cache);
+
+// Cached backtest restricted to entries in [begin, end) whose look-ahead also
+// ends before `end`. Indicators are the full-series arrays from `cache`, so
+// bars before `begin` serve as warm-up exactly as they would in a live run.
+// `series_id` is series_fingerprint(prices), hoisted out by callers that run
+// many windows.
+BacktestResult backtest_window(Span<const double> prices, const StrategyParameters& params,
+                               IndicatorCache& cache, uint64_t series_id, size_t begin, size_t end);
+
+// Value type the backtest runs in. Float halves the memory traffic of the
+// indicator arrays; a few borderline triggers flip (see README).
+enum class Precision { Double, Float };
+
+// Entry indices from indicator arrays materialized in T (double and float are
+// instantiated). T = double gives exactly the triggers of backtest_detailed.
+template <typename T>
+std::vector<size_t> entry_triggers(Span<const T> prices, const StrategyParameters& params);
+
+// Array-path backtest with indicators and exit levels in T; T = double
+// matches backtest_detailed bit-for-bit. Indicators and triggers go into
+// `workspace` (the thread's own when omitted), which a caller keeps across
+// evaluations so steady-state calls do not allocate.
+template <typename T>
+BacktestResult backtest_arrays(Span<const T> prices, const StrategyParameters& params);
+template <typename T>
+BacktestResult backtest_arrays(Span<const T> prices, const StrategyParameters& params,
+                               BacktestWorkspace& workspace);
+
+// Float32 backtest of a double series: the float copy and its indicators come
+// from `cache`, so a GA converts the series once
+BacktestResult backtest_detailed_f32(Span<const double> prices, const StrategyParameters& params,
+                                     IndicatorCache& cache);
+double cached_float_backtest_fitness(Span<const double> prices, const StrategyParameters& params,
+                                     IndicatorCache& cache);
+
+// The optimizer's float mode: cached_backtest_fitness or cached_float_backtest_fitness
+CachedFitnessFunction backtest_fitness_for(Precision precision);
+
+// Bump whenever a change alters the fitness values the backtest returns, so
+// saved fitness memos from older builds are not reused
+constexpr uint32_t BACKTEST_FITNESS_VERSION = 1;
+
+// Identifies backtest_fitness_for(precision) at BACKTEST_FITNESS_VERSION
+constexpr uint64_t backtest_fitness_id(Precision precision) {
+    return (static_cast<uint64_t>(BACKTEST_FITNESS_VERSION) << 8) | static_cast<uint64_t>(precision);
+}
+
+// Fills `cache` with every indicator backtest_window reads for `params`
+void prefetch_indicators(Span<const double> prices, const StrategyParameters& params,
+                         IndicatorCache& cache, uint64_t series_id);
 
 #endif // OPTIMIZER_H
\ No newline at end of file
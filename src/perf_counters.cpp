@@ -0,0 +1,176 @@
+#include "perf_counters.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+CounterSample CounterSample::operator-(const CounterSample& other) const {
+    // Multiplex scaling can make a later estimate dip below an earlier one
+    auto diff = [](uint64_t a, uint64_t b) { return a > b ? a - b : 0; };
+    CounterSample d;
+    d.cycles = diff(cycles, other.cycles);
+    d.instructions = diff(instructions, other.instructions);
+    d.cache_misses = diff(cache_misses, other.cache_misses);
+    d.branch_misses = diff(branch_misses, other.branch_misses);
+    return d;
+}
+
+CounterSample& CounterSample::operator+=(const CounterSample& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+}
+
+#ifdef __linux__
+
+static int open_counter(uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;  // allowed at perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounters::PerfCounters() {
+    const uint64_t configs[4] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                 PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    std::fill(fds, fds + 4, -1);
+    for (int i = 0; i < 4; ++i) {
+        fds[i] = open_counter(configs[i]);
+        if (fds[i] < 0) {
+            int err = errno;
+            reason = std::string("perf_event_open: ") + std::strerror(err);
+            if (err == EACCES || err == EPERM) reason += " (see /proc/sys/kernel/perf_event_paranoid)";
+            if (err == ENOENT || err == EOPNOTSUPP) reason += " (no hardware PMU, e.g. VM or container)";
+            for (int j = 0; j < i; ++j) close(fds[j]);
+            std::fill(fds, fds + 4, -1);
+            return;
+        }
+    }
+    ok = true;
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+CounterSample PerfCounters::read() const {
+    CounterSample sample;
+    if (!ok) return sample;
+
+    uint64_t* fields[4] = {&sample.cycles, &sample.instructions, &sample.cache_misses, &sample.branch_misses};
+    for (int i = 0; i < 4; ++i) {
+        uint64_t values[3] = {0, 0, 0};  // value, time enabled, time running
+        if (::read(fds[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) continue;
+        if (values[2] == 0) continue;
+        // Estimate the full count when the PMU was shared with other events
+        double scale = static_cast<double>(values[1]) / values[2];
+        *fields[i] = static_cast<uint64_t>(values[0] * scale);
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() : reason("hardware counters require Linux perf_event_open") {
+    std::fill(fds, fds + 4, -1);
+}
+
+PerfCounters::~PerfCounters() {}
+
+CounterSample PerfCounters::read() const { return CounterSample(); }
+
+#endif
+
+double StageMetrics::ipc() const {
+    return counters.cycles > 0 ? static_cast<double>(counters.instructions) / counters.cycles : 0.0;
+}
+
+double StageMetrics::per_bar(uint64_t events) const {
+    return bars > 0 ? static_cast<double>(events) / bars : 0.0;
+}
+
+StageCounters::StageCounters(bool enable_counters) : use_counters(enable_counters) {}
+
+const StageMetrics* StageCounters::find(const std::string& name) const {
+    for (const auto& stage : stage_list) {
+        if (stage.name == name) return &stage;
+    }
+    return nullptr;
+}
+
+void StageCounters::add(const std::string& name, size_t bars, double seconds, const CounterSample& delta) {
+    auto it = std::find_if(stage_list.begin(), stage_list.end(),
+                           [&](const StageMetrics& s) { return s.name == name; });
+    if (it == stage_list.end()) {
+        stage_list.push_back(StageMetrics());
+        it = stage_list.end() - 1;
+        it->name = name;
+    }
+    it->runs += 1;
+    it->bars += bars;
+    it->seconds += seconds;
+    it->has_counters = counters_available();
+    it->counters += delta;
+}
+
+void StageCounters::print_report(std::ostream& out) const {
+    out << "\n🔬 Stage Counters";
+    if (!counters_available()) {
+        out << " (timing only: "
+            << (use_counters ? unavailable_reason() : std::string("counters disabled")) << ")";
+    }
+    out << "\n";
+
+    out << std::left << std::setw(12) << "Stage" << std::right << std::setw(10) << "Bars"
+        << std::setw(11) << "ms";
+    if (counters_available()) {
+        out << std::setw(8) << "IPC" << std::setw(13) << "Mcycles" << std::setw(14) << "cache-miss/bar"
+            << std::setw(15) << "branch-miss/bar";
+    }
+    out << "\n";
+
+    for (const auto& s : stage_list) {
+        out << std::left << std::setw(12) << s.name << std::right << std::setw(10) << s.bars
+            << std::setw(11) << std::fixed << std::setprecision(2) << s.seconds * 1000.0;
+        if (s.has_counters) {
+            out << std::setw(8) << std::setprecision(2) << s.ipc()
+                << std::setw(13) << std::setprecision(1) << s.counters.cycles / 1e6
+                << std::setw(14) << std::setprecision(3) << s.per_bar(s.counters.cache_misses)
+                << std::setw(15) << std::setprecision(3) << s.per_bar(s.counters.branch_misses);
+        }
+        out << "\n";
+    }
+}
+
+ScopedStage::ScopedStage(StageCounters* stage_recorder, std::string stage_name, size_t stage_bars)
+    : recorder(stage_recorder), name(std::move(stage_name)), bars(stage_bars) {
+    if (!recorder) return;
+    start_time = std::chrono::steady_clock::now();
+    if (recorder->counters_available()) start_counters = recorder->counters.read();
+}
+
+ScopedStage::~ScopedStage() {
+    if (!recorder) return;
+    CounterSample delta;
+    if (recorder->counters_available()) delta = recorder->counters.read() - start_counters;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    recorder->add(name, bars, seconds, delta);
+}
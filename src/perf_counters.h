@@ -0,0 +1,97 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Hardware counter readings (Linux perf_event_open), scaled for multiplexing
+struct CounterSample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+
+    CounterSample operator-(const CounterSample& other) const;
+    CounterSample& operator+=(const CounterSample& other);
+};
+
+// User-space counters for the calling thread and threads it spawns after
+// construction (their counts fold in when they exit). When the kernel refuses
+// (containers, perf_event_paranoid, non-Linux) available() is false and
+// read() returns zeros.
+class PerfCounters {
+private:
+    int fds[4];
+    bool ok = false;
+    std::string reason;
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return ok; }
+    const std::string& unavailable_reason() const { return reason; }
+    CounterSample read() const;
+};
+
+struct StageMetrics {
+    std::string name;
+    size_t runs = 0;
+    size_t bars = 0;
+    double seconds = 0.0;
+    bool has_counters = false;
+    CounterSample counters;
+
+    double ipc() const;
+    // Events per processed bar; 0 when the stage did not report bars
+    double per_bar(uint64_t events) const;
+};
+
+// Per-stage wall time plus counters. Use from one thread; repeated stages
+// with the same name accumulate.
+class StageCounters {
+private:
+    PerfCounters counters;
+    bool use_counters;
+    std::vector<StageMetrics> stage_list;
+
+    friend class ScopedStage;
+    void add(const std::string& name, size_t bars, double seconds, const CounterSample& delta);
+
+public:
+    explicit StageCounters(bool enable_counters = true);
+
+    bool counters_available() const { return use_counters && counters.available(); }
+    const std::string& unavailable_reason() const { return counters.unavailable_reason(); }
+    const std::vector<StageMetrics>& stages() const { return stage_list; }
+    const StageMetrics* find(const std::string& name) const;
+
+    void print_report(std::ostream& out) const;
+};
+
+// Measures one stage from construction to destruction. `recorder` may be
+// null, which makes the stage a no-op.
+class ScopedStage {
+private:
+    StageCounters* recorder;
+    std::string name;
+    size_t bars;
+    CounterSample start_counters;
+    std::chrono::steady_clock::time_point start_time;
+
+public:
+    ScopedStage(StageCounters* stage_recorder, std::string stage_name, size_t stage_bars = 0);
+    ~ScopedStage();
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+
+    // For stages whose bar count is only known once they finish (e.g. parse)
+    void set_bars(size_t stage_bars) { bars = stage_bars; }
+};
+
+#endif // PERF_COUNTERS_H
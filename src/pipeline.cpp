@@ -0,0 +1,369 @@
+#include "pipeline.h"
+#include "bounded_queue.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+namespace {
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// One symbol travelling down the pipeline; only one stage holds it at a time
+struct WorkItem {
+    size_t index = 0;
+    RawHistory raw;
+    LoadedHistory history;   // owns the bars (mapped or parsed)
+    Span<const double> closes;
+    std::unique_ptr<IndicatorCache> cache;
+    uint64_t series_id = 0;
+};
+
+using ItemPtr = std::unique_ptr<WorkItem>;
+using ItemQueue = BoundedQueue<ItemPtr>;
+using StageWork = std::function<void(WorkItem&, SymbolReport&)>;
+
+// Shared by the workers of one stage; the last worker out closes the output
+struct Stage {
+    const char* name;
+    size_t workers;
+    ItemQueue* input;
+    ItemQueue* output;   // null for the last stage
+    std::mutex mutex;
+    PipelineStageStats stats;
+    std::atomic<size_t> running{0};
+
+    Stage(const char* stage_name, size_t worker_count, ItemQueue* in, ItemQueue* out)
+        : name(stage_name), workers(std::max<size_t>(1, worker_count)), input(in), output(out) {
+        stats.name = name;
+        stats.workers = workers;
+        running = workers;
+    }
+};
+
+// Pops items until the input closes; an item whose work throws is recorded
+// as that symbol's error and goes no further
+void stage_worker(Stage& stage, BatchReport& report, const StageWork& work) {
+    PipelineStageStats local;
+    ItemPtr item;
+    while (true) {
+        auto wait_start = Clock::now();
+        if (!stage.input->pop(item)) {
+            local.idle_seconds += seconds_since(wait_start);
+            break;
+        }
+        local.idle_seconds += seconds_since(wait_start);
+
+        SymbolReport& symbol = report.symbols[item->index];
+        auto busy_start = Clock::now();
+        bool ok = true;
+        try {
+            ProfileZone zone(stage.name);
+            work(*item, symbol);
+        } catch (const std::exception& e) {
+            symbol.error = e.what();
+            ok = false;
+        }
+        double busy = seconds_since(busy_start);
+        local.busy_seconds += busy;
+        symbol.seconds += busy;
+
+        if (!ok) {
+            ++local.failures;
+            continue;
+        }
+        ++local.items;
+        local.bars += item->closes.size();
+        if (stage.output) {
+            auto push_start = Clock::now();
+            stage.output->push(std::move(item));
+            local.blocked_seconds += seconds_since(push_start);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(stage.mutex);
+    stage.stats.items += local.items;
+    stage.stats.failures += local.failures;
+    stage.stats.bars += local.bars;
+    stage.stats.busy_seconds += local.busy_seconds;
+    stage.stats.idle_seconds += local.idle_seconds;
+    stage.stats.blocked_seconds += local.blocked_seconds;
+    if (--stage.running == 0 && stage.output) stage.output->close();
+}
+
+StrategyParameters parse_strategy(const json& j, StrategyParameters params) {
+    params.ma_period = j.value("ma_period", params.ma_period);
+    params.rsi_period = j.value("rsi_period", params.rsi_period);
+    params.rsi_threshold = j.value("rsi_threshold", params.rsi_threshold);
+    params.stop_loss = j.value("stop_loss", params.stop_loss);
+    params.take_profit = j.value("take_profit", params.take_profit);
+    params.look_ahead = j.value("look_ahead", params.look_ahead);
+    return params;
+}
+
+json params_json(const StrategyParameters& p) {
+    return {{"ma_period", p.ma_period},     {"rsi_period", p.rsi_period},   {"rsi_threshold", p.rsi_threshold},
+            {"stop_loss", p.stop_loss},     {"take_profit", p.take_profit}, {"look_ahead", p.look_ahead}};
+}
+
+} // namespace
+
+PipelineJob parse_job(const std::string& json_text) {
+    PipelineJob job;
+    job.source = DataSourceConfig::from_env();
+    job.options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    try {
+        json j = json::parse(json_text);
+        if (j.contains("symbols")) {
+            job.symbols = j.at("symbols").get<std::vector<std::string>>();
+        } else if (j.contains("symbols_file")) {
+            job.symbols = read_symbol_list(j.at("symbols_file").get<std::string>());
+        }
+        if (j.contains("strategy")) {
+            job.options.params = parse_strategy(j.at("strategy"), job.options.params);
+        }
+        if (j.contains("optimize")) {
+            const json& opt = j.at("optimize");
+            if (opt.is_boolean()) {
+                job.options.optimize = opt.get<bool>();
+            } else {
+                job.options.optimize = opt.value("enabled", true);
+                job.options.population = opt.value("population", job.options.population);
+                job.options.generations = opt.value("generations", job.options.generations);
+                job.options.seed = opt.value("seed", job.options.seed);
+                job.options.threads = opt.value("threads", job.options.threads);
+                job.options.memo_dir = opt.value("memo_dir", job.options.memo_dir);
+                std::string precision = opt.value("precision", std::string("double"));
+                if (precision != "double" && precision != "float") {
+                    throw DataException("Unknown optimizer precision: " + precision);
+                }
+                job.options.precision = precision == "float" ? Precision::Float : Precision::Double;
+            }
+        }
+        if (j.contains("data")) {
+            const json& data = j.at("data");
+            job.source.store_dir = data.value("store_dir", job.source.store_dir);
+            job.source.response_cache_dir = data.value("response_cache_dir", job.source.response_cache_dir);
+            job.source.max_in_flight = data.value("max_in_flight", job.source.max_in_flight);
+        }
+        if (j.contains("pipeline")) {
+            const json& pipeline = j.at("pipeline");
+            job.queue_capacity = pipeline.value("queue_capacity", job.queue_capacity);
+            job.fetch_chunk = pipeline.value("fetch_chunk", job.fetch_chunk);
+        }
+        if (j.contains("output")) {
+            const json& output = j.at("output");
+            job.json_path = output.value("json", job.json_path);
+            job.csv_path = output.value("csv", job.csv_path);
+        }
+        job.options.min_bars = j.value("min_bars", job.options.min_bars);
+    } catch (const json::exception& e) {
+        throw DataException(std::string("Invalid job file: ") + e.what());
+    }
+
+    if (job.symbols.empty()) {
+        throw DataException("Job file lists no symbols");
+    }
+    if (job.options.population < 2 || job.options.generations < 1) {
+        throw DataException("Job file needs a population of at least 2 and at least one generation");
+    }
+    return job;
+}
+
+PipelineJob load_job_file(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw DataException("Cannot open job file: " + path);
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    return parse_job(text.str());
+}
+
+PipelineReport run_pipeline(const PipelineJob& job) {
+    PROFILE_ZONE("Pipeline");
+
+    PipelineReport result;
+    BatchReport& report = result.batch;
+    result.queue_capacity = std::max<size_t>(1, job.queue_capacity);
+    report.symbols.resize(job.symbols.size());
+    for (size_t i = 0; i < job.symbols.size(); ++i) report.symbols[i].symbol = job.symbols[i];
+    if (!job.options.memo_dir.empty()) {
+        std::filesystem::create_directories(job.options.memo_dir);
+    }
+
+    const BatchOptions& options = job.options;
+    const DataSourceConfig& source = job.source;
+    size_t queue_count = options.optimize ? 4 : 3;
+    std::vector<std::unique_ptr<ItemQueue>> queues;
+    for (size_t q = 0; q < queue_count; ++q) queues.push_back(std::make_unique<ItemQueue>(result.queue_capacity));
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    stages.push_back(std::make_unique<Stage>("Parse Stage", 1, queues[0].get(), queues[1].get()));
+    stages.push_back(std::make_unique<Stage>("Indicators Stage", 1, queues[1].get(), queues[2].get()));
+    stages.push_back(std::make_unique<Stage>("Backtest Stage", 1, queues[2].get(),
+                                             options.optimize ? queues[3].get() : nullptr));
+    if (options.optimize) {
+        stages.push_back(std::make_unique<Stage>("Optimize Stage", options.threads, queues[3].get(), nullptr));
+    }
+
+    std::vector<StageWork> work;
+    work.push_back([&](WorkItem& item, SymbolReport& symbol) {
+        item.history = materialize_history(std::move(item.raw), source);
+        item.closes = item.history.columns().close;
+        symbol.bars = item.closes.size();
+        if (symbol.bars < options.min_bars) {
+            throw DataException("Insufficient valid data points: " + std::to_string(symbol.bars) +
+                                " (need at least " + std::to_string(options.min_bars) + ")");
+        }
+    });
+    work.push_back([&](WorkItem& item, SymbolReport&) {
+        item.cache = std::make_unique<IndicatorCache>();
+        item.series_id = series_fingerprint(item.closes);
+        prefetch_indicators(item.closes, options.params, *item.cache, item.series_id);
+    });
+    work.push_back([&](WorkItem& item, SymbolReport& symbol) {
+        symbol.backtest = backtest_detailed(item.closes, options.params, *item.cache);
+    });
+    work.push_back([&](WorkItem& item, SymbolReport& symbol) {
+        optimize_symbol(item.closes, options, symbol, *item.cache);
+    });
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (size_t s = 0; s < stages.size(); ++s) {
+        for (size_t w = 0; w < stages[s]->workers; ++w) {
+            threads.emplace_back([&, s] { stage_worker(*stages[s], report, work[s]); });
+        }
+    }
+
+    // Fetch runs on the calling thread: one concurrent download round per
+    // chunk, handed downstream as soon as the round completes
+    PipelineStageStats fetch;
+    fetch.name = "Fetch Stage";
+    fetch.workers = 1;
+    size_t chunk = std::max<size_t>(1, job.fetch_chunk);
+    try {
+        for (size_t first = 0; first < job.symbols.size(); first += chunk) {
+            std::vector<std::string> batch(job.symbols.begin() + first,
+                                           job.symbols.begin() + std::min(first + chunk, job.symbols.size()));
+            auto busy_start = Clock::now();
+            std::vector<RawHistory> raws;
+            {
+                PROFILE_ZONE("Fetch Stage");
+                raws = fetch_histories(batch, source);
+            }
+            double busy = seconds_since(busy_start);
+            fetch.busy_seconds += busy;
+            for (size_t k = 0; k < raws.size(); ++k) {
+                auto item = std::make_unique<WorkItem>();
+                item->index = first + k;
+                item->raw = std::move(raws[k]);
+                report.symbols[item->index].seconds += busy / raws.size();
+                ++fetch.items;
+                auto push_start = Clock::now();
+                queues[0]->push(std::move(item));
+                fetch.blocked_seconds += seconds_since(push_start);
+            }
+        }
+    } catch (...) {
+        // Let the workers drain and exit before propagating
+        queues[0]->close();
+        for (auto& t : threads) t.join();
+        throw;
+    }
+    queues[0]->close();
+    for (auto& t : threads) t.join();
+    report.wall_seconds = seconds_since(start);
+
+    fetch.queue_high_water = queues[0]->high_water();
+    result.stages.push_back(fetch);
+    for (size_t s = 0; s < stages.size(); ++s) {
+        PipelineStageStats stats = stages[s]->stats;
+        if (stages[s]->output) stats.queue_high_water = stages[s]->output->high_water();
+        result.stages.push_back(stats);
+        report.compute_seconds += stats.busy_seconds;
+        report.threads += stats.workers;
+    }
+    report.fetch_seconds = fetch.busy_seconds;
+    report.threads += 1;
+    return result;
+}
+
+void write_pipeline_json(const PipelineReport& report, std::ostream& out) {
+    json symbols = json::array();
+    for (const SymbolReport& s : report.batch.symbols) {
+        json entry = {{"symbol", s.symbol}, {"bars", s.bars}, {"ok", s.ok()}, {"seconds", s.seconds}};
+        if (!s.ok()) {
+            entry["error"] = s.error;
+        } else {
+            entry["backtest"] = {{"triggers", s.backtest.triggers},
+                                 {"successes", s.backtest.successes},
+                                 {"win_rate", s.backtest.win_rate},
+                                 {"fitness", s.backtest.fitness}};
+        }
+        if (s.optimized) {
+            entry["optimized"] = {{"fitness", s.best_fitness},
+                                  {"params", params_json(s.best_params)},
+                                  {"memo_hits", s.memo_hits},
+                                  {"memo_lookups", s.memo_lookups}};
+        }
+        symbols.push_back(entry);
+    }
+
+    json stages = json::array();
+    for (const PipelineStageStats& st : report.stages) {
+        stages.push_back({{"name", st.name},
+                          {"workers", st.workers},
+                          {"items", st.items},
+                          {"failures", st.failures},
+                          {"bars", st.bars},
+                          {"busy_seconds", st.busy_seconds},
+                          {"idle_seconds", st.idle_seconds},
+                          {"blocked_seconds", st.blocked_seconds},
+                          {"queue_high_water", st.queue_high_water},
+                          {"items_per_second", st.items_per_second()},
+                          {"bars_per_second", st.bars_per_second()}});
+    }
+
+    json doc = {{"symbols", symbols},
+                {"stages", stages},
+                {"queue_capacity", report.queue_capacity},
+                {"succeeded", report.batch.succeeded()},
+                {"wall_seconds", report.batch.wall_seconds}};
+    out << doc.dump(2) << "\n";
+}
+
+void print_pipeline_stages(const PipelineReport& report, std::ostream& out) {
+    double wall = report.batch.wall_seconds > 0 ? report.batch.wall_seconds : 1e-9;
+
+    out << "\n🚰 Pipeline Stages (queue capacity " << report.queue_capacity << ")\n";
+    out << "  " << std::left << std::setw(18) << "Stage" << std::right << std::setw(8) << "Workers"
+        << std::setw(8) << "Items" << std::setw(7) << "Fail" << std::setw(10) << "Busy s" << std::setw(8)
+        << "Util%" << std::setw(10) << "Blocked s" << std::setw(14) << "Bars/s" << std::setw(7) << "Peak"
+        << "\n";
+    for (const PipelineStageStats& st : report.stages) {
+        double utilization = 100.0 * st.busy_seconds / (wall * std::max<size_t>(1, st.workers));
+        out << "  " << std::left << std::setw(18) << st.name << std::right << std::setw(8) << st.workers
+            << std::setw(8) << st.items << std::setw(7) << st.failures << std::fixed << std::setprecision(3)
+            << std::setw(10) << st.busy_seconds << std::setprecision(1) << std::setw(8) << utilization
+            << std::setprecision(3) << std::setw(10) << st.blocked_seconds << std::setprecision(0)
+            << std::setw(14) << st.bars_per_second() << std::setw(7) << st.queue_high_water << "\n";
+    }
+}
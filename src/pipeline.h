@@ -0,0 +1,66 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "batch_runner.h"
+#include "data_source.h"
+
+// Contents of a --job file (JSON), e.g.
+//   {"symbols": ["AAPL", "MSFT"],            or "symbols_file": "symbols.txt"
+//    "strategy": {"ma_period": 200, "rsi_threshold": 70.0, ...},
+//    "optimize": {"enabled": true, "population": 30, "generations": 50,
+//                 "seed": 42, "threads": 4, "memo_dir": "memos", "precision": "float"},
+//    "data": {"store_dir": "stores", "response_cache_dir": "cache", "max_in_flight": 8},
+//    "pipeline": {"queue_capacity": 4, "fetch_chunk": 8},
+//    "output": {"json": "results.json", "csv": "results.csv"},
+//    "min_bars": 250}
+// Every key is optional except the symbols; data settings default to the
+// environment (PRICE_STORE_DIR, RESPONSE_CACHE_DIR, API_KEY).
+struct PipelineJob {
+    std::vector<std::string> symbols;
+    DataSourceConfig source;
+    BatchOptions options;            // threads = optimize-stage workers
+    size_t queue_capacity = 4;       // symbols buffered between two stages
+    size_t fetch_chunk = 8;          // symbols per concurrent download round
+    std::string json_path;           // empty = not written
+    std::string csv_path;
+};
+
+PipelineJob parse_job(const std::string& json_text);
+PipelineJob load_job_file(const std::string& path);
+
+struct PipelineStageStats {
+    std::string name;
+    size_t workers = 0;
+    size_t items = 0;               // symbols that finished this stage
+    size_t failures = 0;            // symbols dropped here with an error
+    size_t bars = 0;
+    double busy_seconds = 0.0;      // summed over workers
+    double idle_seconds = 0.0;      // waiting for input
+    double blocked_seconds = 0.0;   // waiting for room downstream
+    size_t queue_high_water = 0;    // peak occupancy of the output queue
+
+    // Per busy worker-second, i.e. what one worker of this stage sustains
+    double items_per_second() const { return busy_seconds > 0.0 ? items / busy_seconds : 0.0; }
+    double bars_per_second() const { return busy_seconds > 0.0 ? bars / busy_seconds : 0.0; }
+};
+
+struct PipelineReport {
+    BatchReport batch;              // per-symbol results in job order
+    std::vector<PipelineStageStats> stages;
+    size_t queue_capacity = 0;
+};
+
+// Runs fetch -> parse -> indicators -> backtest (-> optimize) with each stage
+// on its own worker threads, connected by bounded queues, so downloads,
+// parsing and compute overlap. Downloads go out fetch_chunk symbols at a time.
+// Per-symbol results match run_batch; failures are recorded, not thrown.
+PipelineReport run_pipeline(const PipelineJob& job);
+
+void write_pipeline_json(const PipelineReport& report, std::ostream& out);
+void print_pipeline_stages(const PipelineReport& report, std::ostream& out);
+
+#endif // PIPELINE_H
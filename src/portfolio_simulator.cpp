@@ -0,0 +1,385 @@
+#include "portfolio_simulator.h"
+#include "strategy_engine.h"
+#include "streaming_indicators.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <utility>
+
+namespace {
+
+struct Position {
+    size_t symbol;
+    double shares;
+    double stop, take;
+    uint32_t serial;    // bumped when the slot is released
+    bool open;
+};
+
+// Queue entry pointing at a position slot; stale once the slot's serial moves
+struct LevelRef {
+    double level;
+    uint32_t slot;
+    uint32_t serial;
+};
+
+struct ExpiryRef {
+    size_t bar;
+    uint32_t slot;
+    uint32_t serial;
+};
+
+// Binary heap of level references with lazy deletion. Closed positions are
+// dropped when they surface, or all at once by compact().
+template <typename Compare>
+class LevelHeap {
+private:
+    std::vector<LevelRef> heap;
+
+public:
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    const LevelRef& top() const { return heap.front(); }
+
+    void push(const LevelRef& ref) {
+        heap.push_back(ref);
+        std::push_heap(heap.begin(), heap.end(), Compare());
+    }
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), Compare());
+        heap.pop_back();
+    }
+    template <typename IsLive>
+    void compact(IsLive is_live) {
+        heap.erase(std::remove_if(heap.begin(), heap.end(), [&](const LevelRef& r) { return !is_live(r); }),
+                   heap.end());
+        std::make_heap(heap.begin(), heap.end(), Compare());
+    }
+};
+
+struct HighestFirst {
+    bool operator()(const LevelRef& a, const LevelRef& b) const { return a.level < b.level; }
+};
+struct LowestFirst {
+    bool operator()(const LevelRef& a, const LevelRef& b) const { return a.level > b.level; }
+};
+
+// Min-heap of (date, symbol) bar events. Each step advances the symbol on
+// top to its next bar, so replace_top sifts once instead of a pop and a push.
+class EventQueue {
+public:
+    using Event = std::pair<int64_t, size_t>;
+
+private:
+    std::vector<Event> heap;
+
+public:
+    bool empty() const { return heap.empty(); }
+    const Event& top() const { return heap.front(); }
+
+    void push(const Event& event) {
+        heap.push_back(event);
+        std::push_heap(heap.begin(), heap.end(), std::greater<Event>());
+    }
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Event>());
+        heap.pop_back();
+    }
+    void replace_top(const Event& event) {
+        size_t n = heap.size(), i = 0;
+        while (true) {
+            size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && heap[child + 1] < heap[child]) ++child;
+            if (!(heap[child] < event)) break;
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = event;
+    }
+};
+
+// Per-symbol state; the entry condition refers to sma_window, so books are
+// heap-allocated and never move
+struct SymbolBook {
+    PriceColumns series;
+    StreamingSMA sma_window{1};
+    AllOf<CloseAboveSMA, MACDBullishCross, RSIBelow> entry;
+    LevelHeap<HighestFirst> stops;   // nearest stop below the price on top
+    LevelHeap<LowestFirst> takes;    // nearest take above the price on top
+    std::deque<ExpiryRef> expiries;  // entry order is expiry order
+    size_t next_bar = 0;
+    size_t live = 0;
+    double shares = 0.0;
+    double last_close = 0.0;
+
+    SymbolBook(const PriceColumns& prices, const StrategyParameters& params)
+        : series(prices),
+          entry(CloseAboveSMA(sma_window, params.ma_period), MACDBullishCross(),
+                RSIBelow(params.rsi_period, params.rsi_threshold)) {}
+};
+
+class Simulator {
+private:
+    const PortfolioOptions& options;
+    std::vector<std::unique_ptr<SymbolBook>> books;
+    std::vector<Position> positions;
+    std::vector<uint32_t> free_slots;
+    double cash;
+    double market_value = 0.0;   // open shares at each symbol's last close
+    size_t open_count = 0;
+    PortfolioReport& report;
+
+    bool is_live(uint32_t slot, uint32_t serial) const {
+        const Position& p = positions[slot];
+        return p.open && p.serial == serial;
+    }
+
+    void close_position(uint32_t slot, double fill, ExitReason reason) {
+        Position& p = positions[slot];
+        SymbolBook& book = *books[p.symbol];
+        cash += p.shares * fill * (1.0 - options.commission);
+        market_value -= p.shares * book.last_close;
+        book.shares -= p.shares;
+        --book.live;
+        --open_count;
+        ++report.trades;
+        if (reason == ExitReason::TakeProfit) ++report.take_profits;
+        else if (reason == ExitReason::StopLoss) ++report.stop_losses;
+        else ++report.expired;
+        p.open = false;
+        ++p.serial;
+        free_slots.push_back(slot);
+    }
+
+    // Closes every position whose level `reached` says was crossed, filling
+    // at fill(level); stale entries on top are discarded on the way
+    template <typename Heap, typename Reached, typename Fill>
+    void drain(Heap& heap, Reached reached, Fill fill, ExitReason reason) {
+        while (!heap.empty()) {
+            const LevelRef top = heap.top();
+            if (!is_live(top.slot, top.serial)) {
+                heap.pop();
+            } else if (reached(top.level)) {
+                heap.pop();
+                close_position(top.slot, fill(top.level), reason);
+            } else {
+                break;
+            }
+        }
+    }
+
+    void check_exits(SymbolBook& book, double open, double high, double low) {
+        auto at_open = [open](double) { return open; };
+        auto at_level = [](double level) { return level; };
+        // Gaps through a level fill at the open, whichever side it is
+        drain(book.takes, [open](double take) { return open >= take; }, at_open, ExitReason::TakeProfit);
+        drain(book.stops, [open](double stop) { return open <= stop; }, at_open, ExitReason::StopLoss);
+
+        auto stops = [&] {
+            drain(book.stops, [low](double stop) { return low <= stop; }, at_level, ExitReason::StopLoss);
+        };
+        auto takes = [&] {
+            drain(book.takes, [high](double take) { return high >= take; }, at_level, ExitReason::TakeProfit);
+        };
+        if (options.intrabar == IntrabarOrder::StopFirst) {
+            stops();
+            takes();
+        } else {
+            takes();
+            stops();
+        }
+    }
+
+    void open_position(size_t symbol, SymbolBook& book, size_t bar, double close) {
+        double notional = (cash + market_value) * options.position_fraction;
+        double cost = notional * (1.0 + options.commission);
+        if (open_count >= options.max_positions || notional <= 0.0 || cost > cash) {
+            ++report.skipped_entries;
+            return;
+        }
+
+        uint32_t slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(positions.size());
+            positions.push_back(Position{0, 0.0, 0.0, 0.0, 0, false});
+        }
+        const StrategyParameters& params = options.params;
+        Position& p = positions[slot];
+        p.symbol = symbol;
+        p.shares = notional / close;
+        p.stop = close * (1.0 - params.stop_loss);
+        p.take = close * (1.0 + params.take_profit);
+        p.open = true;
+
+        cash -= cost;
+        market_value += p.shares * close;
+        book.shares += p.shares;
+        ++book.live;
+        ++open_count;
+        report.max_open_positions = std::max(report.max_open_positions, open_count);
+
+        book.stops.push({p.stop, slot, p.serial});
+        book.takes.push({p.take, slot, p.serial});
+        book.expiries.push_back({bar + static_cast<size_t>(std::max(params.look_ahead, 0)), slot, p.serial});
+    }
+
+    void on_bar(size_t symbol) {
+        SymbolBook& book = *books[symbol];
+        const PriceColumns& s = book.series;
+        size_t i = book.next_bar++;
+        double close = s.close[i];
+
+        if (book.live > 0) check_exits(book, s.open[i], s.high[i], s.low[i]);
+
+        market_value += book.shares * (close - book.last_close);
+        book.last_close = close;
+
+        while (!book.expiries.empty() && book.expiries.front().bar <= i) {
+            ExpiryRef e = book.expiries.front();
+            book.expiries.pop_front();
+            if (is_live(e.slot, e.serial)) close_position(e.slot, close, ExitReason::Expired);
+        }
+
+        bool fire = book.entry.update(i, close);
+        if (fire && i >= static_cast<size_t>(std::max(options.params.ma_period, 1))) {
+            open_position(symbol, book, i, close);
+        }
+
+        // Keep lazily deleted entries from outgrowing the open positions
+        if (book.stops.size() > 2 * book.live + 64 || book.takes.size() > 2 * book.live + 64) {
+            auto live = [this](const LevelRef& r) { return is_live(r.slot, r.serial); };
+            book.stops.compact(live);
+            book.takes.compact(live);
+        }
+        ++report.bar_events;
+    }
+
+public:
+    Simulator(const std::vector<PriceColumns>& universe, const PortfolioOptions& opts, PortfolioReport& out)
+        : options(opts), cash(opts.initial_capital), report(out) {
+        for (const PriceColumns& series : universe) {
+            size_t n = series.close.size();
+            if (series.dates.size() != n || series.open.size() != n || series.high.size() != n ||
+                series.low.size() != n) {
+                throw DataException("Price series columns have mismatched lengths: " + series.symbol);
+            }
+            books.push_back(std::make_unique<SymbolBook>(series, opts.params));
+        }
+    }
+
+    void run() {
+        // Event queue: the next unprocessed bar of every symbol, earliest
+        // date first, ties in universe order
+        EventQueue events;
+        for (size_t k = 0; k < books.size(); ++k) {
+            if (books[k]->series.size() > 0) events.push({books[k]->series.dates[0], k});
+        }
+
+        while (!events.empty()) {
+            auto [date, symbol] = events.top();
+            on_bar(symbol);
+            SymbolBook& book = *books[symbol];
+            if (book.next_bar < book.series.size()) {
+                events.replace_top({book.series.dates[book.next_bar], symbol});
+            } else {
+                events.pop();
+            }
+            if (events.empty() || events.top().first != date) {
+                report.equity.push_back({date, cash + market_value});
+            }
+        }
+
+        // Liquidate at each symbol's last close
+        for (uint32_t slot = 0; slot < positions.size(); ++slot) {
+            if (positions[slot].open) {
+                close_position(slot, books[positions[slot].symbol]->last_close, ExitReason::Expired);
+            }
+        }
+        market_value = 0.0;
+        if (!report.equity.empty()) report.equity.back().equity = cash;
+        report.final_equity = cash;
+    }
+};
+
+void summarize_equity(PortfolioReport& report, double periods_per_year) {
+    double peak = report.initial_capital;
+    for (const EquityPoint& point : report.equity) {
+        peak = std::max(peak, point.equity);
+        if (peak > 0.0) report.max_drawdown = std::max(report.max_drawdown, 1.0 - point.equity / peak);
+    }
+
+    // A step from zero or negative equity has no defined return; skip it
+    double sum = 0.0, sum_sq = 0.0, steps = 0.0;
+    for (size_t k = 1; k < report.equity.size(); ++k) {
+        double prev = report.equity[k - 1].equity;
+        if (!(prev > 0.0)) continue;
+        double r = report.equity[k].equity / prev - 1.0;
+        sum += r;
+        sum_sq += r * r;
+        steps += 1.0;
+    }
+    if (steps < 2.0) return;
+    double mean = sum / steps;
+    double variance = (sum_sq - steps * mean * mean) / (steps - 1.0);
+    if (variance > 0.0) report.sharpe = mean / std::sqrt(variance) * std::sqrt(periods_per_year);
+}
+
+} // namespace
+
+PortfolioReport simulate_portfolio(const std::vector<PriceColumns>& universe, const PortfolioOptions& options) {
+    PROFILE_ZONE("Portfolio Simulation");
+    auto start = std::chrono::steady_clock::now();
+
+    PortfolioReport report;
+    report.initial_capital = options.initial_capital;
+    report.final_equity = options.initial_capital;
+    Simulator simulator(universe, options, report);
+    simulator.run();
+
+    if (report.initial_capital > 0.0) report.total_return = report.final_equity / report.initial_capital - 1.0;
+    summarize_equity(report, options.periods_per_year);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+PortfolioReport simulate_portfolio(const std::vector<const PriceSeries*>& universe, const PortfolioOptions& options) {
+    std::vector<PriceColumns> columns;
+    columns.reserve(universe.size());
+    for (const PriceSeries* series : universe) columns.emplace_back(*series);
+    return simulate_portfolio(columns, options);
+}
+
+void print_portfolio_report(const PortfolioReport& report, std::ostream& out) {
+    double seconds = report.seconds > 0 ? report.seconds : 1e-9;
+    out << "\n💼 Portfolio Simulation\n";
+    out << "  Bar events : " << report.bar_events << "\n";
+    out << "  Trades     : " << report.trades << " (" << report.take_profits << " take-profit, "
+        << report.stop_losses << " stop-loss, " << report.expired << " expired)\n";
+    out << "  Max open   : " << report.max_open_positions << " positions\n";
+    out << "  Skipped    : " << report.skipped_entries << " signals\n";
+    out << std::fixed << std::setprecision(2);
+    out << "  Equity     : $" << report.initial_capital << " -> $" << report.final_equity << " ("
+        << report.total_return * 100.0 << "%)\n";
+    out << "  Max DD     : " << report.max_drawdown * 100.0 << "%\n";
+    out << "  Sharpe     : " << report.sharpe << "\n";
+    out << std::setprecision(1);
+    out << "  Throughput : " << report.bar_events / seconds / 1e6 << "M bar-events/s\n";
+}
+
+void write_equity_csv(const PortfolioReport& report, std::ostream& out) {
+    out << "date,equity\n";
+    out << std::fixed << std::setprecision(2);
+    for (const EquityPoint& point : report.equity) {
+        out << point.date << "," << point.equity << "\n";
+    }
+}
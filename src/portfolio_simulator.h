@@ -0,0 +1,64 @@
+#ifndef PORTFOLIO_SIMULATOR_H
+#define PORTFOLIO_SIMULATOR_H
+
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include "optimizer.h"
+#include "price_store.h"
+
+// Which level fills first when one bar's range covers both the stop and the
+// take-profit of a position and the open reached neither
+enum class IntrabarOrder { StopFirst, TakeFirst };
+
+struct PortfolioOptions {
+    StrategyParameters params;        // entry rule and stop/take/look-ahead on every symbol
+    double initial_capital = 100000.0;
+    double position_fraction = 0.02;  // of current equity per new position
+    size_t max_positions = 10000;     // open at once, across all symbols
+    double commission = 0.0005;       // fraction of notional, each side
+    IntrabarOrder intrabar = IntrabarOrder::StopFirst;
+    double periods_per_year = 252.0;  // equity-curve steps per year, for Sharpe
+};
+
+struct EquityPoint {
+    int64_t date;
+    double equity;
+};
+
+struct PortfolioReport {
+    std::vector<EquityPoint> equity;   // one point per distinct timestamp
+    double initial_capital = 0.0;
+    double final_equity = 0.0;
+    double total_return = 0.0;         // final / initial - 1
+    double max_drawdown = 0.0;         // largest peak-to-trough fall, fraction of peak
+    double sharpe = 0.0;               // annualized, from per-step equity returns
+    size_t trades = 0;                 // closed positions
+    size_t take_profits = 0;
+    size_t stop_losses = 0;
+    size_t expired = 0;                // closed at look_ahead or at the end of data
+    size_t skipped_entries = 0;        // signals without cash or a free position slot
+    size_t max_open_positions = 0;
+    size_t bar_events = 0;
+    double seconds = 0.0;
+};
+
+// Event-driven long-only simulation over OHLCV bars. Bars of every symbol are
+// merged into one stream by date. Each signal opens a position at that bar's
+// close, sized from current equity, and any number may overlap per symbol.
+// Open positions sit in per-symbol priority queues keyed by stop and take
+// price, so each bar checks its low and high against only the nearest
+// levels: a gap through a level fills at the open, otherwise at the level.
+// Positions still open after look_ahead bars close at that bar's close, and
+// everything left is closed at the last close. Throws DataException for
+// series with mismatched column lengths. Columns are read in place, so a
+// universe of mapped stores is simulated without copying.
+PortfolioReport simulate_portfolio(const std::vector<PriceColumns>& universe, const PortfolioOptions& options);
+PortfolioReport simulate_portfolio(const std::vector<const PriceSeries*>& universe, const PortfolioOptions& options);
+
+void print_portfolio_report(const PortfolioReport& report, std::ostream& out);
+// date,equity rows of the equity curve
+void write_equity_csv(const PortfolioReport& report, std::ostream& out);
+
+#endif // PORTFOLIO_SIMULATOR_H
@@ -0,0 +1,344 @@
+#include "price_parser.h"
+#include "exceptions.h"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+
+using json = nlohmann::json;
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm)
+static int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+int64_t parse_date_to_epoch(const std::string& date) {
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    int fields = std::sscanf(date.c_str(), "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    if (fields < 3 || month < 1 || month > 12 || day < 1 || day > 31) {
+        throw DataException("Invalid date: " + date);
+    }
+    return days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+// Numeric field lookup; NaN when absent or null
+static double field_or_nan(const json& record, const char* key) {
+    auto it = record.find(key);
+    if (it == record.end() || !it->is_number()) return std::numeric_limits<double>::quiet_NaN();
+    return it->get<double>();
+}
+
+// Close price: numbers as-is, booleans as 1 or 0; anything else is an error
+static double close_value(const json& value) {
+    if (value.is_boolean()) return value.get<bool>() ? 1.0 : 0.0;
+    if (!value.is_number()) {
+        throw DataException("Non-numeric close price in historical record");
+    }
+    return value.get<double>();
+}
+
+ParsedHistory parse_price_history_dom(const std::string& json_text, const std::string& symbol) {
+    json j;
+    try {
+        j = json::parse(json_text);
+    } catch (json::parse_error& e) {
+        throw DataException("JSON parse error: " + std::string(e.what()));
+    }
+
+    if (!j.contains("historical") || !j["historical"].is_array()) {
+        throw DataException("JSON does not contain valid 'historical' array");
+    }
+
+    const json& historical = j["historical"];
+    if (historical.empty()) {
+        throw DataException("Historical data is empty");
+    }
+
+    ParsedHistory parsed{};
+    parsed.series.symbol = symbol;
+    parsed.total_records = historical.size();
+
+    // API returns newest first; store oldest to newest
+    PriceSeries& s = parsed.series;
+    for (auto it = historical.rbegin(); it != historical.rend(); ++it) {
+        double close;
+        if (it->contains("close") && !(*it)["close"].is_null()) {
+            close = close_value((*it)["close"]);
+        } else if (it->contains("Close") && !(*it)["Close"].is_null()) {
+            close = close_value((*it)["Close"]);
+        } else {
+            parsed.skipped_records++;
+            continue;
+        }
+
+        double open = field_or_nan(*it, "open");
+        double high = field_or_nan(*it, "high");
+        double low = field_or_nan(*it, "low");
+        double volume = field_or_nan(*it, "volume");
+
+        auto date = it->find("date");
+        s.dates.push_back(date != it->end() && date->is_string() ? parse_date_to_epoch(*date) : 0);
+        s.open.push_back(std::isnan(open) ? close : open);
+        s.high.push_back(std::isnan(high) ? close : high);
+        s.low.push_back(std::isnan(low) ? close : low);
+        s.close.push_back(close);
+        s.volume.push_back(std::isnan(volume) ? 0.0 : volume);
+    }
+
+    return parsed;
+}
+
+// SAX handler that writes historical records straight into PriceSeries
+// columns without building a DOM. Mirrors parse_price_history_dom.
+class HistoricalSaxHandler : public nlohmann::json_sax<json> {
+private:
+    enum class Field { None, Date, Open, High, Low, Close, CloseUpper, Volume };
+
+    struct Record {
+        int64_t date;
+        double open, high, low, close, close_upper, volume;
+        bool has_close, has_close_upper;
+        bool close_upper_invalid;   // "Close" held a string or container
+    };
+
+    ParsedHistory& parsed;
+    int depth = 0;
+    int historical_depth = -1;   // depth of the historical array once entered
+    bool expect_historical = false;
+    bool found_historical = false;
+    bool historical_is_array = false;
+    Field field = Field::None;
+    Record record{};
+
+    bool at_record() const { return historical_depth >= 0 && depth == historical_depth + 1; }
+    bool at_element() const { return historical_depth >= 0 && depth == historical_depth; }
+
+    static double nan() { return std::numeric_limits<double>::quiet_NaN(); }
+
+    // A scalar or container appeared where the "historical" value belongs
+    void take_historical_value(bool is_array) {
+        if (!expect_historical) return;
+        expect_historical = false;
+        found_historical = true;
+        historical_is_array = is_array;
+    }
+
+    void count_scalar_element() {
+        if (at_element()) {
+            parsed.total_records++;
+            parsed.skipped_records++;
+        }
+    }
+
+    bool on_number(double value) {
+        take_historical_value(false);
+        count_scalar_element();
+        if (!at_record()) return true;
+        switch (field) {
+            case Field::Open: record.open = value; break;
+            case Field::High: record.high = value; break;
+            case Field::Low: record.low = value; break;
+            case Field::Volume: record.volume = value; break;
+            case Field::Close: record.close = value; record.has_close = true; break;
+            case Field::CloseUpper:
+                record.close_upper = value;
+                record.has_close_upper = true;
+                record.close_upper_invalid = false;
+                break;
+            default: break;
+        }
+        field = Field::None;
+        return true;
+    }
+
+    void commit_record() {
+        double close;
+        if (record.has_close) {
+            close = record.close;
+        } else if (record.close_upper_invalid) {
+            throw DataException("Non-numeric close price in historical record");
+        } else if (record.has_close_upper) {
+            close = record.close_upper;
+        } else {
+            parsed.skipped_records++;
+            return;
+        }
+
+        PriceSeries& s = parsed.series;
+        s.dates.push_back(record.date);
+        s.open.push_back(std::isnan(record.open) ? close : record.open);
+        s.high.push_back(std::isnan(record.high) ? close : record.high);
+        s.low.push_back(std::isnan(record.low) ? close : record.low);
+        s.close.push_back(close);
+        s.volume.push_back(std::isnan(record.volume) ? 0.0 : record.volume);
+    }
+
+public:
+    explicit HistoricalSaxHandler(ParsedHistory& out) : parsed(out) {}
+
+    bool valid() const { return found_historical && historical_is_array; }
+
+    bool null() override {
+        take_historical_value(false);
+        count_scalar_element();
+        if (at_record()) {
+            // A null close falls through to "Close", as in the DOM path
+            if (field == Field::Close) record.has_close = false;
+            if (field == Field::CloseUpper) record.has_close_upper = record.close_upper_invalid = false;
+            field = Field::None;
+        }
+        return true;
+    }
+
+    // A boolean close counts as 1 or 0, as in the DOM path; other boolean
+    // fields are ignored like any non-number
+    bool boolean(bool value) override {
+        take_historical_value(false);
+        count_scalar_element();
+        if (at_record() && (field == Field::Close || field == Field::CloseUpper)) {
+            return on_number(value ? 1.0 : 0.0);
+        }
+        field = Field::None;
+        return true;
+    }
+
+    // The DOM path only reads "Close" when "close" is missing or null, so a
+    // bad "Close" is held until the record ends and "close" is known
+    void reject_non_numeric_close() {
+        if (!at_record()) return;
+        if (field == Field::Close) {
+            throw DataException("Non-numeric close price in historical record");
+        }
+        if (field == Field::CloseUpper) {
+            record.has_close_upper = false;
+            record.close_upper_invalid = true;
+        }
+    }
+
+    bool number_integer(number_integer_t value) override { return on_number(static_cast<double>(value)); }
+    bool number_unsigned(number_unsigned_t value) override { return on_number(static_cast<double>(value)); }
+    bool number_float(number_float_t value, const string_t&) override { return on_number(value); }
+
+    bool string(string_t& value) override {
+        take_historical_value(false);
+        count_scalar_element();
+        if (at_record()) {
+            if (field == Field::Date) {
+                record.date = parse_date_to_epoch(value);
+            } else {
+                reject_non_numeric_close();
+            }
+            field = Field::None;
+        }
+        return true;
+    }
+
+    bool binary(binary_t&) override {
+        take_historical_value(false);
+        count_scalar_element();
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        take_historical_value(false);
+        reject_non_numeric_close();
+        ++depth;
+        if (at_record()) {
+            parsed.total_records++;
+            record = Record{0, nan(), nan(), nan(), nan(), nan(), nan(), false, false, false};
+            field = Field::None;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (at_record()) commit_record();
+        --depth;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (expect_historical) {
+            take_historical_value(true);
+            ++depth;
+            historical_depth = depth;
+            return true;
+        }
+        if (at_element()) {
+            parsed.total_records++;
+            parsed.skipped_records++;
+        }
+        reject_non_numeric_close();
+        ++depth;
+        return true;
+    }
+
+    bool end_array() override {
+        if (depth == historical_depth) historical_depth = -1;
+        --depth;
+        return true;
+    }
+
+    bool key(string_t& name) override {
+        if (depth == 1) {
+            expect_historical = name == "historical";
+            return true;
+        }
+        if (!at_record()) return true;
+        if (name == "close") field = Field::Close;
+        else if (name == "Close") field = Field::CloseUpper;
+        else if (name == "date") field = Field::Date;
+        else if (name == "open") field = Field::Open;
+        else if (name == "high") field = Field::High;
+        else if (name == "low") field = Field::Low;
+        else if (name == "volume") field = Field::Volume;
+        else field = Field::None;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        throw DataException("JSON parse error: " + std::string(e.what()));
+    }
+};
+
+ParsedHistory parse_price_history(const std::string& json_text, const std::string& symbol) {
+    ParsedHistory parsed{};
+    parsed.series.symbol = symbol;
+
+    // Every record is an object, so the '{' count bounds the record count
+    size_t capacity = static_cast<size_t>(std::count(json_text.begin(), json_text.end(), '{'));
+    PriceSeries& s = parsed.series;
+    s.dates.reserve(capacity);
+    s.open.reserve(capacity);
+    s.high.reserve(capacity);
+    s.low.reserve(capacity);
+    s.close.reserve(capacity);
+    s.volume.reserve(capacity);
+
+    HistoricalSaxHandler handler(parsed);
+    json::sax_parse(json_text, &handler);
+
+    if (!handler.valid()) {
+        throw DataException("JSON does not contain valid 'historical' array");
+    }
+    if (parsed.total_records == 0) {
+        throw DataException("Historical data is empty");
+    }
+
+    // API returns newest first; store oldest to newest
+    std::reverse(s.dates.begin(), s.dates.end());
+    std::reverse(s.open.begin(), s.open.end());
+    std::reverse(s.high.begin(), s.high.end());
+    std::reverse(s.low.begin(), s.low.end());
+    std::reverse(s.close.begin(), s.close.end());
+    std::reverse(s.volume.begin(), s.volume.end());
+
+    return parsed;
+}
@@ -0,0 +1,26 @@
+#ifndef PRICE_PARSER_H
+#define PRICE_PARSER_H
+
+#include <string>
+#include "price_store.h"
+
+struct ParsedHistory {
+    PriceSeries series;
+    size_t total_records;
+    size_t skipped_records;  // records without a usable close price
+};
+
+// Parses a financialmodelingprep historical-price-full response into
+// oldest-first columns. Records without "close"/"Close" are skipped; missing
+// open/high/low fall back to the close and missing volume to zero.
+// Streams the text through a SAX handler into preallocated columns, so peak
+// memory is the payload plus the output columns.
+ParsedHistory parse_price_history(const std::string& json_text, const std::string& symbol);
+
+// Same result built via an nlohmann::json DOM; kept as the reference path
+ParsedHistory parse_price_history_dom(const std::string& json_text, const std::string& symbol);
+
+// "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS" (UTC) to Unix seconds
+int64_t parse_date_to_epoch(const std::string& date);
+
+#endif // PRICE_PARSER_H
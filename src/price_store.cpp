@@ -0,0 +1,237 @@
+#include "price_store.h"
+#include "exceptions.h"
+#include "atomic_file.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char PRICE_STORE_MAGIC[4] = {'A', 'T', 'P', 'S'};
+static const uint32_t PRICE_STORE_VERSION = 1;
+static const size_t COLUMN_ALIGNMENT = 64;
+
+static size_t align_up(size_t offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+
+// Magic, version and every column inside a file of `file_size` bytes. The
+// bounds are checked by division so a hostile count or offset cannot wrap.
+static bool valid_header(const PriceStoreHeader& header, size_t file_size) {
+    bool valid = std::memcmp(header.magic, PRICE_STORE_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.version == PRICE_STORE_VERSION;
+    for (size_t c = 0; valid && c < 6; ++c) {
+        uint64_t offset = header.column_offset[c];
+        valid = offset % 8 == 0 && offset <= file_size && header.count <= (file_size - offset) / 8;
+    }
+    return valid;
+}
+
+void write_price_store(const std::string& path, const PriceSeries& series) {
+    const size_t count = series.size();
+    if (series.dates.size() != count || series.open.size() != count || series.high.size() != count ||
+        series.low.size() != count || series.volume.size() != count) {
+        throw DataException("Price series columns have mismatched lengths");
+    }
+    if (series.symbol.size() >= sizeof(PriceStoreHeader::symbol)) {
+        throw DataException("Symbol too long for a price store: " + series.symbol);
+    }
+
+    PriceStoreHeader header{};
+    std::memcpy(header.magic, PRICE_STORE_MAGIC, sizeof(header.magic));
+    header.version = PRICE_STORE_VERSION;
+    std::strncpy(header.symbol, series.symbol.c_str(), sizeof(header.symbol) - 1);
+    header.count = count;
+
+    size_t offset = sizeof(PriceStoreHeader);
+    for (size_t c = 0; c < 6; ++c) {
+        offset = align_up(offset);
+        header.column_offset[c] = offset;
+        offset += count * 8;
+    }
+
+    const std::string tmp_path = unique_temp_path(path);
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw DataException("Cannot open price store for writing: " + tmp_path);
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        const void* columns[6] = {series.dates.data(), series.open.data(), series.high.data(),
+                                  series.low.data(), series.close.data(), series.volume.data()};
+        size_t written = sizeof(header);
+        for (size_t c = 0; c < 6; ++c) {
+            static const char padding[COLUMN_ALIGNMENT] = {};
+            out.write(padding, header.column_offset[c] - written);
+            out.write(static_cast<const char*>(columns[c]), count * 8);
+            written = header.column_offset[c] + count * 8;
+        }
+        if (!out) {
+            throw DataException("Failed writing price store: " + tmp_path);
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw DataException("Cannot move price store into place: " + path);
+    }
+}
+
+MappedPriceStore::MappedPriceStore(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw DataException("Cannot open price store: " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PriceStoreHeader)) {
+        ::close(fd);
+        throw DataException("Price store is truncated: " + path);
+    }
+
+    mapping_size = static_cast<size_t>(st.st_size);
+    mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw DataException("Cannot map price store: " + path);
+    }
+
+    header = static_cast<const PriceStoreHeader*>(mapping);
+    if (!valid_header(*header, mapping_size)) {
+        ::munmap(mapping, mapping_size);
+        mapping = nullptr;
+        header = nullptr;
+        throw DataException("Not a valid price store: " + path);
+    }
+}
+
+MappedPriceStore::~MappedPriceStore() {
+    if (mapping) {
+        ::munmap(mapping, mapping_size);
+    }
+}
+
+MappedPriceStore::MappedPriceStore(MappedPriceStore&& other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)),
+      mapping_size(std::exchange(other.mapping_size, 0)),
+      header(std::exchange(other.header, nullptr)) {}
+
+MappedPriceStore& MappedPriceStore::operator=(MappedPriceStore&& other) noexcept {
+    if (this != &other) {
+        if (mapping) ::munmap(mapping, mapping_size);
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+        header = std::exchange(other.header, nullptr);
+    }
+    return *this;
+}
+
+template <typename T>
+Span<const T> MappedPriceStore::column(size_t index) const {
+    if (!header) return {};
+    const char* base = static_cast<const char*>(mapping);
+    return Span<const T>(reinterpret_cast<const T*>(base + header->column_offset[index]), header->count);
+}
+
+std::string MappedPriceStore::symbol() const {
+    if (!header) return {};
+    return std::string(header->symbol, strnlen(header->symbol, sizeof(header->symbol)));
+}
+
+PriceColumns MappedPriceStore::columns() const {
+    PriceColumns view;
+    view.symbol = symbol();
+    view.dates = dates();
+    view.open = open();
+    view.high = high();
+    view.low = low();
+    view.close = close();
+    view.volume = volume();
+    return view;
+}
+
+PriceSeries MappedPriceStore::to_series() const {
+    PriceSeries series;
+    series.symbol = symbol();
+    series.dates = dates().to_vector();
+    series.open = open().to_vector();
+    series.high = high().to_vector();
+    series.low = low().to_vector();
+    series.close = close().to_vector();
+    series.volume = volume().to_vector();
+    return series;
+}
+
+PriceStoreColumnReader::PriceStoreColumnReader(const std::string& path, PriceColumn column) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw DataException("Cannot open price store: " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PriceStoreHeader) ||
+        ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        ::close(fd);
+        throw DataException("Price store is truncated: " + path);
+    }
+    if (!valid_header(header, static_cast<size_t>(st.st_size))) {
+        ::close(fd);
+        throw DataException("Not a valid price store: " + path);
+    }
+    column_offset = header.column_offset[static_cast<size_t>(column)];
+}
+
+PriceStoreColumnReader::~PriceStoreColumnReader() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+PriceStoreColumnReader::PriceStoreColumnReader(PriceStoreColumnReader&& other) noexcept
+    : fd(std::exchange(other.fd, -1)),
+      header(other.header),
+      column_offset(other.column_offset),
+      next_bar(other.next_bar) {}
+
+PriceStoreColumnReader& PriceStoreColumnReader::operator=(PriceStoreColumnReader&& other) noexcept {
+    if (this != &other) {
+        if (fd >= 0) ::close(fd);
+        fd = std::exchange(other.fd, -1);
+        header = other.header;
+        column_offset = other.column_offset;
+        next_bar = other.next_bar;
+    }
+    return *this;
+}
+
+std::string PriceStoreColumnReader::symbol() const {
+    return std::string(header.symbol, strnlen(header.symbol, sizeof(header.symbol)));
+}
+
+size_t PriceStoreColumnReader::read(std::vector<double>& block, size_t max_bars) {
+    size_t count = std::min<size_t>(max_bars, header.count - next_bar);
+    block.resize(count);
+    size_t bytes = count * sizeof(double);
+    size_t done = 0;
+    char* out = reinterpret_cast<char*>(block.data());
+    while (done < bytes) {
+        ssize_t got = ::pread(fd, out + done, bytes - done, column_offset + next_bar * sizeof(double) + done);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) {
+            throw DataException("Failed reading price store column");
+        }
+        done += static_cast<size_t>(got);
+    }
+    next_bar += count;
+    return count;
+}
+
+template Span<const int64_t> MappedPriceStore::column<int64_t>(size_t) const;
+template Span<const double> MappedPriceStore::column<double>(size_t) const;
@@ -0,0 +1,119 @@
+#ifndef PRICE_STORE_H
+#define PRICE_STORE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "span.h"
+
+// OHLCV history, oldest bar first. Dates are Unix seconds (UTC).
+struct PriceSeries {
+    std::string symbol;
+    std::vector<int64_t> dates;
+    std::vector<double> open, high, low, close, volume;
+
+    size_t size() const { return close.size(); }
+};
+
+// Non-owning OHLCV columns, over a PriceSeries or straight over a mapped
+// store, so consumers read either without copying. Valid while the owner is.
+struct PriceColumns {
+    std::string symbol;
+    Span<const int64_t> dates;
+    Span<const double> open, high, low, close, volume;
+
+    PriceColumns() = default;
+    PriceColumns(const PriceSeries& series)
+        : symbol(series.symbol), dates(series.dates), open(series.open), high(series.high),
+          low(series.low), close(series.close), volume(series.volume) {}
+
+    size_t size() const { return close.size(); }
+};
+
+// On-disk columnar layout (native little-endian):
+//   PriceStoreHeader, then one 64-byte aligned column per field in the order
+//   date (int64), open, high, low, close, volume (double), each `count` long.
+struct PriceStoreHeader {
+    char magic[4];
+    uint32_t version;
+    char symbol[16];
+    uint64_t count;
+    uint64_t column_offset[6];
+    uint8_t reserved[48];
+};
+
+static_assert(sizeof(PriceStoreHeader) == 128, "PriceStoreHeader must stay 128 bytes");
+
+// Writes `series` to `path` atomically (temp file + rename)
+void write_price_store(const std::string& path, const PriceSeries& series);
+
+// Read-only memory mapping of a price store file. Columns are exposed as
+// spans directly over the mapping, so opening costs no parsing or copying.
+class MappedPriceStore {
+private:
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+    const PriceStoreHeader* header = nullptr;
+
+    template <typename T>
+    Span<const T> column(size_t index) const;
+
+public:
+    explicit MappedPriceStore(const std::string& path);
+    ~MappedPriceStore();
+
+    MappedPriceStore(MappedPriceStore&& other) noexcept;
+    MappedPriceStore& operator=(MappedPriceStore&& other) noexcept;
+    MappedPriceStore(const MappedPriceStore&) = delete;
+    MappedPriceStore& operator=(const MappedPriceStore&) = delete;
+
+    std::string symbol() const;
+    size_t size() const { return header ? header->count : 0; }
+
+    Span<const int64_t> dates() const { return column<int64_t>(0); }
+    Span<const double> open() const { return column<double>(1); }
+    Span<const double> high() const { return column<double>(2); }
+    Span<const double> low() const { return column<double>(3); }
+    Span<const double> close() const { return column<double>(4); }
+    Span<const double> volume() const { return column<double>(5); }
+
+    // Every column as a view over the mapping
+    PriceColumns columns() const;
+
+    // Owning copy, for code that needs std::vector
+    PriceSeries to_series() const;
+};
+
+// Double columns of a store, numbered as in column_offset
+enum class PriceColumn { Open = 1, High = 2, Low = 3, Close = 4, Volume = 5 };
+
+// Reads one column of a price store front to back in caller-sized blocks
+// with pread. Nothing is mapped, so resident memory is the caller's block
+// buffer however long the file is.
+class PriceStoreColumnReader {
+private:
+    int fd = -1;
+    PriceStoreHeader header{};
+    uint64_t column_offset = 0;
+    size_t next_bar = 0;
+
+public:
+    explicit PriceStoreColumnReader(const std::string& path, PriceColumn column = PriceColumn::Close);
+    ~PriceStoreColumnReader();
+
+    PriceStoreColumnReader(PriceStoreColumnReader&& other) noexcept;
+    PriceStoreColumnReader& operator=(PriceStoreColumnReader&& other) noexcept;
+    PriceStoreColumnReader(const PriceStoreColumnReader&) = delete;
+    PriceStoreColumnReader& operator=(const PriceStoreColumnReader&) = delete;
+
+    std::string symbol() const;
+    size_t size() const { return header.count; }
+    size_t position() const { return next_bar; }
+
+    // Next min(max_bars, remaining) values into `block`, which is resized
+    // and reuses its storage; returns the count, 0 once the column is done
+    size_t read(std::vector<double>& block, size_t max_bars);
+};
+
+#endif // PRICE_STORE_H
@@ -0,0 +1,352 @@
+#include "profiler.h"
+#include "exceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> Profiler::enabled_flag{false};
+
+namespace {
+
+constexpr size_t DEFAULT_MAX_CHUNKS = 64;
+std::atomic<size_t> max_chunks{DEFAULT_MAX_CHUNKS};
+
+struct ZoneEvent {
+    const char* name;
+    int64_t start_ns;
+    int64_t end_ns;
+    int depth;
+};
+
+// Fixed-size block of events. Only the owning thread writes; the count is
+// published with release so a reader sees fully written events.
+struct EventChunk {
+    static constexpr size_t CAPACITY = 4096;
+    ZoneEvent events[CAPACITY];
+    std::atomic<size_t> count{0};
+    std::atomic<EventChunk*> next{nullptr};
+};
+
+struct ThreadBuffer {
+    uint32_t thread_index;
+    EventChunk* head;
+    EventChunk* tail;
+    size_t chunks = 1;
+    size_t dropped = 0;
+
+    explicit ThreadBuffer(uint32_t index) : thread_index(index), head(new EventChunk), tail(head) {}
+    ~ThreadBuffer() { release_chain(head); }
+
+    static void release_chain(EventChunk* chunk) {
+        while (chunk) {
+            EventChunk* next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    void append(const ZoneEvent& event) {
+        size_t n = tail->count.load(std::memory_order_relaxed);
+        if (n == EventChunk::CAPACITY) {
+            EventChunk* chunk;
+            if (chunks < max_chunks.load(std::memory_order_relaxed)) {
+                chunk = new EventChunk;
+                ++chunks;
+            } else {
+                // At the limit: the oldest chunk becomes the new tail. A zone
+                // closes after its children, so a dropped zone's parent is
+                // never older than it and kept paths stay whole.
+                chunk = head;
+                head = head->next.load(std::memory_order_relaxed);
+                dropped += chunk->count.load(std::memory_order_relaxed);
+                chunk->count.store(0, std::memory_order_relaxed);
+                chunk->next.store(nullptr, std::memory_order_relaxed);
+            }
+            tail->next.store(chunk, std::memory_order_release);
+            tail = chunk;
+            n = 0;
+        }
+        tail->events[n] = event;
+        tail->count.store(n + 1, std::memory_order_release);
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const EventChunk* chunk = head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t n = chunk->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i) fn(chunk->events[i]);
+        }
+    }
+};
+
+// Buffers outlive their threads so pool workers can be aggregated after join
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::string trace_path;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadBuffer& local_buffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(reg.buffers.size())));
+        buffer = reg.buffers.back().get();
+    }
+    return *buffer;
+}
+
+// Nearest-rank percentile of sorted durations
+double percentile_us(const std::vector<int64_t>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    size_t idx = rank == 0 ? 0 : std::min(rank - 1, sorted.size() - 1);
+    return sorted[idx] / 1000.0;
+}
+
+void write_json_string(std::ostream& out, const char* s) {
+    out << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out << '\\';
+        out << *s;
+    }
+    out << '"';
+}
+
+} // namespace
+
+int& ProfileZone::depth() {
+    thread_local int value = 0;
+    return value;
+}
+
+void Profiler::set_enabled(bool on) {
+    enabled_flag.store(on && ALGO_PROFILING, std::memory_order_relaxed);
+}
+
+void Profiler::init_from_env() {
+    const char* flag = std::getenv("ALGO_PROFILE");
+    const char* trace = std::getenv("ALGO_PROFILE_TRACE");
+    if (trace && *trace) {
+        set_trace_path(trace);
+        set_enabled(true);
+    }
+    if (flag && *flag && std::string(flag) != "0") {
+        set_enabled(true);
+    }
+}
+
+void Profiler::set_trace_path(const std::string& path) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.trace_path = path;
+}
+
+void Profiler::set_event_limit(size_t zones_per_thread) {
+    // Two chunks at least: the one being filled and one to recycle
+    size_t chunks = (zones_per_thread + EventChunk::CAPACITY - 1) / EventChunk::CAPACITY;
+    max_chunks.store(std::max<size_t>(chunks, 2), std::memory_order_relaxed);
+}
+
+size_t Profiler::event_limit() {
+    return max_chunks.load(std::memory_order_relaxed) * EventChunk::CAPACITY;
+}
+
+void Profiler::record(const char* name, int64_t start_ns, int64_t end_ns, int depth) {
+    local_buffer().append(ZoneEvent{name, start_ns, end_ns, depth});
+}
+
+std::vector<ZoneStats> Profiler::summarize() {
+    struct PathData {
+        std::string name;
+        int depth = 0;
+        int64_t first_start = 0;
+        std::vector<int64_t> durations;
+    };
+    std::map<std::string, PathData> paths;
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        std::vector<ZoneEvent> events;
+        buffer->for_each([&](const ZoneEvent& e) { events.push_back(e); });
+
+        // Zones close child-first; ordering by start (then depth) puts each
+        // parent ahead of its children so the path stack can be rebuilt
+        std::sort(events.begin(), events.end(), [](const ZoneEvent& a, const ZoneEvent& b) {
+            return a.start_ns != b.start_ns ? a.start_ns < b.start_ns : a.depth < b.depth;
+        });
+
+        std::vector<std::string> stack;
+        for (const ZoneEvent& e : events) {
+            stack.resize(std::min(static_cast<size_t>(e.depth), stack.size()));
+            std::string path = stack.empty() ? e.name : stack.back() + "/" + e.name;
+            stack.push_back(path);
+
+            auto inserted = paths.emplace(path, PathData{});
+            PathData& data = inserted.first->second;
+            if (inserted.second) {
+                data.name = e.name;
+                data.depth = static_cast<int>(stack.size()) - 1;
+                data.first_start = e.start_ns;
+            }
+            data.first_start = std::min(data.first_start, e.start_ns);
+            data.durations.push_back(e.end_ns - e.start_ns);
+        }
+    }
+
+    std::vector<ZoneStats> stats;
+    std::map<std::string, std::vector<int64_t>> order_keys;
+    for (auto& entry : paths) {
+        PathData& data = entry.second;
+        std::sort(data.durations.begin(), data.durations.end());
+
+        ZoneStats s;
+        s.path = entry.first;
+        s.name = data.name;
+        s.depth = data.depth;
+        s.count = data.durations.size();
+        int64_t total = 0;
+        for (int64_t d : data.durations) total += d;
+        s.total_us = total / 1000.0;
+        s.min_us = data.durations.front() / 1000.0;
+        s.max_us = data.durations.back() / 1000.0;
+        s.p50_us = percentile_us(data.durations, 0.50);
+        s.p99_us = percentile_us(data.durations, 0.99);
+        stats.push_back(s);
+
+        // Sort key: first start time of every ancestor prefix, so subtrees
+        // stay together and siblings appear in the order they first ran
+        std::vector<int64_t> key;
+        for (size_t pos = 0;; ++pos) {
+            pos = entry.first.find('/', pos);
+            std::string prefix = entry.first.substr(0, pos);
+            auto it = paths.find(prefix);
+            key.push_back(it != paths.end() ? it->second.first_start : 0);
+            if (pos == std::string::npos) break;
+        }
+        order_keys[entry.first] = std::move(key);
+    }
+
+    std::sort(stats.begin(), stats.end(), [&](const ZoneStats& a, const ZoneStats& b) {
+        const auto& ka = order_keys[a.path];
+        const auto& kb = order_keys[b.path];
+        return ka != kb ? ka < kb : a.path < b.path;
+    });
+    return stats;
+}
+
+size_t Profiler::event_count() {
+    size_t total = 0;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        buffer->for_each([&](const ZoneEvent&) { ++total; });
+    }
+    return total;
+}
+
+size_t Profiler::dropped_count() {
+    size_t total = 0;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) total += buffer->dropped;
+    return total;
+}
+
+void Profiler::print_summary(std::ostream& out) {
+    auto stats = summarize();
+    out << "\n📊 Profile (" << event_count() << " zones)\n";
+    if (size_t dropped = dropped_count()) {
+        out << "⚠️ " << dropped << " older zones dropped at " << event_limit()
+            << " per thread; the table covers the most recent ones\n";
+    }
+    out << std::left << std::setw(44) << "Zone" << std::right
+        << std::setw(8) << "Count" << std::setw(12) << "Total ms"
+        << std::setw(11) << "Min μs" << std::setw(11) << "p50 μs"
+        << std::setw(11) << "p99 μs" << std::setw(11) << "Max μs" << "\n";
+
+    out << std::fixed << std::setprecision(1);
+    for (const auto& s : stats) {
+        std::string label = std::string(2 * s.depth, ' ') + s.name;
+        out << std::left << std::setw(44) << label << std::right
+            << std::setw(8) << s.count << std::setw(12) << s.total_us / 1000.0
+            << std::setw(11) << s.min_us << std::setw(11) << s.p50_us
+            << std::setw(11) << s.p99_us << std::setw(11) << s.max_us << "\n";
+    }
+}
+
+void Profiler::write_chrome_trace(std::ostream& out) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    int64_t origin = INT64_MAX;
+    for (const auto& buffer : reg.buffers) {
+        buffer->for_each([&](const ZoneEvent& e) { origin = std::min(origin, e.start_ns); });
+    }
+
+    // Complete ("X") events in microseconds, one track per recording thread
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    out << std::fixed << std::setprecision(3);
+    for (const auto& buffer : reg.buffers) {
+        out << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << buffer->thread_index << ",\"args\":{\"name\":\"thread " << buffer->thread_index << "\"}}";
+        first = false;
+        buffer->for_each([&](const ZoneEvent& e) {
+            out << ",{\"name\":";
+            write_json_string(out, e.name);
+            out << ",\"cat\":\"algo\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_index
+                << ",\"ts\":" << (e.start_ns - origin) / 1000.0
+                << ",\"dur\":" << (e.end_ns - e.start_ns) / 1000.0 << "}";
+        });
+    }
+    out << "]}\n";
+}
+
+void Profiler::write_chrome_trace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw DataException("Cannot write profile trace: " + path);
+    }
+    write_chrome_trace(out);
+}
+
+void Profiler::report(std::ostream& out) {
+    if (!enabled()) return;
+    print_summary(out);
+
+    std::string trace_path;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        trace_path = reg.trace_path;
+    }
+    if (!trace_path.empty()) {
+        write_chrome_trace(trace_path);
+        out << "💾 Wrote Chrome trace " << trace_path << "\n";
+    }
+}
+
+void Profiler::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        ThreadBuffer::release_chain(buffer->head->next.exchange(nullptr));
+        buffer->head->count.store(0, std::memory_order_release);
+        buffer->tail = buffer->head;
+        buffer->chunks = 1;
+        buffer->dropped = 0;
+    }
+}
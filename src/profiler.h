@@ -0,0 +1,113 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Scoped-zone profiler. Zones nest per thread; each thread appends finished
+// zones to its own chunked buffer without locking, and aggregation walks the
+// buffers afterwards. A buffer holds at most event_limit() zones: past that
+// it reuses its oldest chunk, so long runs keep their most recent zones in
+// bounded memory. Building with -DENABLE_PROFILING=OFF turns PROFILE_ZONE
+// into a no-op; otherwise zones cost one relaxed load until enabled at
+// runtime through ALGO_PROFILE=1 (or Profiler::set_enabled).
+
+#ifndef ALGO_PROFILING
+#define ALGO_PROFILING 1
+#endif
+
+// Aggregate over every zone with the same nesting path ("a/b/c")
+struct ZoneStats {
+    std::string path;
+    std::string name;
+    int depth = 0;
+    size_t count = 0;
+    double total_us = 0.0;
+    double min_us = 0.0;
+    double max_us = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+};
+
+class Profiler {
+public:
+    static bool enabled() { return enabled_flag.load(std::memory_order_relaxed); }
+    static void set_enabled(bool on);
+
+    // ALGO_PROFILE=1 enables collection; ALGO_PROFILE_TRACE=<file> also
+    // requests a Chrome trace (chrome://tracing, Perfetto) from report()
+    static void init_from_env();
+    static void set_trace_path(const std::string& path);
+
+    // Zones kept per thread, rounded up to whole buffer chunks of 4096 (two
+    // at least)
+    // (default 262144, 8 MiB per recording thread)
+    static void set_event_limit(size_t zones_per_thread);
+    static size_t event_limit();
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static void record(const char* name, int64_t start_ns, int64_t end_ns, int depth);
+
+    // Readers expect no zones to be recording concurrently
+    static std::vector<ZoneStats> summarize();
+    static size_t event_count();
+    // Zones discarded to stay within event_limit(), all threads
+    static size_t dropped_count();
+    static void print_summary(std::ostream& out);
+    static void write_chrome_trace(std::ostream& out);
+    static void write_chrome_trace(const std::string& path);
+
+    // Prints the summary and writes the configured trace; no-op when disabled
+    static void report(std::ostream& out);
+
+    // Discards recorded zones; only call while no thread is inside a zone
+    static void reset();
+
+private:
+    static std::atomic<bool> enabled_flag;
+};
+
+class ProfileZone {
+private:
+    const char* name;
+    int64_t start_ns = 0;
+    bool active;
+
+    static int& depth();
+
+public:
+    explicit ProfileZone(const char* zone_name) : name(zone_name), active(Profiler::enabled()) {
+        if (active) {
+            ++depth();
+            start_ns = Profiler::now_ns();
+        }
+    }
+
+    ~ProfileZone() {
+        if (active) {
+            int64_t end_ns = Profiler::now_ns();
+            Profiler::record(name, start_ns, end_ns, --depth());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if ALGO_PROFILING
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,40 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+// Non-owning view over contiguous elements (a minimal C++17 stand-in for std::span).
+// Converts implicitly from std::vector so existing callers keep working.
+template <typename T>
+class Span {
+private:
+    T* ptr = nullptr;
+    size_t count = 0;
+
+public:
+    using value_type = std::remove_cv_t<T>;
+
+    Span() = default;
+    Span(T* data, size_t size) : ptr(data), count(size) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    Span(std::vector<U>& v) : ptr(v.data()), count(v.size()) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<const U (*)[], T (*)[]>::value>>
+    Span(const std::vector<U>& v) : ptr(v.data()), count(v.size()) {}
+
+    T* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](size_t i) const { return ptr[i]; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+
+    Span subspan(size_t offset, size_t length) const { return Span(ptr + offset, length); }
+    std::vector<value_type> to_vector() const { return std::vector<value_type>(begin(), end()); }
+};
+
+#endif // SPAN_H
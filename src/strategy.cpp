@@ -1,51 +1,96 @@
 #include "strategy.h"
-#include "benchmark.h"
+#include "exceptions.h"
+#include "profiler.h"
 #include <iostream>
+#include <string>
 
-void backtest_strategy(const std::vector<double>& closes,
-                       const std::vector<double>& sma200,
-                       const std::vector<double>& rsi,
-                       const std::vector<double>& macd,
-                       const std::vector<double>& signal,
-                       int look_ahead,
-                       double stop_loss_percent,
-                       double take_profit_percent) {
-    
-    BENCHMARK("Strategy Signal Detection");
+// Legacy console summary: trade count and take-profit rate
+static void print_strategy_results(const TradeTally& tally) {
+    double win_rate = tally.triggers ? (100.0 * tally.successes / tally.triggers) : 0.0;
+
+    std::cout << "\n📊 Strategy Results\n";
+    std::cout << "  Triggers  : " << tally.triggers << "\n";
+    std::cout << "  Successes : " << tally.successes << "\n";
+    std::cout << "  Win Rate  : " << win_rate << "%\n";
+}
+
+static size_t last_entry_end(Span<const double> closes, int look_ahead) {
+    return closes.size() > static_cast<size_t>(look_ahead) ? closes.size() - look_ahead : 0;
+}
+
+void validate_strategy_parameters(const StrategyParameters& params, size_t bars) {
+    if (params.ma_period <= 0 || params.rsi_period <= 0 || params.look_ahead <= 0) {
+        throw CalculationException("Indicator periods and look-ahead must be positive");
+    }
+    if (!(params.stop_loss > 0.0 && params.stop_loss < 1.0) ||
+        !(params.take_profit > 0.0 && params.take_profit < 1.0)) {
+        throw CalculationException("Stop-loss and take-profit must be fractions in (0, 1)");
+    }
+    if (!(params.rsi_threshold > 0.0 && params.rsi_threshold <= 100.0)) {
+        throw CalculationException("RSI threshold must be in (0, 100]");
+    }
+    if (bars < static_cast<size_t>(params.ma_period)) {
+        throw CalculationException("Failed to calculate technical indicators: " + std::to_string(bars) +
+                                   " bars for a " + std::to_string(params.ma_period) + "-bar SMA");
+    }
+}
+
+TradeTally backtest_strategy(Span<const double> closes,
+                             const std::vector<double>& sma,
+                             const std::vector<double>& rsi,
+                             const std::vector<double>& macd,
+                             const std::vector<double>& signal,
+                             const StrategyParameters& params) {
     
-    size_t triggers = 0, successes = 0;
-
-    for (size_t i = 200; i + look_ahead < closes.size(); ++i) {
-        bool above200 = closes[i] > sma200[i];
-        bool bullishMACD = macd[i] > signal[i] && macd[i - 1] <= signal[i - 1];
-        bool rsiBelow70 = rsi[i] < 70;
-
-        if (above200 && bullishMACD && rsiBelow70) {
-            ++triggers;
-
-            double entryPrice = closes[i];
-            double stopLoss = entryPrice * (1.0 - stop_loss_percent);
-            double takeProfit = entryPrice * (1.0 + take_profit_percent);
-
-            bool success = false;
-            for (size_t j = i + 1; j <= i + look_ahead && j < closes.size(); ++j) {
-                if (closes[j] >= takeProfit) {
-                    success = true;
-                    break;
-                }
-                if (closes[j] <= stopLoss) {
-                    break;
-                }
-            }
-
-            if (success) ++successes;
-        }
+    PROFILE_ZONE("Strategy Signal Detection");
+
+    validate_strategy_parameters(params, closes.size());
+    if (sma.size() != closes.size() || rsi.size() != closes.size() || macd.size() != closes.size() ||
+        signal.size() != closes.size()) {
+        throw CalculationException("Failed to calculate technical indicators");
     }
+    auto entry = all_of(SeriesAboveSMA<double>(closes, sma), SeriesMACDCross<double>(macd, signal),
+                        SeriesRSIBelow<double>(rsi, params.rsi_threshold));
+    TakeProfitStopLoss<> exit(params.stop_loss, params.take_profit, params.look_ahead);
+    TradeTally tally = run_strategy(entry, exit, closes, params.ma_period, last_entry_end(closes, params.look_ahead));
+    print_strategy_results(tally);
+    return tally;
+}
 
-    double win_rate = triggers ? (100.0 * successes / triggers) : 0.0;
+std::vector<size_t> scan_entry_signals(Span<const double> closes,
+                                       int ma_period,
+                                       int rsi_period,
+                                       double rsi_threshold,
+                                       size_t begin,
+                                       size_t end) {
+    std::vector<size_t> triggers;
+    StreamingSMA sma(ma_period);
+    scan_entry_signals(closes, ma_period, rsi_period, rsi_threshold, begin, end, sma, triggers);
+    return triggers;
+}
 
-    std::cout << "\n📊 Strategy Results\n";
-    std::cout << "  Triggers  : " << triggers << "\n";
-    std::cout << "  Successes : " << successes << "\n";
-    std::cout << "  Win Rate  : " << win_rate << "%\n";
-}
\ No newline at end of file
+void scan_entry_signals(Span<const double> closes,
+                        int ma_period,
+                        int rsi_period,
+                        double rsi_threshold,
+                        size_t begin,
+                        size_t end,
+                        StreamingSMA& sma,
+                        std::vector<size_t>& triggers) {
+    auto entry = all_of(CloseAboveSMA(sma, ma_period), MACDBullishCross(), RSIBelow(rsi_period, rsi_threshold));
+    scan_entries(entry, Span<const double>(closes), begin, end, triggers);
+}
+
+TradeTally backtest_strategy(Span<const double> closes, const StrategyParameters& params) {
+
+    PROFILE_ZONE("Strategy Signal Detection");
+
+    validate_strategy_parameters(params, closes.size());
+    StreamingSMA sma(params.ma_period);
+    auto entry = all_of(CloseAboveSMA(sma, params.ma_period), MACDBullishCross(),
+                        RSIBelow(params.rsi_period, params.rsi_threshold));
+    TakeProfitStopLoss<> exit(params.stop_loss, params.take_profit, params.look_ahead);
+    TradeTally tally = run_strategy(entry, exit, closes, params.ma_period, last_entry_end(closes, params.look_ahead));
+    print_strategy_results(tally);
+    return tally;
+}
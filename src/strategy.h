@@ -2,15 +2,53 @@
 #define STRATEGY_H
 
 #include <vector>
+#include <cstddef>
+#include "span.h"
+#include "optimizer.h"
+#include "strategy_engine.h"
+#include "streaming_indicators.h"
 
-// Function to backtest the trading strategy
-void backtest_strategy(const std::vector<double>& closes,
-                       const std::vector<double>& sma200,
-                       const std::vector<double>& rsi,
-                       const std::vector<double>& macd,
-                       const std::vector<double>& signal,
-                       int look_ahead,
-                       double stop_loss_percent,
-                       double take_profit_percent);
+// Throws CalculationException when `params` cannot be backtested on
+// `bars` closes: non-positive periods or look-ahead, levels outside (0, 1),
+// an RSI threshold outside (0, 100], or fewer bars than the SMA period
+void validate_strategy_parameters(const StrategyParameters& params, size_t bars);
+
+// Function to backtest the trading strategy: entries from bar
+// params.ma_period with RSI < params.rsi_threshold, exits by
+// TakeProfitStopLoss, printed as a summary. Both overloads run
+// strategy_engine.h, validate `params` first and return the printed tally.
+TradeTally backtest_strategy(Span<const double> closes,
+                             const std::vector<double>& sma,
+                             const std::vector<double>& rsi,
+                             const std::vector<double>& macd,
+                             const std::vector<double>& signal,
+                             const StrategyParameters& params);
+
+// Same strategy with the SMA/RSI/MACD(12,26,9) indicators computed on the
+// fly by streaming conditions instead of passed in as arrays
+TradeTally backtest_strategy(Span<const double> closes, const StrategyParameters& params);
+
+// Fused single-pass entry scan: advances SMA, MACD(12,26,9) and RSI one bar
+// at a time and returns the indices i in [begin, end) where
+//   close > SMA && MACD crosses above signal && RSI < rsi_threshold.
+// Produces the same triggers as evaluating the batch calc_* arrays.
+std::vector<size_t> scan_entry_signals(Span<const double> closes,
+                                       int ma_period,
+                                       int rsi_period,
+                                       double rsi_threshold,
+                                       size_t begin,
+                                       size_t end);
+
+// Same scan into caller-owned storage: `triggers` is overwritten and `sma` is
+// reset to ma_period, so a caller that keeps both across scans does no heap
+// allocation once they have grown.
+void scan_entry_signals(Span<const double> closes,
+                        int ma_period,
+                        int rsi_period,
+                        double rsi_threshold,
+                        size_t begin,
+                        size_t end,
+                        StreamingSMA& sma,
+                        std::vector<size_t>& triggers);
 
 #endif // STRATEGY_H
\ No newline at end of file
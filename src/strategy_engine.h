@@ -0,0 +1,230 @@
+#ifndef STRATEGY_ENGINE_H
+#define STRATEGY_ENGINE_H
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+#include "span.h"
+#include "indicators.h"
+#include "exit_resolver.h"
+#include "streaming_indicators.h"
+
+// Strategy engine assembled from policy types at compile time.
+//
+// An entry condition is any type with
+//   static constexpr bool needs_history;   // must see every bar from 0
+//   bool update(size_t i, double close);   // bar i; true when it holds there
+// and an exit is any type with
+//   ExitReason exit(Span<const T> closes, size_t entry) const;
+//   double trade_return(ExitReason reason) const;
+// AllOf<...> combines conditions with a non-short-circuit AND, so every
+// indicator advances each bar and the composed predicate is a single branch.
+// scan_entries / run_strategy are the only bar loops; backtest_detailed,
+// backtest_window, backtest_arrays, scan_entry_signals and backtest_strategy
+// are all instantiations.
+
+// Streaming conditions: indicators advance one bar per update
+
+// close > SMA(period). The window is the caller's, reset here, so a kept
+// StreamingSMA is reused across runs.
+class CloseAboveSMA {
+private:
+    StreamingSMA& sma;
+
+public:
+    static constexpr bool needs_history = true;
+
+    CloseAboveSMA(StreamingSMA& window, int period) : sma(window) { sma.reset(period); }
+    bool update(size_t, double close) { return close > sma.update(close); }
+};
+
+// MACD line crosses above its signal line on this bar
+class MACDBullishCross {
+private:
+    StreamingMACD macd;
+    MACDValue prev{0.0, 0.0};
+
+public:
+    static constexpr bool needs_history = true;
+
+    explicit MACDBullishCross(int fast = 12, int slow = 26, int sig = 9) : macd(fast, slow, sig) {}
+    bool update(size_t, double close) {
+        MACDValue cur = macd.update(close);
+        bool cross = cur.macd > cur.signal && prev.macd <= prev.signal;
+        prev = cur;
+        return cross;
+    }
+};
+
+class RSIBelow {
+private:
+    StreamingRSI rsi;
+    double threshold;
+
+public:
+    static constexpr bool needs_history = true;
+
+    RSIBelow(int period, double rsi_threshold) : rsi(period), threshold(rsi_threshold) {}
+    bool update(size_t, double close) { return rsi.update(close) < threshold; }
+};
+
+// Precomputed-array conditions: bar i only reads index i (and i - 1)
+
+template <typename T>
+class SeriesAboveSMA {
+private:
+    Span<const T> prices, sma;
+
+public:
+    static constexpr bool needs_history = false;
+
+    SeriesAboveSMA(Span<const T> closes, Span<const T> sma_values) : prices(closes), sma(sma_values) {}
+    bool update(size_t i, double) const { return prices[i] > sma[i]; }
+};
+
+template <typename T>
+class SeriesMACDCross {
+private:
+    Span<const T> macd, signal;
+
+public:
+    static constexpr bool needs_history = false;
+
+    SeriesMACDCross(Span<const T> macd_values, Span<const T> signal_values) : macd(macd_values), signal(signal_values) {}
+    explicit SeriesMACDCross(const BasicMACD<T>& m) : SeriesMACDCross(m.macd, m.signal) {}
+    bool update(size_t i, double) const { return macd[i] > signal[i] && macd[i - 1] <= signal[i - 1]; }
+};
+
+template <typename T>
+class SeriesRSIBelow {
+private:
+    Span<const T> rsi;
+    double threshold;
+
+public:
+    static constexpr bool needs_history = false;
+
+    SeriesRSIBelow(Span<const T> rsi_values, double rsi_threshold) : rsi(rsi_values), threshold(rsi_threshold) {}
+    bool update(size_t i, double) const { return rsi[i] < threshold; }
+};
+
+template <typename... Conditions>
+class AllOf {
+private:
+    std::tuple<Conditions...> conditions;
+
+public:
+    static constexpr bool needs_history = (Conditions::needs_history || ...);
+
+    explicit AllOf(Conditions... parts) : conditions(std::move(parts)...) {}
+    bool update(size_t i, double close) {
+        return std::apply([&](auto&... c) { return (static_cast<unsigned>(c.update(i, close)) & ...) != 0; },
+                          conditions);
+    }
+};
+
+template <typename... Conditions>
+AllOf<Conditions...> all_of(Conditions... parts) {
+    return AllOf<Conditions...>(std::move(parts)...);
+}
+
+// Exits
+
+// First bar in (entry, entry + look_ahead] at or beyond a level, levels as
+// fractions of the entry price compared in T; take-profit is checked first
+template <typename T = double>
+class TakeProfitStopLoss {
+private:
+    double stop_loss, take_profit;
+    int look_ahead;
+
+public:
+    TakeProfitStopLoss(double stop, double take, int look) : stop_loss(stop), take_profit(take), look_ahead(look) {}
+
+    T stop_price(T entry_price) const { return entry_price * (T(1) - T(stop_loss)); }
+    T take_price(T entry_price) const { return entry_price * (T(1) + T(take_profit)); }
+    int window() const { return look_ahead; }
+
+    // The level one later close reaches, take-profit first; Expired for neither
+    static ExitReason level_hit(T close, T stop, T take) {
+        if (close >= take) return ExitReason::TakeProfit;
+        if (close <= stop) return ExitReason::StopLoss;
+        return ExitReason::Expired;
+    }
+
+    ExitReason exit(Span<const T> closes, size_t entry) const {
+        T stop = stop_price(closes[entry]);
+        T take = take_price(closes[entry]);
+        for (size_t j = entry + 1; j <= entry + look_ahead && j < closes.size(); ++j) {
+            ExitReason reason = level_hit(closes[j], stop, take);
+            if (reason != ExitReason::Expired) return reason;
+        }
+        return ExitReason::Expired;
+    }
+    double trade_return(ExitReason reason) const {
+        return reason == ExitReason::TakeProfit ? take_profit : -stop_loss;
+    }
+};
+
+// Same exits answered by an ExitResolver's rolling max/min tables
+class ResolvedTakeProfitStopLoss {
+private:
+    const ExitResolver& resolver;
+    TakeProfitStopLoss<> levels;
+
+public:
+    ResolvedTakeProfitStopLoss(const ExitResolver& exits, double stop, double take, int look)
+        : resolver(exits), levels(stop, take, look) {}
+
+    ExitReason exit(Span<const double> closes, size_t entry) const {
+        double entry_price = closes[entry];
+        return resolver.resolve(entry, levels.stop_price(entry_price), levels.take_price(entry_price),
+                                levels.window()).reason;
+    }
+    double trade_return(ExitReason reason) const { return levels.trade_return(reason); }
+};
+
+struct TradeTally {
+    size_t triggers = 0;
+    size_t successes = 0;       // take-profit exits
+    double total_return = 0.0;  // summed in trade order
+};
+
+// Bars whose entry is evaluated: [max(begin, 1), min(end, size)), with the
+// conditions fed from bar 0 when they need history. Bar 0 never fires because
+// a crossover needs a previous bar.
+template <typename Entry, typename T, typename Visit>
+void for_each_entry(Entry& entry, Span<const T> prices, size_t begin, size_t end, Visit visit) {
+    end = std::min(end, prices.size());
+    if (begin >= end) return;
+    begin = std::max<size_t>(begin, 1);
+    size_t first = Entry::needs_history ? 0 : begin;
+    for (size_t i = first; i < end; ++i) {
+        bool fire = entry.update(i, prices[i]);
+        if (fire && i >= begin) visit(i);
+    }
+}
+
+// Entry bars into `triggers` (overwritten)
+template <typename Entry, typename T>
+void scan_entries(Entry& entry, Span<const T> prices, size_t begin, size_t end, std::vector<size_t>& triggers) {
+    triggers.clear();
+    for_each_entry(entry, prices, begin, end, [&](size_t i) { triggers.push_back(i); });
+}
+
+// Entries resolved by `exit` as they fire, tallied in trade order; no trigger
+// list is materialized
+template <typename Entry, typename Exit, typename T>
+TradeTally run_strategy(Entry& entry, const Exit& exit, Span<const T> prices, size_t begin, size_t end) {
+    TradeTally tally;
+    for_each_entry(entry, prices, begin, end, [&](size_t i) {
+        ++tally.triggers;
+        ExitReason reason = exit.exit(prices, i);
+        if (reason == ExitReason::TakeProfit) ++tally.successes;
+        if (reason != ExitReason::Expired) tally.total_return += exit.trade_return(reason);
+    });
+    return tally;
+}
+
+#endif // STRATEGY_ENGINE_H
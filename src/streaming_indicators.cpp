@@ -0,0 +1,114 @@
+#include "streaming_indicators.h"
+#include "compensated_sum.h"
+#include "exceptions.h"
+#include <limits>
+
+// Each update mirrors the arithmetic of its batch counterpart in
+// indicators.cpp operation for operation; keep the two in sync.
+
+StreamingSMA::StreamingSMA(int period) {
+    reset(period);
+}
+
+void StreamingSMA::reset(int period) {
+    if (period <= 0) {
+        throw CalculationException("SMA period must be positive");
+    }
+    window.assign(period, 0.0);
+    head = count = 0;
+    sum = comp = 0.0;
+    non_finite = NonFiniteWindow{};
+    current = std::numeric_limits<double>::quiet_NaN();
+}
+
+double StreamingSMA::update(double close) {
+    compensated_add(sum, comp, non_finite.enter(close));
+    if (count >= window.size()) {
+        compensated_add(sum, comp, -non_finite.leave(window[head]));
+    }
+    window[head] = close;
+    head = head + 1 == window.size() ? 0 : head + 1;
+    ++count;
+
+    if (count >= window.size()) {
+        double total = non_finite.clean() ? sum + comp : non_finite.sum<double>();
+        current = total / static_cast<int>(window.size());
+    }
+    return current;
+}
+
+StreamingEMA::StreamingEMA(int period) : k(2.0 / (period + 1.0)) {
+    if (period <= 0) {
+        throw CalculationException("EMA period must be positive");
+    }
+}
+
+double StreamingEMA::update(double close) {
+    if (!seeded) {
+        current = close;
+        seeded = true;
+    } else {
+        current = close * k + current * (1.0 - k);
+    }
+    return current;
+}
+
+StreamingMACD::StreamingMACD(int fast, int slow, int sig)
+    : fast_ema(fast), slow_ema(slow), k_signal(2.0 / (sig + 1.0)) {
+    if (sig <= 0) {
+        throw CalculationException("MACD signal period must be positive");
+    }
+}
+
+MACDValue StreamingMACD::update(double close) {
+    double fast = fast_ema.update(close);
+    double slow = slow_ema.update(close);
+    if (!seeded) {
+        // calc_macd leaves macd[0] and signal[0] at zero
+        seeded = true;
+        return current;
+    }
+    current.macd = fast - slow;
+    current.signal = current.macd * k_signal + current.signal * (1.0 - k_signal);
+    return current;
+}
+
+StreamingRSI::StreamingRSI(int period)
+    : period_(period), current(std::numeric_limits<double>::quiet_NaN()) {
+    if (period <= 0) {
+        throw CalculationException("RSI period must be positive");
+    }
+}
+
+double StreamingRSI::update(double close) {
+    size_t i = count++;
+    if (i == 0) {
+        prev_close = close;
+        return current;
+    }
+
+    double change = close - prev_close;
+    prev_close = close;
+
+    if (i <= static_cast<size_t>(period_)) {
+        // Seed window: simple average of the first `period` changes
+        if (change > 0) gain += change;
+        else loss -= change;
+        if (i == static_cast<size_t>(period_)) {
+            gain /= period_;
+            loss /= period_;
+            current = 100.0 - (100.0 / (1.0 + (gain / loss)));
+        }
+        return current;
+    }
+
+    if (change > 0) {
+        gain = (gain * (period_ - 1) + change) / period_;
+        loss = (loss * (period_ - 1)) / period_;
+    } else {
+        gain = (gain * (period_ - 1)) / period_;
+        loss = (loss * (period_ - 1) - change) / period_;
+    }
+    current = 100.0 - (100.0 / (1.0 + (gain / loss)));
+    return current;
+}
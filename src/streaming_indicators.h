@@ -0,0 +1,82 @@
+#ifndef STREAMING_INDICATORS_H
+#define STREAMING_INDICATORS_H
+
+#include <vector>
+#include <cstddef>
+#include "compensated_sum.h"
+
+// Stateful one-bar-at-a-time indicators. Feeding a series through update()
+// yields values bit-identical to the matching batch calc_* function, with
+// O(1) work per bar. Values that the batch version reports as NaN (warm-up)
+// are returned as NaN here too.
+
+class StreamingSMA {
+private:
+    std::vector<double> window;
+    size_t head = 0;
+    size_t count = 0;
+    double sum = 0.0;
+    double comp = 0.0;
+    NonFiniteWindow non_finite;
+    double current;
+
+public:
+    explicit StreamingSMA(int period);
+
+    // Starts over with a new period, reusing the window's storage
+    void reset(int period);
+
+    double update(double close);
+    double value() const { return current; }
+    bool ready() const { return count >= window.size(); }
+    int period() const { return static_cast<int>(window.size()); }
+};
+
+class StreamingEMA {
+private:
+    double k;
+    double current = 0.0;
+    bool seeded = false;
+
+public:
+    explicit StreamingEMA(int period);
+
+    double update(double close);
+    double value() const { return current; }
+};
+
+struct MACDValue { double macd, signal; };
+
+class StreamingMACD {
+private:
+    StreamingEMA fast_ema, slow_ema;
+    double k_signal;
+    MACDValue current{0.0, 0.0};
+    bool seeded = false;
+
+public:
+    explicit StreamingMACD(int fast = 12, int slow = 26, int sig = 9);
+
+    MACDValue update(double close);
+    MACDValue value() const { return current; }
+};
+
+// Wilder-smoothed RSI
+class StreamingRSI {
+private:
+    int period_;
+    size_t count = 0;
+    double prev_close = 0.0;
+    double gain = 0.0, loss = 0.0;
+    double current;
+
+public:
+    explicit StreamingRSI(int period = 14);
+
+    double update(double close);
+    double value() const { return current; }
+    bool ready() const { return count > static_cast<size_t>(period_); }
+    int period() const { return period_; }
+};
+
+#endif // STREAMING_INDICATORS_H
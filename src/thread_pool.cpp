@@ -0,0 +1,88 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads == 0) num_threads = 1;
+    for (size_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run_job(const std::function<void(size_t)>& fn, size_t count) {
+    for (size_t i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1)) {
+        try {
+            fn(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!first_error) first_error = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::worker_loop() {
+    size_t seen_generation = 0;
+    while (true) {
+        const std::function<void(size_t)>* current = nullptr;
+        size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_ready.wait(lock, [&] { return stopping || job_generation != seen_generation; });
+            if (stopping) return;
+            seen_generation = job_generation;
+            // The job may already have finished before this worker woke up
+            if (!job) continue;
+            current = job;
+            count = job_count;
+            ++active_workers;
+        }
+
+        run_job(*current, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --active_workers;
+        }
+        job_done.notify_all();
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+
+    if (workers.empty()) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        job_count = count;
+        next_index.store(0);
+        first_error = nullptr;
+        ++job_generation;
+    }
+    job_ready.notify_all();
+
+    run_job(fn, count);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        job_done.wait(lock, [&] { return active_workers == 0; });
+        job = nullptr;
+        error = first_error;
+        first_error = nullptr;
+    }
+    if (error) std::rethrow_exception(error);
+}
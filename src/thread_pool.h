@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <cstddef>
+
+// Fixed-size pool of worker threads for data-parallel loops.
+// Indices are handed out dynamically, so uneven work per index still
+// balances across workers. The calling thread also takes part.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs fn(i) for every i in [0, count) and blocks until all are done.
+    // The first exception thrown by fn is rethrown here.
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn);
+
+    size_t size() const { return workers.size() + 1; }
+
+private:
+    void worker_loop();
+    void run_job(const std::function<void(size_t)>& fn, size_t count);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+
+    const std::function<void(size_t)>* job = nullptr;
+    size_t job_count = 0;
+    size_t job_generation = 0;
+    size_t active_workers = 0;
+    std::atomic<size_t> next_index{0};
+    std::exception_ptr first_error;
+    bool stopping = false;
+};
+
+#endif // THREAD_POOL_H
@@ -1,24 +1,45 @@
 #include "utils.h"
-#include "benchmark.h"
+#include "exceptions.h"
+#include "profiler.h"
 #include <curl/curl.h>
 #include <string>
 #include <iostream>
 
+CurlGlobal::CurlGlobal() {
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        throw APIException("Failed to initialize CURL");
+    }
+}
+
+CurlGlobal::~CurlGlobal() {
+    curl_global_cleanup();
+}
+
 // Static callback function (internal use only, not in header)
 static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     ((std::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
 }
 
+// One easy handle per thread, reset between requests. Reset keeps the
+// handle's connection and DNS caches, so repeated calls reuse connections.
+namespace {
+struct CurlHandle {
+    CURL* handle = curl_easy_init();
+    ~CurlHandle() { if (handle) curl_easy_cleanup(handle); }
+};
+} // namespace
+
 std::string http_get(const std::string& url) {
-    BENCHMARK("HTTP API Request");
+    PROFILE_ZONE("HTTP API Request");
     
-    CURL* curl;
+    thread_local CurlHandle cached;
+    CURL* curl = cached.handle;
     CURLcode res;
     std::string readBuffer;
 
-    curl = curl_easy_init();
     if (curl) {
+        curl_easy_reset(curl);
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
         curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
@@ -27,12 +48,15 @@ std::string http_get(const std::string& url) {
         if (res != CURLE_OK) {
             std::cerr << "❌ curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
         }
-        
-        curl_easy_cleanup(curl);
     }
     else {
         std::cerr << "❌ Failed to initialize CURL.\n";
     }
 
     return readBuffer;
-}
\ No newline at end of file
+}
+
+std::string historical_price_url(const std::string& symbol, const std::string& api_key) {
+    return "https://financialmodelingprep.com/api/v3/historical-price-full/" + symbol +
+           "?serietype=line&apikey=" + api_key;
+}
@@ -3,6 +3,32 @@
 
 #include <string>
 
+// curl_global_init(CURL_GLOBAL_DEFAULT) for the lifetime of the object,
+// paired with curl_global_cleanup. Create one at the top of main, before any
+// thread makes a request; throws APIException when initialization fails.
+class CurlGlobal {
+public:
+    CurlGlobal();
+    ~CurlGlobal();
+    CurlGlobal(const CurlGlobal&) = delete;
+    CurlGlobal& operator=(const CurlGlobal&) = delete;
+};
+
 std::string http_get(const std::string& url);
 
+// Ticker symbols are 1-15 characters of [A-Za-z0-9.-]. They become file
+// names and URL path segments, so anything else is rejected, not escaped.
+// Inline so modules built without curl (memo, store) can check paths too.
+inline bool is_valid_symbol(const std::string& symbol) {
+    if (symbol.empty() || symbol.size() > 15) return false;
+    for (char c : symbol) {
+        bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '.' || c == '-';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// financialmodelingprep historical-price-full endpoint for `symbol`
+std::string historical_price_url(const std::string& symbol, const std::string& api_key);
+
 #endif // UTILS_H
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "walk_forward.h"
+#include "exceptions.h"
+#include "profiler.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+std::vector<FoldWindow> make_folds(size_t bars, const WalkForwardOptions& options) {
+    if (options.train_bars == 0 || options.test_bars == 0) {
+        throw CalculationException("Walk-forward train and test windows must be non-empty");
+    }
+    size_t step = options.step_bars > 0 ? options.step_bars : options.test_bars;
+
+    std::vector<FoldWindow> folds;
+    for (size_t offset = 0; offset + options.train_bars + options.test_bars <= bars; offset += step) {
+        FoldWindow w;
+        w.train_begin = options.mode == WindowMode::Anchored ? 0 : offset;
+        w.train_end = offset + options.train_bars;
+        w.test_begin = w.train_end;
+        w.test_end = w.test_begin + options.test_bars;
+        folds.push_back(w);
+    }
+    return folds;
+}
+
+WalkForwardReport walk_forward(Span<const double> prices, const WalkForwardOptions& options) {
+    PROFILE_ZONE("Walk Forward");
+    auto start = std::chrono::steady_clock::now();
+
+    WalkForwardReport report;
+    auto windows = make_folds(prices.size(), options);
+    if (windows.empty()) {
+        throw CalculationException("Series of " + std::to_string(prices.size()) +
+                                   " bars is too short for one walk-forward fold");
+    }
+    report.folds.resize(windows.size());
+
+    // One cache and one fingerprint for the whole run: each indicator period
+    // is computed once on the full series and every fold reads a slice of it
+    IndicatorCache cache;
+    uint64_t series_id = series_fingerprint(prices);
+
+    auto run_fold = [&](size_t k) {
+        PROFILE_ZONE("Fold");
+        const FoldWindow& w = windows[k];
+        FoldResult& fold = report.folds[k];
+        fold.window = w;
+
+        GeneticOptimizer optimizer(options.population, options.generations, 0.1, 0.2,
+                                   options.seed + static_cast<unsigned int>(k), 1);
+        optimizer.set_verbose(false);
+        auto train_fitness = [&](Span<const double> p, const StrategyParameters& params,
+                                 IndicatorCache& c) {
+            return backtest_window(p, params, c, series_id, w.train_begin, w.train_end).fitness;
+        };
+        OptimizationResult best = optimizer.optimize(prices, train_fitness, cache);
+
+        fold.params = best.best_params;
+        fold.train_fitness = best.best_fitness;
+        fold.test = backtest_window(prices, best.best_params, cache, series_id, w.test_begin, w.test_end);
+    };
+
+    ThreadPool pool(options.threads > 0 ? options.threads : std::thread::hardware_concurrency());
+    pool.parallel_for(windows.size(), run_fold);
+
+    // Aggregate in fold order so the report does not depend on scheduling
+    double total_return = 0.0;
+    for (const FoldResult& fold : report.folds) {
+        report.mean_train_fitness += fold.train_fitness;
+        report.mean_test_fitness += fold.test.fitness;
+        report.oos_triggers += fold.test.triggers;
+        report.oos_successes += fold.test.successes;
+        total_return += fold.test.total_return;
+        if (fold.test.total_return > 0.0) ++report.profitable_folds;
+    }
+    report.mean_train_fitness /= report.folds.size();
+    report.mean_test_fitness /= report.folds.size();
+    if (report.oos_triggers > 0) {
+        double win_rate = static_cast<double>(report.oos_successes) / report.oos_triggers;
+        report.oos_win_rate = win_rate * 100.0;
+        report.oos_avg_return = total_return / report.oos_triggers;
+        report.oos_fitness = win_rate * 100.0 + report.oos_avg_return * 1000.0;
+    }
+
+    report.cache = cache.stats();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void print_walk_forward(const WalkForwardReport& report, std::ostream& out) {
+    out << "\n🚶 Walk-Forward Results (" << report.folds.size() << " folds)\n";
+    out << std::setw(5) << "fold" << std::setw(16) << "train" << std::setw(16) << "test"
+        << std::setw(5) << "MA" << std::setw(5) << "RSI" << std::setw(7) << "thr"
+        << std::setw(10) << "IS fit" << std::setw(10) << "OOS fit" << std::setw(7) << "trades"
+        << std::setw(8) << "win %" << "\n";
+
+    out << std::fixed;
+    for (size_t k = 0; k < report.folds.size(); ++k) {
+        const FoldResult& f = report.folds[k];
+        std::string train = std::to_string(f.window.train_begin) + "-" + std::to_string(f.window.train_end);
+        std::string test = std::to_string(f.window.test_begin) + "-" + std::to_string(f.window.test_end);
+        out << std::setw(5) << k << std::setw(16) << train << std::setw(16) << test
+            << std::setw(5) << f.params.ma_period << std::setw(5) << f.params.rsi_period
+            << std::setw(7) << std::setprecision(1) << f.params.rsi_threshold
+            << std::setw(10) << std::setprecision(2) << f.train_fitness
+            << std::setw(10) << f.test.fitness << std::setw(7) << f.test.triggers
+            << std::setw(8) << std::setprecision(1) << f.test.win_rate << "\n";
+    }
+
+    out << std::setprecision(2);
+    out << "\n📊 Out-of-sample aggregate:\n";
+    out << "  Trades: " << report.oos_triggers << " (" << report.oos_successes << " take-profit)\n";
+    out << "  Win Rate: " << report.oos_win_rate << "%\n";
+    out << "  Avg Return/Trade: " << report.oos_avg_return * 100.0 << "%\n";
+    out << "  Pooled OOS Fitness: " << report.oos_fitness << "\n";
+    out << "  Mean IS / OOS Fitness: " << report.mean_train_fitness << " / " << report.mean_test_fitness << "\n";
+    out << "  Profitable Folds: " << report.profitable_folds << "/" << report.folds.size() << "\n";
+    out << "  Indicator arrays computed: " << report.cache.misses << " (" << report.cache.hits << " reuses)\n";
+    out << "  Time: " << report.seconds << " s\n";
+}
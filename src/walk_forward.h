@@ -0,0 +1,66 @@
+#ifndef WALK_FORWARD_H
+#define WALK_FORWARD_H
+
+#include <iosfwd>
+#include <vector>
+#include <cstddef>
+#include "optimizer.h"
+
+// Rolling: fixed-length train window slides forward by `step_bars`.
+// Anchored: every train window starts at bar 0 and grows by `step_bars`.
+enum class WindowMode { Rolling, Anchored };
+
+struct WalkForwardOptions {
+    WindowMode mode = WindowMode::Rolling;
+    size_t train_bars = 1000;
+    size_t test_bars = 250;
+    size_t step_bars = 0;      // 0 steps by test_bars (back-to-back test windows)
+    size_t threads = 0;        // folds optimized side by side; 0 = hardware
+    size_t population = 30;
+    int generations = 50;
+    unsigned int seed = 42;    // fold k uses seed + k
+};
+
+struct FoldWindow {
+    size_t train_begin;
+    size_t train_end;
+    size_t test_begin;
+    size_t test_end;
+};
+
+struct FoldResult {
+    FoldWindow window;
+    StrategyParameters params;
+    double train_fitness = 0.0;   // in-sample GA fitness
+    BacktestResult test{-1000.0, 0.0, 0, 0};  // out-of-sample result of `params`
+};
+
+struct WalkForwardReport {
+    std::vector<FoldResult> folds;
+    // Out-of-sample trades pooled across every fold
+    size_t oos_triggers = 0;
+    size_t oos_successes = 0;
+    double oos_win_rate = 0.0;      // percent
+    double oos_avg_return = 0.0;    // per trade
+    double oos_fitness = -100.0;    // backtest fitness of the pooled trades
+    double mean_train_fitness = 0.0;
+    double mean_test_fitness = 0.0;
+    size_t profitable_folds = 0;    // folds with positive out-of-sample return
+    double seconds = 0.0;
+    CacheStats cache;
+};
+
+// Train/test windows that fit inside `bars`; only full test windows are used.
+// Throws CalculationException for zero-length windows.
+std::vector<FoldWindow> make_folds(size_t bars, const WalkForwardOptions& options);
+
+// Optimizes each train window with its own GA (folds run in parallel) and
+// evaluates the winner on the following test window. Every fold reads the
+// same full-series indicator arrays from one shared IndicatorCache. Results
+// are identical for any thread count. Throws CalculationException when no
+// fold fits.
+WalkForwardReport walk_forward(Span<const double> prices, const WalkForwardOptions& options);
+
+void print_walk_forward(const WalkForwardReport& report, std::ostream& out);
+
+#endif // WALK_FORWARD_H
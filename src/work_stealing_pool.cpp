@@ -0,0 +1,149 @@
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <numeric>
+
+WorkStealingPool::WorkStealingPool(size_t num_threads)
+    : thread_count(num_threads == 0 ? 1 : num_threads), queues(thread_count) {}
+
+WorkStealingPool::~WorkStealingPool() {
+    join_workers();
+}
+
+void WorkStealingPool::push(size_t worker, size_t task, double cost) {
+    WorkerQueue& queue = queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+    queue.costs.push_back(cost);
+    queue.queued_cost += cost;
+}
+
+bool WorkStealingPool::pop_local(WorkerQueue& queue, size_t& task) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.front();
+    queue.queued_cost -= queue.costs.front();
+    queue.tasks.pop_front();
+    queue.costs.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, size_t& task) {
+    for (size_t offset = 1; offset < thread_count; ++offset) {
+        WorkerQueue& victim = queues[(thief + offset) % thread_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.queued_cost -= victim.costs.back();
+            victim.tasks.pop_back();
+            victim.costs.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::next_task(size_t id, size_t& task) {
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        task_ready.wait(lock, [&] { return available > 0 || closed; });
+        if (available == 0) return false;
+        --available;
+    }
+    // A claimed task is already in some deque, since push happens before
+    // available is raised; only claimants pop, so the search terminates
+    while (true) {
+        if (pop_local(queues[id], task)) return true;
+        if (steal(id, task)) {
+            ++steal_total;
+            return true;
+        }
+    }
+}
+
+void WorkStealingPool::worker_loop(size_t id) {
+    size_t task;
+    while (next_task(id, task)) {
+        try {
+            task_fn(task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!first_error) first_error = std::current_exception();
+        }
+    }
+}
+
+void WorkStealingPool::join_workers() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        closed = true;
+    }
+    task_ready.notify_all();
+    for (auto& t : threads) t.join();
+    threads.clear();
+}
+
+void WorkStealingPool::run(const std::vector<double>& costs, const std::function<void(size_t)>& fn) {
+    // Deal tasks largest-first in a snake order so each worker starts with a
+    // similar total cost
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return costs[a] > costs[b]; });
+    for (size_t k = 0; k < order.size(); ++k) {
+        size_t round = k / thread_count, slot = k % thread_count;
+        size_t worker = round % 2 == 0 ? slot : thread_count - 1 - slot;
+        push(worker, order[k], costs[order[k]]);
+    }
+
+    task_fn = fn;
+    steal_total = 0;
+    first_error = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        available = order.size();
+        closed = true;
+    }
+    for (size_t id = 1; id < thread_count; ++id) {
+        threads.emplace_back(&WorkStealingPool::worker_loop, this, id);
+    }
+    worker_loop(0);
+    finish();
+}
+
+void WorkStealingPool::start(std::function<void(size_t)> fn) {
+    task_fn = std::move(fn);
+    steal_total = 0;
+    first_error = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        available = 0;
+        closed = false;
+    }
+    for (size_t id = 0; id < thread_count; ++id) {
+        threads.emplace_back(&WorkStealingPool::worker_loop, this, id);
+    }
+}
+
+void WorkStealingPool::submit(size_t task, double cost) {
+    // Place on the worker with the least work queued; ties go to the lowest id
+    size_t target = 0;
+    double least = 0.0;
+    for (size_t id = 0; id < thread_count; ++id) {
+        std::lock_guard<std::mutex> lock(queues[id].mutex);
+        if (id == 0 || queues[id].queued_cost < least) {
+            least = queues[id].queued_cost;
+            target = id;
+        }
+    }
+    push(target, task, cost);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        ++available;
+    }
+    task_ready.notify_one();
+}
+
+void WorkStealingPool::finish() {
+    join_workers();
+    steal_count = steal_total.load();
+    if (first_error) std::rethrow_exception(first_error);
+}
@@ -0,0 +1,76 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <cstddef>
+
+// Runs independent tasks of very uneven size across threads. Each worker
+// drains its own deque from the front and, once empty, steals from the back
+// of other workers' deques, so long and short jobs balance without a central
+// queue.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t num_threads);
+    // Closes and joins a pool left running by start()
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Runs fn(i) for every i in [0, costs.size()), where costs[i] is a
+    // relative size estimate used for the initial placement: tasks are dealt
+    // largest-first. Blocks until every task finished; the first exception
+    // thrown is rethrown here.
+    void run(const std::vector<double>& costs, const std::function<void(size_t)>& fn);
+
+    // Streaming form for tasks that become ready one at a time: start()
+    // launches the workers, submit() places a task on the worker with the
+    // least queued cost (idle workers steal it if that one is busy), and
+    // finish() waits for every submitted task and rethrows the first error.
+    void start(std::function<void(size_t)> fn);
+    void submit(size_t task, double cost);
+    void finish();
+
+    size_t size() const { return thread_count; }
+    size_t steals() const { return steal_count; }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+        std::deque<double> costs;
+        double queued_cost = 0.0;
+    };
+
+    void push(size_t worker, size_t task, double cost);
+    bool pop_local(WorkerQueue& queue, size_t& task);
+    bool steal(size_t thief, size_t& task);
+    bool next_task(size_t id, size_t& task);
+    void worker_loop(size_t id);
+    void join_workers();
+
+    size_t thread_count;
+    std::vector<WorkerQueue> queues;
+    std::function<void(size_t)> task_fn;
+    std::vector<std::thread> threads;
+
+    // available counts tasks pushed but not yet claimed by a worker
+    std::mutex state_mutex;
+    std::condition_variable task_ready;
+    size_t available = 0;
+    bool closed = false;
+
+    std::atomic<size_t> steal_total{0};
+    size_t steal_count = 0;
+    std::mutex error_mutex;
+    std::exception_ptr first_error;
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,111 @@
+#ifndef LOCAL_HTTP_SERVER_H
+#define LOCAL_HTTP_SERVER_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Minimal HTTP/1.1 keep-alive server on 127.0.0.1 for offline tests.
+// `handler(path, status)` returns the body for each GET and sets the status.
+class LocalHttpServer {
+public:
+    using Handler = std::function<std::string(const std::string& path, int& status)>;
+
+    explicit LocalHttpServer(Handler h) : handler(std::move(h)) {
+        listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listen_fd, 64);
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        acceptor = std::thread([this] { accept_loop(); });
+    }
+
+    ~LocalHttpServer() {
+        stopping = true;
+        acceptor.join();
+        for (auto& t : connections) t.join();
+        ::close(listen_fd);
+    }
+
+    std::string url(const std::string& path) const {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+    size_t requests() const { return request_count.load(); }
+    size_t connections_opened() const { return connection_count.load(); }
+    size_t peak_concurrent_connections() const { return peak_open.load(); }
+
+private:
+    void accept_loop() {
+        while (!stopping) {
+            pollfd pfd{listen_fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 50) <= 0) continue;
+            int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd < 0) continue;
+            connection_count++;
+            size_t now_open = ++open_count;
+            size_t peak = peak_open.load();
+            while (now_open > peak && !peak_open.compare_exchange_weak(peak, now_open)) {}
+            connections.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        std::string buffer;
+        char chunk[4096];
+        while (!stopping) {
+            size_t header_end = buffer.find("\r\n\r\n");
+            if (header_end == std::string::npos) {
+                pollfd pfd{fd, POLLIN, 0};
+                if (::poll(&pfd, 1, 50) <= 0) continue;
+                ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) break;
+                buffer.append(chunk, static_cast<size_t>(n));
+                continue;
+            }
+
+            std::string request_line = buffer.substr(0, buffer.find("\r\n"));
+            buffer.erase(0, header_end + 4);
+            size_t path_start = request_line.find(' ') + 1;
+            std::string path = request_line.substr(path_start, request_line.find(' ', path_start) - path_start);
+
+            request_count++;
+            int status = 200;
+            std::string body = handler(path, status);
+            std::string response = "HTTP/1.1 " + std::to_string(status) + (status == 200 ? " OK" : " Error") +
+                                   "\r\nContent-Type: application/json\r\nContent-Length: " +
+                                   std::to_string(body.size()) + "\r\n\r\n" + body;
+            if (::send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) break;
+        }
+        --open_count;
+        ::close(fd);
+    }
+
+    Handler handler;
+    int listen_fd = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> request_count{0};
+    std::atomic<size_t> connection_count{0};
+    std::atomic<size_t> open_count{0};
+    std::atomic<size_t> peak_open{0};
+    std::thread acceptor;
+    std::vector<std::thread> connections;
+};
+
+#endif // LOCAL_HTTP_SERVER_H
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "backtest_workspace.h"
+#include "indicators.h"
+#include "optimizer.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+// Replaces the global allocator with one that counts calls; everything else
+// behaves as the default operator new/delete. This file builds into its own
+// test_allocations executable so no other test runs on the replacement.
+namespace {
+std::atomic<size_t> allocation_count{0};
+}
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+template <typename Fn>
+size_t count_allocations(Fn fn) {
+    size_t before = allocation_count.load(std::memory_order_relaxed);
+    fn();
+    return allocation_count.load(std::memory_order_relaxed) - before;
+}
+
+std::vector<double> wave_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(i * 0.07) + 3.0 * std::sin(i * 0.31) + 0.02 * i);
+    }
+    return prices;
+}
+
+} // namespace
+
+TEST(BacktestWorkspaceTest, OutputBuffersMatchAndReuseStorage) {
+    auto prices = wave_prices(2000);
+    std::vector<float> prices_f(prices.begin(), prices.end());
+    Span<const double> pd(prices);
+
+    std::vector<double> sma, rsi;
+    MACD macd;
+    calc_sma(pd, 50, sma);
+    calc_rsi(pd, 14, rsi);
+    calc_macd(pd, 12, 26, 9, macd);
+    auto expect_same = [](const auto& a, const auto& b) {
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::isnan(b[i])) EXPECT_TRUE(std::isnan(a[i]));
+            else EXPECT_EQ(a[i], b[i]) << "at " << i;
+        }
+    };
+    expect_same(sma, calc_sma(prices, 50));
+    expect_same(rsi, calc_rsi(prices, 14));
+    expect_same(macd.macd, calc_macd(prices).macd);
+    expect_same(macd.signal, calc_macd(prices).signal);
+
+    EXPECT_GT(count_allocations([&] { calc_sma(pd, 50); }), 0u);  // the counter is live
+
+    // Same or shorter inputs reuse the buffers in place
+    const double* sma_data = sma.data();
+    EXPECT_EQ(count_allocations([&] {
+        calc_sma(pd, 200, sma);
+        calc_rsi(Span<const double>(prices.data(), 1500), 20, rsi);
+        calc_macd(pd, 5, 35, 5, macd);
+    }), 0u);
+    EXPECT_EQ(sma.data(), sma_data);
+    EXPECT_EQ(rsi.size(), 1500u);
+
+    std::vector<float> sma_f;
+    calc_sma(Span<const float>(prices_f), 50, sma_f);
+    expect_same(sma_f, calc_sma(prices_f, 50));
+}
+
+TEST(BacktestWorkspaceTest, SteadyStateBacktestsDoNotAllocate) {
+    auto prices = wave_prices(3000);
+    Span<const double> pd(prices);
+    std::vector<float> prices_f(prices.begin(), prices.end());
+    Span<const float> pf(prices_f);
+    IndicatorCache cache;
+
+    std::mt19937 gen(3);
+    std::vector<StrategyParameters> sets;
+    for (int k = 0; k < 20; ++k) sets.push_back(StrategyParameters::random(gen));
+
+    // The first pass grows the workspace and fills the cache
+    std::vector<BacktestResult> warm;
+    for (const auto& params : sets) {
+        warm.push_back(backtest_detailed(prices, params));
+        warm.push_back(backtest_detailed(prices, params, cache));
+        warm.push_back(backtest_detailed_f32(prices, params, cache));
+        warm.push_back(backtest_arrays(pd, params));
+        warm.push_back(backtest_arrays(pf, params));
+    }
+
+    std::vector<BacktestResult> steady;
+    steady.reserve(warm.size());
+    size_t allocations = count_allocations([&] {
+        for (const auto& params : sets) {
+            steady.push_back(backtest_detailed(prices, params));
+            steady.push_back(backtest_detailed(prices, params, cache));
+            steady.push_back(backtest_detailed_f32(prices, params, cache));
+            steady.push_back(backtest_arrays(pd, params));
+            steady.push_back(backtest_arrays(pf, params));
+        }
+    });
+    EXPECT_EQ(allocations, 0u);
+
+    ASSERT_EQ(steady.size(), warm.size());
+    for (size_t i = 0; i < warm.size(); ++i) {
+        EXPECT_EQ(steady[i].fitness, warm[i].fitness);
+        EXPECT_EQ(steady[i].triggers, warm[i].triggers);
+    }
+    for (size_t i = 0; i < warm.size(); i += 5) {
+        EXPECT_EQ(warm[i].fitness, warm[i + 1].fitness);   // fused == cached
+        EXPECT_EQ(warm[i].fitness, warm[i + 3].fitness);   // fused == double arrays
+    }
+}
+
+TEST(BacktestWorkspaceTest, ExplicitWorkspaceIsReserved) {
+    auto prices = wave_prices(2500);
+    Span<const double> pd(prices);
+    BacktestWorkspace workspace;
+    workspace.reserve(prices.size());
+
+    // Reserved up front: even the first evaluation allocates nothing
+    BacktestResult result;
+    EXPECT_EQ(count_allocations([&] { result = backtest_arrays(pd, StrategyParameters{}, workspace); }), 0u);
+    EXPECT_EQ(result.fitness, backtest_detailed(prices, StrategyParameters{}).fitness);
+}
+
+TEST(BacktestWorkspaceTest, GAEvaluationsDoNotAllocateOnceWarm) {
+    auto prices = wave_prices(3000);
+    IndicatorCache cache;
+    uint64_t id = series_fingerprint(prices);
+    // Every SMA and RSI period the GA can draw
+    StrategyParameters params;
+    for (int ma = 50; ma <= 300; ++ma) {
+        params.ma_period = ma;
+        params.rsi_period = 10 + ma % 11;
+        prefetch_indicators(prices, params, cache, id);
+    }
+    BacktestWorkspace::for_thread().reserve(prices.size());
+
+    size_t evaluations = 0, evaluation_allocations = 0;
+    CachedFitnessFunction counted = [&](Span<const double> series, const StrategyParameters& p,
+                                        IndicatorCache& c) {
+        double fitness = 0.0;
+        evaluation_allocations += count_allocations([&] { fitness = cached_backtest_fitness(series, p, c); });
+        ++evaluations;
+        return fitness;
+    };
+
+    GeneticOptimizer optimizer(20, 6, 0.1, 0.2, 17, 1);
+    optimizer.set_verbose(false);
+    optimizer.optimize(prices, counted, cache);
+    EXPECT_EQ(evaluations, 20u * 6u);
+    EXPECT_EQ(evaluation_allocations, 0u);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "batch_fetcher.h"
+#include "local_http_server.h"
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+std::string canned_history(const std::string& symbol) {
+    return "{\"symbol\":\"" + symbol + "\",\"historical\":[{\"date\":\"2024-01-02\",\"close\":1.0}]}";
+}
+
+LocalHttpServer::Handler canned_handler() {
+    return [](const std::string& path, int& status) -> std::string {
+        // /historical-price-full/<SYMBOL>?...
+        std::string symbol = path.substr(path.rfind('/') + 1);
+        symbol = symbol.substr(0, symbol.find('?'));
+        if (symbol == "MISSING") {
+            status = 404;
+            return "{}";
+        }
+        return canned_history(symbol);
+    };
+}
+
+std::vector<std::string> symbol_urls(const LocalHttpServer& server, size_t count) {
+    std::vector<std::string> urls;
+    for (size_t i = 0; i < count; ++i) {
+        urls.push_back(server.url("/historical-price-full/SYM" + std::to_string(i) + "?apikey=secret"));
+    }
+    return urls;
+}
+
+class BatchFetcherTest : public ::testing::Test {
+protected:
+    std::string cache_dir;
+
+    void SetUp() override {
+        cache_dir = "/tmp/algo_trader_fetch_" + std::to_string(::getpid());
+        std::filesystem::remove_all(cache_dir);
+    }
+    void TearDown() override { std::filesystem::remove_all(cache_dir); }
+};
+
+} // namespace
+
+TEST_F(BatchFetcherTest, FetchesAllUrlsInOrderWithBoundedConnections) {
+    LocalHttpServer server(canned_handler());
+    auto urls = symbol_urls(server, 24);
+
+    FetchOptions options;
+    options.max_in_flight = 4;
+    auto results = fetch_all(urls, options);
+
+    ASSERT_EQ(results.size(), urls.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_TRUE(results[i].ok()) << results[i].error;
+        EXPECT_EQ(results[i].status, 200);
+        EXPECT_EQ(results[i].body, canned_history("SYM" + std::to_string(i)));
+    }
+    EXPECT_EQ(server.requests(), 24u);
+    // Keep-alive reuse: never more connections than transfer slots
+    EXPECT_LE(server.connections_opened(), 4u);
+    EXPECT_LE(server.peak_concurrent_connections(), 4u);
+}
+
+TEST_F(BatchFetcherTest, CacheSkipsNetworkOnRepeatRuns) {
+    LocalHttpServer server(canned_handler());
+    auto urls = symbol_urls(server, 6);
+
+    FetchOptions options;
+    options.cache_dir = cache_dir;
+    fetch_all(urls, options);
+    EXPECT_EQ(server.requests(), 6u);
+
+    auto cached = fetch_all(urls, options);
+    EXPECT_EQ(server.requests(), 6u);
+    for (size_t i = 0; i < cached.size(); ++i) {
+        EXPECT_TRUE(cached[i].from_cache);
+        EXPECT_EQ(cached[i].body, canned_history("SYM" + std::to_string(i)));
+    }
+
+    // Expired entries are refetched
+    options.cache_ttl = std::chrono::seconds(-1);
+    fetch_all(urls, options);
+    EXPECT_EQ(server.requests(), 12u);
+}
+
+TEST_F(BatchFetcherTest, HandsOffResultsInCompletionOrder) {
+    LocalHttpServer server([](const std::string& path, int& status) -> std::string {
+        if (path.find("/SLOW") != std::string::npos) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
+        status = 200;
+        return canned_history(path.substr(path.rfind('/') + 1));
+    });
+    std::vector<std::string> urls = {server.url("/h/SLOW"), server.url("/h/A"), server.url("/h/B"),
+                                     server.url("/h/C")};
+
+    FetchOptions options;
+    options.max_in_flight = 4;
+    std::vector<size_t> order;
+    fetch_each(urls, options, [&](size_t index, FetchResult&& result) {
+        EXPECT_TRUE(result.ok()) << result.error;
+        EXPECT_EQ(result.url, urls[index]);
+        order.push_back(index);
+    });
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order.back(), 0u);  // the slow download does not hold back the others
+}
+
+TEST_F(BatchFetcherTest, CacheOnlyNeverTouchesNetwork) {
+    LocalHttpServer server(canned_handler());
+    auto urls = symbol_urls(server, 3);
+
+    FetchOptions options;
+    options.cache_dir = cache_dir;
+    fetch_all({urls[0], urls[1]}, options);
+    EXPECT_EQ(server.requests(), 2u);
+
+    options.cache_only = true;
+    auto results = fetch_all(urls, options);
+    EXPECT_EQ(server.requests(), 2u);
+    EXPECT_TRUE(results[0].from_cache);
+    EXPECT_TRUE(results[1].from_cache);
+    EXPECT_FALSE(results[2].ok());
+    EXPECT_EQ(results[2].status, 0);
+}
+
+TEST_F(BatchFetcherTest, CacheKeyIgnoresApiKey) {
+    EXPECT_EQ(ResponseCache::key_for("http://h/p/AAPL?serietype=line&apikey=one"),
+              ResponseCache::key_for("http://h/p/AAPL?serietype=line&apikey=two"));
+    EXPECT_NE(ResponseCache::key_for("http://h/p/AAPL?apikey=one"),
+              ResponseCache::key_for("http://h/p/MSFT?apikey=one"));
+}
+
+TEST_F(BatchFetcherTest, ReportsHttpErrorsWithoutCaching) {
+    LocalHttpServer server(canned_handler());
+    FetchOptions options;
+    options.cache_dir = cache_dir;
+
+    auto results = fetch_all({server.url("/historical-price-full/MISSING"),
+                              server.url("/historical-price-full/AAPL")}, options);
+    EXPECT_FALSE(results[0].ok());
+    EXPECT_EQ(results[0].status, 404);
+    EXPECT_TRUE(results[1].ok());
+
+    fetch_all({server.url("/historical-price-full/MISSING")}, options);
+    EXPECT_EQ(server.requests(), 3u);
+}
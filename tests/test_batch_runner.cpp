@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "batch_runner.h"
+#include "work_stealing_pool.h"
+#include "price_store.h"
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+PriceSeries wave_series(const std::string& symbol, size_t count, double phase) {
+    PriceSeries series;
+    series.symbol = symbol;
+    for (size_t i = 0; i < count; ++i) {
+        double close = 100.0 + 6.0 * std::sin(i * 0.09 + phase) + 2.5 * std::sin(i * 0.37) +
+                       1.5 * std::sin(i * 1.71 + phase) + 0.03 * i;
+        series.dates.push_back(static_cast<int64_t>(i) * 86400);
+        series.open.push_back(close);
+        series.high.push_back(close);
+        series.low.push_back(close);
+        series.close.push_back(close);
+        series.volume.push_back(0.0);
+    }
+    return series;
+}
+
+} // namespace
+
+TEST(WorkStealingPoolTest, RunsEveryTaskOnceWithUnevenCosts) {
+    WorkStealingPool pool(4);
+    std::vector<double> costs;
+    for (int i = 0; i < 200; ++i) costs.push_back(i % 17 == 0 ? 1000.0 : 1.0);
+
+    std::vector<std::atomic<int>> runs(costs.size());
+    pool.run(costs, [&](size_t i) { runs[i]++; });
+    for (auto& r : runs) EXPECT_EQ(r.load(), 1);
+}
+
+TEST(WorkStealingPoolTest, RunsStreamedTasksOnceAndRethrows) {
+    WorkStealingPool pool(3);
+    std::vector<std::atomic<int>> runs(100);
+    pool.start([&](size_t i) {
+        runs[i]++;
+        if (i == 42) throw std::runtime_error("task 42");
+    });
+    for (size_t i = 0; i < runs.size(); ++i) pool.submit(i, i % 9 == 0 ? 500.0 : 1.0);
+    EXPECT_THROW(pool.finish(), std::runtime_error);
+    for (auto& r : runs) EXPECT_EQ(r.load(), 1);
+}
+
+TEST(BatchRunnerTest, BacktestsEverySymbolFromLocalStores) {
+    std::string dir = "/tmp/algo_trader_batch_" + std::to_string(::getpid());
+    std::filesystem::create_directories(dir);
+
+    DataSourceConfig source;
+    source.store_dir = dir;
+    std::vector<std::string> symbols = {"AAA", "BBB", "CCC", "SHORT", "MISSING", "../CCC"};
+    std::vector<PriceSeries> series = {wave_series("AAA", 3000, 0.0), wave_series("BBB", 800, 1.0),
+                                       wave_series("CCC", 5000, 2.0), wave_series("SHORT", 100, 0.5)};
+    for (const auto& s : series) write_price_store(source.store_path(s.symbol), s);
+
+    BatchOptions options;
+    options.threads = 3;
+    BatchReport report = run_batch(symbols, source, options);
+
+    ASSERT_EQ(report.symbols.size(), symbols.size());
+    EXPECT_EQ(report.succeeded(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        const SymbolReport& r = report.symbols[i];
+        EXPECT_EQ(r.symbol, symbols[i]);
+        EXPECT_TRUE(r.ok()) << r.error;
+        BacktestResult expected = backtest_detailed(series[i].close, options.params);
+        EXPECT_EQ(r.backtest.triggers, expected.triggers);
+        EXPECT_DOUBLE_EQ(r.backtest.fitness, expected.fitness);
+    }
+    EXPECT_FALSE(report.symbols[3].ok());   // too short
+    EXPECT_FALSE(report.symbols[4].ok());   // no store, no API key
+    EXPECT_NE(report.symbols[5].error.find("Invalid symbol"), std::string::npos);  // path escape
+    EXPECT_EQ(report.total_bars(), 3000u + 800u + 5000u + 100u);
+
+    std::ostringstream csv;
+    write_batch_csv(report, csv);
+    EXPECT_NE(csv.str().find("\nCCC,5000,"), std::string::npos);
+
+    std::filesystem::remove_all(dir);
+}
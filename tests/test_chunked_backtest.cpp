@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "chunked_backtest.h"
+#include "price_store.h"
+#include "optimizer.h"
+#include "exceptions.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return "/tmp/algo_trader_" + std::to_string(::getpid()) + "_" + name;
+}
+
+std::vector<double> random_walk(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> step(0.0, 0.012);
+    std::vector<double> prices;
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        price *= std::exp(step(gen));
+        prices.push_back(price);
+    }
+    return prices;
+}
+
+PriceSeries closes_only(const std::vector<double>& closes) {
+    PriceSeries series;
+    series.symbol = "CHUNK";
+    for (size_t i = 0; i < closes.size(); ++i) {
+        series.dates.push_back(1700000000 + static_cast<int64_t>(i) * 60);
+        series.open.push_back(closes[i]);
+        series.high.push_back(closes[i] * 1.001);
+        series.low.push_back(closes[i] * 0.999);
+        series.close.push_back(closes[i]);
+        series.volume.push_back(static_cast<double>(i));
+    }
+    return series;
+}
+
+void expect_same_result(const BacktestResult& a, const BacktestResult& b, const std::string& label) {
+    EXPECT_EQ(a.fitness, b.fitness) << label;
+    EXPECT_EQ(a.triggers, b.triggers) << label;
+    EXPECT_EQ(a.successes, b.successes) << label;
+    EXPECT_EQ(a.total_return, b.total_return) << label;
+}
+
+} // namespace
+
+TEST(ChunkedBacktestTest, MatchesInMemoryForAnyChunkSize) {
+    auto prices = random_walk(6000, 3);
+    std::mt19937 gen(8);
+    for (int k = 0; k < 12; ++k) {
+        StrategyParameters params = StrategyParameters::random(gen);
+        BacktestResult expected = backtest_detailed(prices, params);
+        ASSERT_GT(expected.triggers, 0u);
+        // Chunks shorter than the SMA window and the look-ahead, odd sizes, one block
+        for (size_t chunk : std::vector<size_t>{1, 7, 29, 250, 4096, prices.size()}) {
+            expect_same_result(backtest_chunked(Span<const double>(prices), params, chunk), expected,
+                               "chunk " + std::to_string(chunk));
+        }
+    }
+}
+
+TEST(ChunkedBacktestTest, StoreFileMatchesInMemory) {
+    auto prices = random_walk(20000, 11);
+    std::string path = temp_path("chunked.atps");
+    write_price_store(path, closes_only(prices));
+
+    PriceStoreColumnReader reader(path);
+    EXPECT_EQ(reader.symbol(), "CHUNK");
+    EXPECT_EQ(reader.size(), prices.size());
+    std::vector<double> block, read_back;
+    while (reader.read(block, 3000) > 0) read_back.insert(read_back.end(), block.begin(), block.end());
+    EXPECT_EQ(read_back, prices);
+    EXPECT_EQ(reader.read(block, 3000), 0u);
+    EXPECT_TRUE(block.empty());
+
+    MappedPriceStore mapped(path);
+    std::mt19937 gen(5);
+    for (int k = 0; k < 6; ++k) {
+        StrategyParameters params = StrategyParameters::random(gen);
+        BacktestResult expected = backtest_detailed(prices, params);
+        expect_same_result(backtest_chunked(path, params, 1024), expected, "store file");
+        expect_same_result(backtest_chunked(mapped.close(), params, 1024), expected, "mapped store");
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ChunkedBacktestTest, BoundedStateAndEdgeCases) {
+    auto prices = random_walk(3000, 21);
+    StrategyParameters params;
+    params.look_ahead = 20;
+    ChunkedBacktest backtest(params, prices.size());
+    size_t max_open = 0;
+    for (size_t i = 0; i < prices.size(); i += 100) {
+        backtest.feed(Span<const double>(prices.data() + i, 100));
+        max_open = std::max(max_open, backtest.open_trades());
+    }
+    EXPECT_LE(max_open, static_cast<size_t>(params.look_ahead));
+    EXPECT_EQ(backtest.open_trades(), 0u);
+    expect_same_result(backtest.finish(), backtest_detailed(prices, params), "manual feed");
+
+    // Too short for the strategy: same sentinel as the in-memory path
+    std::vector<double> short_series(prices.begin(), prices.begin() + 100);
+    expect_same_result(backtest_chunked(Span<const double>(short_series), params),
+                       backtest_detailed(short_series, params), "short series");
+
+    ChunkedBacktest partial(params, 500);
+    partial.feed(Span<const double>(prices.data(), 400));
+    EXPECT_THROW(partial.finish(), DataException);
+    EXPECT_THROW(partial.feed(Span<const double>(prices.data(), 200)), DataException);
+    EXPECT_THROW(backtest_chunked(Span<const double>(prices), params, 0), DataException);
+    EXPECT_THROW(backtest_chunked(temp_path("missing.atps"), params), DataException);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "exit_resolver.h"
+#include "exceptions.h"
+#include <vector>
+#include <random>
+#include <limits>
+
+namespace {
+
+// The sequential look-ahead loop used by backtest_detailed / backtest_strategy
+ExitOutcome scan_exit(const std::vector<double>& prices, size_t entry, double stop, double take, int look_ahead) {
+    size_t last = entry;
+    for (size_t j = entry + 1; j <= entry + look_ahead && j < prices.size(); ++j) {
+        if (prices[j] >= take) return {ExitReason::TakeProfit, j};
+        if (prices[j] <= stop) return {ExitReason::StopLoss, j};
+        last = j;
+    }
+    return {ExitReason::Expired, last};
+}
+
+std::vector<double> random_prices(std::mt19937& gen, size_t count) {
+    std::normal_distribution<> step(0.0, 0.01);
+    std::vector<double> prices;
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        price *= 1.0 + step(gen);
+        prices.push_back(price);
+    }
+    return prices;
+}
+
+} // namespace
+
+TEST(ExitResolverTest, MatchesSequentialScanOnRandomData) {
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<> pct(0.001, 0.05);
+
+    for (int max_window : {1, 5, 16, 32, 100}) {
+        auto prices = random_prices(gen, 3000);
+        ExitResolver resolver(prices, max_window);
+        std::uniform_int_distribution<size_t> entry_dist(0, prices.size() - 1);
+        std::uniform_int_distribution<int> look_dist(1, 150);
+
+        for (int trial = 0; trial < 4000; ++trial) {
+            size_t entry = entry_dist(gen);
+            int look_ahead = look_dist(gen);
+            double stop = prices[entry] * (1.0 - pct(gen));
+            double take = prices[entry] * (1.0 + pct(gen));
+
+            ExitOutcome expected = scan_exit(prices, entry, stop, take, look_ahead);
+            ExitOutcome actual = resolver.resolve(entry, stop, take, look_ahead);
+            ASSERT_EQ(static_cast<int>(actual.reason), static_cast<int>(expected.reason))
+                << "window " << max_window << " entry " << entry << " look " << look_ahead;
+            if (expected.reason != ExitReason::Expired) {
+                ASSERT_EQ(actual.exit_index, expected.exit_index);
+            }
+        }
+    }
+}
+
+TEST(ExitResolverTest, MatchesSequentialScanWithNaNCloses) {
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<> pct(0.001, 0.05);
+    std::bernoulli_distribution gap(0.08);
+
+    for (int max_window : {1, 4, 32, 100}) {
+        auto prices = random_prices(gen, 3000);
+        for (size_t i = 1; i < prices.size(); ++i) {
+            if (gap(gen)) prices[i] = std::numeric_limits<double>::quiet_NaN();
+        }
+        ExitResolver resolver(prices, max_window);
+        std::uniform_int_distribution<size_t> entry_dist(0, prices.size() - 1);
+        std::uniform_int_distribution<int> look_dist(1, 150);
+
+        for (int trial = 0; trial < 4000; ++trial) {
+            size_t entry = entry_dist(gen);
+            int look_ahead = look_dist(gen);
+            // A NaN entry price gives NaN levels, which nothing hits
+            double stop = prices[entry] * (1.0 - pct(gen));
+            double take = prices[entry] * (1.0 + pct(gen));
+
+            ExitOutcome expected = scan_exit(prices, entry, stop, take, look_ahead);
+            ExitOutcome actual = resolver.resolve(entry, stop, take, look_ahead);
+            ASSERT_EQ(static_cast<int>(actual.reason), static_cast<int>(expected.reason))
+                << "window " << max_window << " entry " << entry << " look " << look_ahead;
+            if (expected.reason != ExitReason::Expired) {
+                ASSERT_EQ(actual.exit_index, expected.exit_index);
+            }
+        }
+    }
+}
+
+TEST(ExitResolverTest, TakeProfitWinsOnSameBar) {
+    // Bar 2 satisfies both price >= 140 and price <= 160
+    std::vector<double> prices = {100.0, 120.0, 150.0, 90.0};
+    ExitResolver resolver(prices, 4);
+    ExitOutcome outcome = resolver.resolve(1, 160.0, 140.0, 2);
+    EXPECT_EQ(outcome.reason, ExitReason::TakeProfit);
+    EXPECT_EQ(outcome.exit_index, 2u);
+}
+
+TEST(ExitResolverTest, BatchMatchesSingleQueries) {
+    std::mt19937 gen(7);
+    auto prices = random_prices(gen, 2000);
+    ExitResolver resolver(prices, 32);
+
+    std::vector<size_t> entries;
+    for (size_t i = 10; i < 1900; i += 37) entries.push_back(i);
+    std::vector<ExitLevels> levels = {{0.01, 0.02}, {0.005, 0.03}, {0.04, 0.01}};
+
+    auto batch = resolver.resolve_batch(entries, levels, 20);
+    ASSERT_EQ(batch.size(), levels.size());
+    for (size_t k = 0; k < levels.size(); ++k) {
+        for (size_t t = 0; t < entries.size(); ++t) {
+            double entry_price = prices[entries[t]];
+            ExitOutcome expected = scan_exit(prices, entries[t], entry_price * (1.0 - levels[k].stop_loss),
+                                             entry_price * (1.0 + levels[k].take_profit), 20);
+            EXPECT_EQ(batch[k][t].reason, expected.reason);
+        }
+    }
+}
+
+TEST(ExitResolverTest, InvalidWindowThrows) {
+    std::vector<double> prices = {1.0, 2.0, 3.0};
+    EXPECT_THROW(ExitResolver(prices, 0), CalculationException);
+}
+
+TEST(ExitResolverTest, EmptySeriesExpiresImmediately) {
+    std::vector<double> prices;
+    ExitResolver resolver(prices);
+    EXPECT_EQ(resolver.size(), 0u);
+    ExitOutcome outcome = resolver.resolve(0, 90.0, 110.0, 10);
+    EXPECT_EQ(outcome.reason, ExitReason::Expired);
+    EXPECT_EQ(outcome.exit_index, 0u);
+    EXPECT_TRUE(resolver.resolve_batch({}, ExitLevels{0.01, 0.02}, 10).empty());
+}
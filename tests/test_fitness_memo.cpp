@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "fitness_memo.h"
+#include "exceptions.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+std::vector<double> wave_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(i * 0.07) + 3.0 * std::sin(i * 0.31) +
+                         1.5 * std::sin(i * 1.3) + 0.02 * i);
+    }
+    return prices;
+}
+
+std::string temp_path(const std::string& name) {
+    return "/tmp/algo_trader_" + std::to_string(::getpid()) + "_" + name;
+}
+
+bool same_params(const StrategyParameters& a, const StrategyParameters& b) {
+    return a.ma_period == b.ma_period && a.rsi_period == b.rsi_period && a.rsi_threshold == b.rsi_threshold &&
+           a.stop_loss == b.stop_loss && a.take_profit == b.take_profit && a.look_ahead == b.look_ahead;
+}
+
+} // namespace
+
+TEST(FitnessMemoTest, KeysAreCanonical) {
+    FitnessMemo memo;
+    StrategyParameters params;
+    params.stop_loss = 0.0;
+    memo.store(7, params, 42.0);
+
+    StrategyParameters negative_zero = params;
+    negative_zero.stop_loss = -0.0;
+    double fitness = 0.0;
+    EXPECT_TRUE(memo.lookup(7, negative_zero, fitness));
+    EXPECT_EQ(fitness, 42.0);
+
+    EXPECT_FALSE(memo.lookup(8, params, fitness));  // other series
+    StrategyParameters nudged = params;
+    nudged.rsi_threshold = std::nextafter(params.rsi_threshold, 100.0);
+    EXPECT_FALSE(memo.lookup(7, nudged, fitness));
+
+    MemoStats stats = memo.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST(FitnessMemoTest, MemoizedRunMatchesPlainRun) {
+    auto prices = wave_prices(1200);
+    GeneticOptimizer plain_optimizer(12, 8, 0.1, 0.2, 11);
+    plain_optimizer.set_verbose(false);
+    auto plain = plain_optimizer.optimize(prices, cached_backtest_fitness);
+
+    FitnessMemo memo;
+    GeneticOptimizer memo_optimizer(12, 8, 0.1, 0.2, 11);
+    memo_optimizer.set_verbose(false);
+    memo_optimizer.set_memo(&memo);
+    auto memoized = memo_optimizer.optimize(prices, cached_backtest_fitness);
+
+    EXPECT_EQ(memoized.best_fitness, plain.best_fitness);
+    EXPECT_EQ(memoized.fitness_history, plain.fitness_history);
+    EXPECT_TRUE(same_params(memoized.best_params, plain.best_params));
+
+    // Elites survive unchanged, so later generations always hit
+    EXPECT_EQ(memoized.memo_lookups, 12u * 8);
+    EXPECT_GE(memoized.memo_hits, 2u * 7);
+    EXPECT_EQ(memoized.bar_evaluations, (memoized.memo_lookups - memoized.memo_hits) * prices.size());
+    EXPECT_EQ(memoized.final_population.size(), 12u);
+    EXPECT_EQ(memo.population().size(), 12u);
+}
+
+TEST(FitnessMemoTest, SaveLoadRoundTripAndWarmStart) {
+    auto prices = wave_prices(1200);
+    std::string path = temp_path("memo.atfm");
+
+    FitnessMemo first;
+    GeneticOptimizer optimizer(12, 6, 0.1, 0.2, 3);
+    optimizer.set_verbose(false);
+    optimizer.set_memo(&first);
+    auto run = optimizer.optimize(prices, cached_backtest_fitness);
+    first.save(path);
+
+    FitnessMemo loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.stats().entries, first.stats().entries);
+    auto population = loaded.population();
+    ASSERT_EQ(population.size(), run.final_population.size());
+    for (size_t i = 0; i < population.size(); ++i) {
+        EXPECT_TRUE(same_params(population[i], run.final_population[i]));
+    }
+
+    // The next run starts from the saved leaders, which the memo already scored
+    GeneticOptimizer next(12, 1, 0.1, 0.2, 99);
+    next.set_verbose(false);
+    next.set_memo(&loaded);
+    auto warm = next.optimize(prices, cached_backtest_fitness);
+    EXPECT_GE(warm.best_fitness, run.fitness_history.back());
+    EXPECT_GE(warm.memo_hits, 6u);
+    std::remove(path.c_str());
+}
+
+TEST(FitnessMemoTest, PruneDropsStaleSeries) {
+    std::string path = temp_path("prune.atfm");
+    FitnessMemo memo;
+    StrategyParameters params;
+    memo.store(1, params, 10.0);
+    memo.store(2, params, 20.0);
+    memo.save(path);
+
+    FitnessMemo reloaded;
+    ASSERT_TRUE(reloaded.load(path));
+    double fitness = 0.0;
+    EXPECT_TRUE(reloaded.lookup(2, params, fitness));
+    EXPECT_EQ(reloaded.prune_untouched(), 1u);
+    EXPECT_FALSE(reloaded.lookup(1, params, fitness));
+    EXPECT_TRUE(reloaded.lookup(2, params, fitness));
+    std::remove(path.c_str());
+}
+
+TEST(FitnessMemoTest, MissingAndMalformedFiles) {
+    FitnessMemo memo;
+    EXPECT_FALSE(memo.load(temp_path("missing.atfm")));
+
+    std::string path = temp_path("garbage.atfm");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a memo file";
+    }
+    EXPECT_THROW(memo.load(path), DataException);
+    std::remove(path.c_str());
+}
+
+TEST(FitnessMemoTest, OtherFitnessKeepsOnlyPopulation) {
+    std::string path = temp_path("fitness_id.atfm");
+    StrategyParameters params;
+    FitnessMemo doubles(backtest_fitness_id(Precision::Double));
+    doubles.store(1, params, 10.0);
+    doubles.set_population({params});
+    doubles.save(path);
+
+    // Same series and parameters, different fitness function: never a hit
+    FitnessMemo floats(backtest_fitness_id(Precision::Float));
+    ASSERT_TRUE(floats.load(path));
+    double fitness = 0.0;
+    EXPECT_FALSE(floats.lookup(1, params, fitness));
+    EXPECT_EQ(floats.stats().entries, 0u);
+    ASSERT_EQ(floats.population().size(), 1u);
+    EXPECT_TRUE(same_params(floats.population()[0], params));
+
+    // A memo from an older file format is stale, not an error
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const char old_header[24] = {'A', 'T', 'F', 'M', 1};
+        out.write(old_header, sizeof(old_header));
+    }
+    EXPECT_FALSE(floats.load(path));
+    std::remove(path.c_str());
+}
+
+TEST(FitnessMemoTest, SaveKeepsMostRecentlyUsedEntries) {
+    std::string path = temp_path("capped.atfm");
+    StrategyParameters params;
+    {
+        FitnessMemo memo(backtest_fitness_id(Precision::Double), 4);
+        for (uint64_t series = 0; series < 4; ++series) memo.store(series, params, 1.0);
+        memo.save(path);
+    }
+
+    // The next run uses series 0 and 1 and adds two more, over the cap
+    FitnessMemo memo(backtest_fitness_id(Precision::Double), 4);
+    ASSERT_TRUE(memo.load(path));
+    double fitness = 0.0;
+    EXPECT_TRUE(memo.lookup(0, params, fitness));
+    EXPECT_TRUE(memo.lookup(1, params, fitness));
+    memo.store(10, params, 2.0);
+    memo.store(11, params, 2.0);
+    memo.save(path);
+
+    FitnessMemo reloaded;
+    ASSERT_TRUE(reloaded.load(path));
+    EXPECT_EQ(reloaded.stats().entries, 4u);
+    for (uint64_t series : {0, 1, 10, 11}) EXPECT_TRUE(reloaded.lookup(series, params, fitness)) << series;
+    EXPECT_FALSE(reloaded.lookup(2, params, fitness));
+    EXPECT_FALSE(reloaded.lookup(3, params, fitness));
+    std::remove(path.c_str());
+}
+
+TEST(FitnessMemoTest, MemoPathRejectsUnsafeSymbols) {
+    EXPECT_EQ(fitness_memo_path("memos", "BRK.B"), "memos/BRK.B.atfm");
+    EXPECT_EQ(fitness_memo_path("memos", "AAPL", Precision::Float), "memos/AAPL.f32.atfm");
+    EXPECT_THROW(fitness_memo_path("memos", "../etc/passwd"), DataException);
+    EXPECT_THROW(fitness_memo_path("memos", "A/B"), DataException);
+    EXPECT_THROW(fitness_memo_path("memos", ""), DataException);
+}
+
+TEST(FitnessMemoTest, ConcurrentSavesOfOnePathStayValid) {
+    // Two batch entries for the same symbol save the same memo file at once
+    std::string path = temp_path("concurrent.atfm");
+    std::vector<FitnessMemo> memos(4);
+    StrategyParameters params;
+    for (size_t k = 0; k < memos.size(); ++k) {
+        for (int e = 0; e < 2000; ++e) memos[k].store(k * 10000 + e, params, static_cast<double>(k));
+    }
+
+    std::vector<std::thread> writers;
+    for (size_t k = 0; k < memos.size(); ++k) {
+        writers.emplace_back([&, k] {
+            for (int round = 0; round < 20; ++round) memos[k].save(path);
+        });
+    }
+    for (auto& t : writers) t.join();
+
+    FitnessMemo loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.stats().entries, 2000u);
+    std::remove(path.c_str());
+}
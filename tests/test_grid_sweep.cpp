@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "grid_sweep.h"
+#include "exceptions.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+std::vector<double> wave_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(i * 0.07) + 3.0 * std::sin(i * 0.31) +
+                         1.5 * std::sin(i * 1.3) + 0.02 * i);
+    }
+    return prices;
+}
+
+GridAxes small_axes() {
+    GridAxes axes;
+    axes.ma_periods = {20, 50, 120};
+    axes.rsi_periods = {10, 14};
+    axes.rsi_thresholds = {55.0, 65.0, 80.0};
+    axes.stop_losses = {0.005, 0.02};
+    axes.take_profits = {0.01, 0.03};
+    axes.look_aheads = {5, 20};
+    return axes;
+}
+
+} // namespace
+
+TEST(GridSweepTest, EveryCellMatchesCachedBacktest) {
+    auto prices = wave_prices(900);
+    auto report = grid_sweep(prices, small_axes(), 2);
+    const ResultCube& cube = report.cube;
+    ASSERT_EQ(cube.size(), 3u * 2 * 3 * 2 * 2 * 2);
+
+    IndicatorCache cache;
+    size_t with_trades = 0;
+    for (size_t idx = 0; idx < cube.size(); ++idx) {
+        auto expected = backtest_detailed(prices, cube.params(idx), cache);
+        EXPECT_EQ(cube.fitness(idx), expected.fitness) << "cell " << idx;
+        EXPECT_EQ(cube.triggers(idx), expected.triggers);
+        EXPECT_EQ(cube.successes(idx), expected.successes);
+        if (expected.triggers > 0) ++with_trades;
+    }
+    EXPECT_GT(with_trades, cube.size() / 2);
+}
+
+TEST(GridSweepTest, InsufficientDataCellsMatchBacktest) {
+    auto prices = wave_prices(200);
+    GridAxes axes = small_axes();
+    axes.ma_periods = {20, 150, 400};  // 400 is longer than the series
+    auto report = grid_sweep(prices, axes, 1);
+
+    IndicatorCache cache;
+    for (size_t idx = 0; idx < report.cube.size(); ++idx) {
+        EXPECT_EQ(report.cube.fitness(idx), backtest_detailed(prices, report.cube.params(idx), cache).fitness);
+    }
+}
+
+TEST(GridSweepTest, IndexAndPointRoundTrip) {
+    ResultCube cube(small_axes());
+    for (size_t idx = 0; idx < cube.size(); ++idx) {
+        EXPECT_EQ(cube.index(cube.point(idx)), idx);
+    }
+    GridPoint p = cube.point(cube.index({2, 1, 0, 1, 0, 1}));
+    EXPECT_EQ(p.ma, 2u);
+    EXPECT_EQ(p.look_ahead, 1u);
+    EXPECT_EQ(cube.params(cube.index({2, 1, 0, 1, 0, 1})).ma_period, 120);
+}
+
+TEST(GridSweepTest, BestAndTopAgree) {
+    auto prices = wave_prices(900);
+    auto report = grid_sweep(prices, small_axes(), 1);
+    const ResultCube& cube = report.cube;
+
+    auto top = cube.top(5);
+    ASSERT_EQ(top.size(), 5u);
+    EXPECT_EQ(top[0], cube.best());
+    for (size_t k = 1; k < top.size(); ++k) {
+        EXPECT_GE(cube.fitness(top[k - 1]), cube.fitness(top[k]));
+    }
+    for (size_t idx = 0; idx < cube.size(); ++idx) {
+        EXPECT_LE(cube.fitness(idx), cube.fitness(cube.best()));
+    }
+}
+
+TEST(GridSweepTest, NeighborhoodMeanMatchesBruteForce) {
+    auto prices = wave_prices(900);
+    auto report = grid_sweep(prices, small_axes(), 1);
+    const ResultCube& cube = report.cube;
+    auto means = cube.neighborhood_mean(1);
+
+    size_t dims[6] = {3, 2, 3, 2, 2, 2};
+    for (size_t idx = 0; idx < cube.size(); idx += 7) {
+        GridPoint p = cube.point(idx);
+        size_t c[6] = {p.ma, p.rsi, p.threshold, p.stop_loss, p.take_profit, p.look_ahead};
+        double sum = 0.0;
+        size_t count = 0;
+        for (size_t other = 0; other < cube.size(); ++other) {
+            GridPoint q = cube.point(other);
+            size_t o[6] = {q.ma, q.rsi, q.threshold, q.stop_loss, q.take_profit, q.look_ahead};
+            bool inside = true;
+            for (int a = 0; a < 6; ++a) {
+                if (o[a] + 1 < c[a] || o[a] > c[a] + 1 || o[a] >= dims[a]) inside = false;
+            }
+            if (inside) {
+                sum += cube.fitness(other);
+                ++count;
+            }
+        }
+        EXPECT_NEAR(means[idx], sum / count, 1e-9);
+    }
+    EXPECT_EQ(cube.most_robust(1),
+              static_cast<size_t>(std::max_element(means.begin(), means.end()) - means.begin()));
+}
+
+TEST(GridSweepTest, ThreadCountDoesNotChangeCube) {
+    auto prices = wave_prices(900);
+    auto serial = grid_sweep(prices, small_axes(), 1);
+    auto parallel = grid_sweep(prices, small_axes(), 4);
+    EXPECT_EQ(serial.cube.fitness_data(), parallel.cube.fitness_data());
+    EXPECT_EQ(serial.trigger_sets, 18u);
+}
+
+TEST(GridSweepTest, RejectsEmptyAxis) {
+    GridAxes axes = small_axes();
+    axes.look_aheads.clear();
+    EXPECT_THROW(grid_sweep(wave_prices(500), axes), CalculationException);
+}
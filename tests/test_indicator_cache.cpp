@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "indicator_cache.h"
+#include "optimizer.h"
+#include <vector>
+#include <thread>
+#include <cmath>
+
+class IndicatorCacheTest : public ::testing::Test {
+protected:
+    std::vector<double> prices;
+
+    void SetUp() override {
+        for (int i = 0; i < 600; ++i) {
+            prices.push_back(100.0 + 10.0 * std::sin(i * 0.05) + 0.01 * i);
+        }
+    }
+};
+
+TEST_F(IndicatorCacheTest, ReturnsSameArrayForRepeatedKey) {
+    IndicatorCache cache;
+    uint64_t id = series_fingerprint(prices);
+
+    auto first = cache.sma(prices, id, 50);
+    auto second = cache.sma(prices, id, 50);
+    EXPECT_EQ(first.get(), second.get());
+
+    CacheStats stats = cache.stats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST_F(IndicatorCacheTest, KindsAndSeriesDoNotCollide) {
+    IndicatorCache cache;
+    uint64_t id = series_fingerprint(prices);
+    std::vector<double> other = prices;
+    other.back() += 1.0;
+    uint64_t other_id = series_fingerprint(other);
+    ASSERT_NE(id, other_id);
+
+    auto sma = cache.sma(prices, id, 14);
+    auto rsi = cache.rsi(prices, id, 14);
+    auto other_sma = cache.sma(other, other_id, 14);
+    EXPECT_NE(sma.get(), rsi.get());
+    EXPECT_NE(sma.get(), other_sma.get());
+    EXPECT_EQ(cache.stats().entries, 3u);
+}
+
+TEST_F(IndicatorCacheTest, SeriesIdIsFingerprintPerBufferAndLength) {
+    IndicatorCache cache;
+    Span<const double> full(prices);
+    Span<const double> prefix = full.subspan(0, 300);
+    EXPECT_EQ(cache.series_id(full), series_fingerprint(prices));
+    EXPECT_EQ(cache.series_id(prefix), series_fingerprint(prefix));
+    EXPECT_NE(cache.series_id(prefix), cache.series_id(full));
+
+    std::vector<double> copy = prices;
+    EXPECT_EQ(cache.series_id(copy), cache.series_id(full));  // same content, other buffer
+}
+
+TEST_F(IndicatorCacheTest, UnregisteredBufferIsRehashed) {
+    IndicatorCache cache;
+    std::vector<double> buffer = prices;
+    {
+        IndicatorCache::ScopedSeries outer(cache, buffer);
+        EXPECT_EQ(outer.id(), series_fingerprint(prices));
+        IndicatorCache::ScopedSeries inner(cache, buffer);   // nests
+    }
+
+    // The same buffer now holds another series of the same length, as when a
+    // freed buffer's address is reused
+    for (double& p : buffer) p += 1.0;
+    EXPECT_EQ(cache.series_id(buffer), series_fingerprint(buffer));
+    EXPECT_NE(cache.series_id(buffer), series_fingerprint(prices));
+
+    {
+        IndicatorCache::ScopedSeries outer(cache, buffer);
+        {
+            IndicatorCache::ScopedSeries inner(cache, buffer);
+        }
+        EXPECT_EQ(cache.series_id(buffer), series_fingerprint(buffer));  // still registered
+    }
+}
+
+TEST_F(IndicatorCacheTest, ConcurrentLookupsComputeOnce) {
+    IndicatorCache cache;
+    uint64_t id = series_fingerprint(prices);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int period = 50; period < 70; ++period) {
+                cache.sma(prices, id, period);
+                cache.macd(prices, id);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    CacheStats stats = cache.stats();
+    EXPECT_EQ(stats.misses, 21u);
+    EXPECT_EQ(stats.entries, 21u);
+    EXPECT_EQ(stats.hits + stats.misses, 8u * 40u);
+}
+
+TEST_F(IndicatorCacheTest, CachedBacktestMatchesUncached) {
+    IndicatorCache cache;
+    StrategyParameters params;
+    params.ma_period = 100;
+    params.rsi_threshold = 75.0;
+
+    BacktestResult direct = backtest_detailed(prices, params);
+    BacktestResult cached = backtest_detailed(prices, params, cache);
+    EXPECT_EQ(direct.triggers, cached.triggers);
+    EXPECT_EQ(direct.successes, cached.successes);
+    EXPECT_DOUBLE_EQ(direct.fitness, cached.fitness);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "indicator_lanes.h"
+#include "indicators.h"
+#include "streaming_indicators.h"
+#include "exceptions.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<double> noisy_prices(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> step(0.0, 0.01);
+    std::vector<double> prices;
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        price *= std::exp(step(gen));
+        // Repeated closes exercise the zero-change branch
+        prices.push_back(i % 17 == 0 && !prices.empty() ? prices.back() : price);
+    }
+    return prices;
+}
+
+// Bitwise equality, with NaN matching NaN
+void expect_row_equal(Span<const double> row, const std::vector<double>& expected, const std::string& label) {
+    ASSERT_EQ(row.size(), expected.size()) << label;
+    for (size_t i = 0; i < row.size(); ++i) {
+        if (std::isnan(expected[i])) {
+            ASSERT_TRUE(std::isnan(row[i])) << label << " at " << i;
+        } else {
+            ASSERT_EQ(row[i], expected[i]) << label << " at " << i;
+        }
+    }
+}
+
+const SimdLevel ALL_LEVELS[] = {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512};
+
+} // namespace
+
+TEST(IndicatorLanesTest, RSIRowsMatchScalarAtEveryLevel) {
+    auto prices = noisy_prices(3000, 5);
+    // 13 periods: one full and one partial group at both vector widths
+    std::vector<int> periods = {14, 2, 30, 10, 11, 12, 13, 15, 16, 17, 18, 250, 7};
+    for (SimdLevel level : ALL_LEVELS) {
+        IndicatorMatrix m = calc_rsi_lanes(prices, periods, level);
+        ASSERT_EQ(m.rows, periods.size());
+        ASSERT_EQ(m.bars, prices.size());
+        for (size_t k = 0; k < periods.size(); ++k) {
+            expect_row_equal(m.row(k), calc_rsi(prices, periods[k]),
+                             std::string(simd_level_name(level)) + " RSI " + std::to_string(periods[k]));
+        }
+    }
+}
+
+TEST(IndicatorLanesTest, MACDAndEMARowsMatchScalarAtEveryLevel) {
+    auto prices = noisy_prices(2500, 9);
+    std::vector<MACDParams> sets = {{12, 26, 9}, {5, 35, 5}, {8, 17, 9}, {3, 10, 16}, {19, 39, 9}};
+    std::vector<int> periods = {12, 26, 5, 200, 9};
+    for (SimdLevel level : ALL_LEVELS) {
+        MACDMatrix m = calc_macd_lanes(prices, sets, level);
+        for (size_t k = 0; k < sets.size(); ++k) {
+            MACD expected = calc_macd(prices, sets[k].fast, sets[k].slow, sets[k].signal);
+            std::string label = std::string(simd_level_name(level)) + " MACD set " + std::to_string(k);
+            expect_row_equal(m.macd.row(k), expected.macd, label);
+            expect_row_equal(m.signal.row(k), expected.signal, label);
+        }
+
+        IndicatorMatrix ema = calc_ema_lanes(prices, periods, level);
+        for (size_t k = 0; k < periods.size(); ++k) {
+            StreamingEMA reference(periods[k]);
+            std::vector<double> expected;
+            for (double p : prices) expected.push_back(reference.update(p));
+            expect_row_equal(ema.row(k), expected, std::string(simd_level_name(level)) + " EMA");
+        }
+    }
+}
+
+TEST(IndicatorLanesTest, ShortSeriesAndInvalidPeriods) {
+    auto prices = noisy_prices(20, 1);
+    // Periods 25 and 20 have no RSI value on 20 bars; 19 and 5 do
+    IndicatorMatrix m = calc_rsi_lanes(prices, {25, 5, 20, 19});
+    for (size_t i = 0; i < prices.size(); ++i) {
+        EXPECT_TRUE(std::isnan(m.at(0, i)));
+        EXPECT_TRUE(std::isnan(m.at(2, i)));
+    }
+    expect_row_equal(m.row(1), calc_rsi(prices, 5), "RSI 5 on 20 bars");
+    expect_row_equal(m.row(3), calc_rsi(prices, 19), "RSI 19 on 20 bars");
+
+    EXPECT_EQ(calc_rsi_lanes(std::vector<double>{}, {14}).bars, 0u);
+    EXPECT_EQ(calc_macd_lanes(std::vector<double>{}, {MACDParams{}}).macd.bars, 0u);
+    EXPECT_THROW(calc_rsi_lanes(prices, {14, 0}), CalculationException);
+    EXPECT_THROW(calc_ema_lanes(prices, {-3}), CalculationException);
+    EXPECT_THROW(calc_macd_lanes(prices, {MACDParams{12, 0, 9}}), CalculationException);
+}
@@ -3,6 +3,8 @@
 #include "exceptions.h"
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 
 class IndicatorsTest : public ::testing::Test {
 protected:
@@ -40,10 +42,137 @@ TEST_F(IndicatorsTest, RSICalculation) {
     EXPECT_GE(rsi[15], 0.0);
 }
 
+TEST_F(IndicatorsTest, RSIInvalidInput) {
+    EXPECT_THROW(calc_rsi(sample_prices, 0), CalculationException);
+    EXPECT_THROW(calc_rsi(sample_prices, -3), CalculationException);
+}
+
 TEST_F(IndicatorsTest, MACDCalculation) {
     auto macd_result = calc_macd(sample_prices);
     
     // Should return both MACD and signal lines
     EXPECT_EQ(macd_result.macd.size(), sample_prices.size());
     EXPECT_EQ(macd_result.signal.size(), sample_prices.size());
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Reference O(n*period) SMA used to bound the rolling implementation's error
+std::vector<double> naive_sma(const std::vector<double>& v, int period) {
+    std::vector<double> out(v.size(), std::nan(""));
+    for (size_t i = period - 1; i < v.size(); ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < period; ++j) sum += v[i - j];
+        out[i] = sum / period;
+    }
+    return out;
+}
+
+std::vector<double> random_walk(size_t count) {
+    std::vector<double> prices;
+    double price = 100.0;
+    unsigned int state = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1103515245u + 12345u;
+        price *= 1.0 + (static_cast<int>((state >> 16) % 2001) - 1000) / 50000.0;
+        prices.push_back(price);
+    }
+    return prices;
+}
+
+} // namespace
+
+TEST_F(IndicatorsTest, SMAMatchesDirectSummation) {
+    auto prices = random_walk(50000);
+    for (int period : {1, 7, 50, 200, 300}) {
+        auto fast = calc_sma(prices, period);
+        auto reference = naive_sma(prices, period);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            if (std::isnan(reference[i])) {
+                EXPECT_TRUE(std::isnan(fast[i]));
+            } else {
+                EXPECT_NEAR(fast[i], reference[i], 1e-12 * std::fabs(reference[i]));
+            }
+        }
+    }
+}
+
+TEST_F(IndicatorsTest, SMAMultiMatchesSinglePeriod) {
+    auto prices = random_walk(20000);
+    std::vector<int> periods = {3, 50, 123, 300};
+    auto batch = calc_sma_multi(prices, periods);
+    ASSERT_EQ(batch.size(), periods.size());
+
+    for (size_t k = 0; k < periods.size(); ++k) {
+        auto single = calc_sma(prices, periods[k]);
+        ASSERT_EQ(batch[k].size(), prices.size());
+        for (size_t i = 0; i < prices.size(); ++i) {
+            if (std::isnan(single[i])) {
+                EXPECT_TRUE(std::isnan(batch[k][i]));
+            } else {
+                EXPECT_NEAR(batch[k][i], single[i], 1e-12 * std::fabs(single[i]));
+            }
+        }
+    }
+    EXPECT_THROW(calc_sma_multi(prices, {5, 0}), CalculationException);
+}
+
+TEST_F(IndicatorsTest, FloatIndicatorsTrackDouble) {
+    auto prices = random_walk(100000);
+    std::vector<float> prices_f(prices.begin(), prices.end());
+    // Rolling-sum error scales with the largest prices seen, not the current ones
+    double scale = *std::max_element(prices.begin(), prices.end());
+
+    auto sma = calc_sma(prices, 200);
+    auto sma_f = calc_sma(prices_f, 200);
+    auto rsi = calc_rsi(prices, 14);
+    auto rsi_f = calc_rsi(prices_f, 14);
+    auto macd = calc_macd(prices);
+    auto macd_f = calc_macd(Span<const float>(prices_f));
+    ASSERT_EQ(sma_f.size(), prices.size());
+
+    for (size_t i = 200; i < prices.size(); ++i) {
+        EXPECT_NEAR(sma_f[i], sma[i], 1e-5 * scale);
+        EXPECT_NEAR(rsi_f[i], rsi[i], 0.05);
+        EXPECT_NEAR(macd_f.macd[i], macd.macd[i], 1e-5 * scale);
+    }
+    EXPECT_TRUE(std::isnan(sma_f[198]));
+    EXPECT_THROW(calc_sma(prices_f, 0), CalculationException);
+}
+
+TEST_F(IndicatorsTest, SMARecoversOnceNonFiniteValuesLeaveTheWindow) {
+    auto clean = random_walk(2000);
+    auto dirty = clean;
+    dirty[500] = std::nan("");
+    dirty[900] = std::numeric_limits<double>::infinity();
+    dirty[1300] = std::numeric_limits<double>::infinity();
+    dirty[1310] = -std::numeric_limits<double>::infinity();
+    const int period = 20;
+
+    auto expected = calc_sma(clean, period);
+    auto sma = calc_sma(dirty, period);
+    auto multi = calc_sma_multi(dirty, {period});
+    for (size_t i = period - 1; i < dirty.size(); ++i) {
+        bool has_nan = i >= 500 && i < 500 + period;
+        bool has_inf = i >= 900 && i < 900 + period;
+        bool has_both = i >= 1310 && i < 1300 + period;
+        bool has_pos = i >= 1300 && i < 1300 + period;
+        bool has_neg = i >= 1310 && i < 1310 + period;
+        double value = sma[i];
+        if (has_nan || has_both) {
+            EXPECT_TRUE(std::isnan(value)) << "bar " << i;
+        } else if (has_inf || has_pos) {
+            EXPECT_EQ(value, std::numeric_limits<double>::infinity()) << "bar " << i;
+        } else if (has_neg) {
+            EXPECT_EQ(value, -std::numeric_limits<double>::infinity()) << "bar " << i;
+        } else {
+            // Clean again: back to the value of the series without them
+            EXPECT_NEAR(value, expected[i], 1e-12 * std::fabs(expected[i])) << "bar " << i;
+        }
+        if (!std::isfinite(value)) {
+            EXPECT_TRUE(std::isnan(value) ? std::isnan(multi[0][i]) : multi[0][i] == value) << "bar " << i;
+        } else {
+            EXPECT_NEAR(multi[0][i], value, 1e-12 * std::fabs(value)) << "bar " << i;
+        }
+    }
+}
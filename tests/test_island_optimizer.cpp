@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "island_optimizer.h"
+#include "exceptions.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+std::vector<double> wave_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(i * 0.07) + 3.0 * std::sin(i * 0.31) +
+                         1.5 * std::sin(i * 1.3) + 0.02 * i);
+    }
+    return prices;
+}
+
+IslandOptions small_options() {
+    IslandOptions options;
+    options.islands = 4;
+    options.population_per_island = 10;
+    options.generations = 9;
+    options.migration_interval = 3;
+    options.migrants = 2;
+    options.seed = 5;
+    return options;
+}
+
+} // namespace
+
+TEST(IslandOptimizerTest, ReproducibleAcrossThreadCounts) {
+    auto prices = wave_prices(1200);
+    for (auto topology : {MigrationTopology::Ring, MigrationTopology::FullyConnected, MigrationTopology::Random}) {
+        IslandOptions options = small_options();
+        options.topology = topology;
+
+        options.threads = 1;
+        auto serial = IslandOptimizer(options).optimize(prices, cached_backtest_fitness);
+        options.threads = 4;
+        auto parallel = IslandOptimizer(options).optimize(prices, cached_backtest_fitness);
+
+        EXPECT_EQ(serial.best.fitness_history, parallel.best.fitness_history);
+        EXPECT_EQ(serial.island_best, parallel.island_best);
+        EXPECT_EQ(serial.best.best_params.ma_period, parallel.best.best_params.ma_period);
+        EXPECT_EQ(serial.migrations, parallel.migrations);
+    }
+}
+
+TEST(IslandOptimizerTest, MigrationCountsFollowTopology) {
+    auto prices = wave_prices(1200);
+    IslandOptions options = small_options();  // migrations after generations 3 and 6
+
+    options.topology = MigrationTopology::Ring;
+    EXPECT_EQ(IslandOptimizer(options).optimize(prices, cached_backtest_fitness).migrations, 2u * 4 * 2);
+
+    options.topology = MigrationTopology::FullyConnected;
+    EXPECT_EQ(IslandOptimizer(options).optimize(prices, cached_backtest_fitness).migrations, 2u * 4 * 3 * 2);
+
+    options.migration_interval = 0;  // isolated islands
+    EXPECT_EQ(IslandOptimizer(options).optimize(prices, cached_backtest_fitness).migrations, 0u);
+}
+
+TEST(IslandOptimizerTest, ReportsGlobalBest) {
+    auto prices = wave_prices(1200);
+    auto result = IslandOptimizer(small_options()).optimize(prices, cached_backtest_fitness);
+
+    ASSERT_EQ(result.island_best.size(), 4u);
+    ASSERT_EQ(result.best.fitness_history.size(), 9u);
+    double best_island = *std::max_element(result.island_best.begin(), result.island_best.end());
+    EXPECT_EQ(result.best.best_fitness, best_island);
+    EXPECT_EQ(result.best.best_fitness,
+              *std::max_element(result.best.fitness_history.begin(), result.best.fitness_history.end()));
+    EXPECT_DOUBLE_EQ(result.best.best_fitness, backtest_fitness(prices, result.best.best_params));
+}
+
+TEST(IslandOptimizerTest, RejectsEmptyIslands) {
+    IslandOptions options;
+    options.islands = 0;
+    EXPECT_THROW(IslandOptimizer{options}, CalculationException);
+}
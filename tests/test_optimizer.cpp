@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "optimizer.h"
+#include "thread_pool.h"
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+std::vector<double> wave_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(i * 0.07) + 3.0 * std::sin(i * 0.31) + 0.02 * i);
+    }
+    return prices;
+}
+
+} // namespace
+
+TEST(ThreadPoolTest, VisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(visits.size(), [&](size_t i) { visits[i]++; });
+    for (auto& v : visits) EXPECT_EQ(v.load(), 1);
+}
+
+TEST(ThreadPoolTest, RethrowsWorkerException) {
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.parallel_for(100, [](size_t i) {
+        if (i == 42) throw std::runtime_error("boom");
+    }), std::runtime_error);
+
+    // Pool stays usable after an exception
+    std::atomic<size_t> count{0};
+    pool.parallel_for(50, [&](size_t) { count++; });
+    EXPECT_EQ(count.load(), 50u);
+}
+
+TEST(GeneticOptimizerTest, FixedSeedIsReproducibleAcrossThreadCounts) {
+    auto prices = wave_prices(1200);
+
+    GeneticOptimizer serial(20, 8, 0.1, 0.2, 7, 1);
+    GeneticOptimizer parallel(20, 8, 0.1, 0.2, 7, 4);
+    serial.set_verbose(false);
+    parallel.set_verbose(false);
+
+    auto a = serial.optimize(prices, cached_backtest_fitness);
+    auto b = parallel.optimize(prices, cached_backtest_fitness);
+
+    EXPECT_EQ(a.fitness_history, b.fitness_history);
+    EXPECT_EQ(a.best_params.ma_period, b.best_params.ma_period);
+    EXPECT_EQ(a.best_params.rsi_period, b.best_params.rsi_period);
+    EXPECT_DOUBLE_EQ(a.best_params.rsi_threshold, b.best_params.rsi_threshold);
+    EXPECT_DOUBLE_EQ(a.best_fitness, b.best_fitness);
+}
+
+TEST(GeneticOptimizerTest, RacingPrunesOnPrefixes) {
+    auto prices = wave_prices(3000);
+    RacingOptions racing;
+    racing.enabled = true;
+    racing.min_bars = 600;
+
+    GeneticOptimizer full(24, 6, 0.1, 0.25, 11, 1);
+    GeneticOptimizer raced(24, 6, 0.1, 0.25, 11, 1);
+    full.set_verbose(false);
+    raced.set_verbose(false);
+    raced.set_racing(racing);
+
+    auto baseline = full.optimize(prices, cached_backtest_fitness);
+    auto result = raced.optimize(prices, cached_backtest_fitness);
+
+    EXPECT_EQ(baseline.bar_evaluations, baseline.full_bar_evaluations);
+    EXPECT_EQ(result.full_bar_evaluations, baseline.full_bar_evaluations);
+    // 24 on 750 bars, 12 on 1500, 6 on 3000 per generation
+    EXPECT_EQ(result.bar_evaluations, 6u * (24 * 750 + 12 * 1500 + 6 * 3000));
+
+    // The reported best was scored on the full series
+    EXPECT_DOUBLE_EQ(result.best_fitness, backtest_fitness(prices, result.best_params));
+}
+
+TEST(GeneticOptimizerTest, RacingIsReproducibleAcrossThreadCounts) {
+    auto prices = wave_prices(2000);
+    RacingOptions racing;
+    racing.enabled = true;
+
+    GeneticOptimizer serial(20, 5, 0.1, 0.2, 3, 1);
+    GeneticOptimizer parallel(20, 5, 0.1, 0.2, 3, 4);
+    for (auto* optimizer : {&serial, &parallel}) {
+        optimizer->set_verbose(false);
+        optimizer->set_racing(racing);
+    }
+
+    auto a = serial.optimize(prices, cached_backtest_fitness);
+    auto b = parallel.optimize(prices, cached_backtest_fitness);
+    EXPECT_EQ(a.fitness_history, b.fitness_history);
+    EXPECT_EQ(a.bar_evaluations, b.bar_evaluations);
+}
+
+TEST(PrecisionTest, DoubleArrayBacktestMatchesFused) {
+    auto prices = wave_prices(3000);
+    std::mt19937 gen(17);
+    for (int k = 0; k < 20; ++k) {
+        StrategyParameters params = StrategyParameters::random(gen);
+        auto fused = backtest_detailed(prices, params);
+        auto arrays = backtest_arrays(Span<const double>(prices), params);
+        EXPECT_EQ(arrays.fitness, fused.fitness);
+        EXPECT_EQ(arrays.triggers, fused.triggers);
+    }
+}
+
+TEST(PrecisionTest, FloatTriggersMostlyAgreeWithDouble) {
+    auto prices = wave_prices(20000);
+    std::vector<float> prices_f(prices.begin(), prices.end());
+    IndicatorCache cache;
+    std::mt19937 gen(23);
+
+    size_t common = 0, total = 0;
+    for (int k = 0; k < 20; ++k) {
+        StrategyParameters params = StrategyParameters::random(gen);
+        auto a = entry_triggers(Span<const double>(prices), params);
+        auto b = entry_triggers(Span<const float>(prices_f), params);
+        std::vector<size_t> both;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(both));
+        common += both.size();
+        total += a.size() + b.size() - both.size();
+
+        // The cached float path is the same computation
+        auto uncached = backtest_arrays(Span<const float>(prices_f), params);
+        EXPECT_EQ(backtest_detailed_f32(prices, params, cache).fitness, uncached.fitness);
+        EXPECT_EQ(backtest_fitness_for(Precision::Float)(prices, params, cache), uncached.fitness);
+    }
+    ASSERT_GT(total, 0u);
+    EXPECT_GE(static_cast<double>(common) / total, 0.95);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "perf_counters.h"
+#include <sstream>
+#include <vector>
+
+namespace {
+
+double busy_work(size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = static_cast<double>(i) * 0.5;
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    return sum;
+}
+
+} // namespace
+
+TEST(PerfCountersTest, StagesAccumulateByName) {
+    StageCounters perf(false);
+    {
+        ScopedStage stage(&perf, "indicators", 100);
+        busy_work(10000);
+    }
+    {
+        ScopedStage stage(&perf, "backtest", 100);
+    }
+    {
+        ScopedStage stage(&perf, "indicators", 50);
+    }
+
+    ASSERT_EQ(perf.stages().size(), 2u);
+    EXPECT_EQ(perf.stages()[0].name, "indicators");
+    const StageMetrics* indicators = perf.find("indicators");
+    ASSERT_NE(indicators, nullptr);
+    EXPECT_EQ(indicators->runs, 2u);
+    EXPECT_EQ(indicators->bars, 150u);
+    EXPECT_GT(indicators->seconds, 0.0);
+    EXPECT_FALSE(indicators->has_counters);
+    EXPECT_EQ(perf.find("missing"), nullptr);
+}
+
+TEST(PerfCountersTest, LateBarCountAndNullRecorder) {
+    StageCounters perf(false);
+    {
+        ScopedStage stage(&perf, "parse");
+        stage.set_bars(42);
+    }
+    EXPECT_EQ(perf.find("parse")->bars, 42u);
+
+    ScopedStage ignored(nullptr, "noop", 10);  // must not crash or record
+}
+
+TEST(PerfCountersTest, DisabledCountersReportTimingOnly) {
+    StageCounters perf(false);
+    EXPECT_FALSE(perf.counters_available());
+    {
+        ScopedStage stage(&perf, "optimize", 10);
+    }
+
+    std::ostringstream out;
+    perf.print_report(out);
+    EXPECT_NE(out.str().find("timing only"), std::string::npos);
+    EXPECT_EQ(out.str().find("IPC"), std::string::npos);
+}
+
+TEST(PerfCountersTest, DerivedMetrics) {
+    StageMetrics m;
+    EXPECT_EQ(m.ipc(), 0.0);
+    EXPECT_EQ(m.per_bar(100), 0.0);
+
+    m.bars = 200;
+    m.counters.cycles = 1000;
+    m.counters.instructions = 2500;
+    EXPECT_DOUBLE_EQ(m.ipc(), 2.5);
+    EXPECT_DOUBLE_EQ(m.per_bar(50), 0.25);
+
+    CounterSample a, b;
+    a.cycles = 10;
+    b.cycles = 15;
+    EXPECT_EQ((a - b).cycles, 0u);  // multiplex estimates never go negative
+    EXPECT_EQ((b - a).cycles, 5u);
+}
+
+TEST(PerfCountersTest, ReadsHardwareCountersWhenPermitted) {
+    StageCounters perf;
+    if (!perf.counters_available()) {
+        GTEST_SKIP() << "counters unavailable: " << perf.unavailable_reason();
+    }
+    {
+        ScopedStage stage(&perf, "work", 100000);
+        volatile double sink = busy_work(100000);
+        (void)sink;
+    }
+    const StageMetrics* work = perf.find("work");
+    ASSERT_NE(work, nullptr);
+    EXPECT_TRUE(work->has_counters);
+    EXPECT_GT(work->counters.instructions, 100000u);
+    EXPECT_GT(work->ipc(), 0.0);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "pipeline.h"
+#include "bounded_queue.h"
+#include "exceptions.h"
+#include "price_store.h"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+PriceSeries wave_series(const std::string& symbol, size_t count, double phase) {
+    PriceSeries series;
+    series.symbol = symbol;
+    for (size_t i = 0; i < count; ++i) {
+        double close = 100.0 + 6.0 * std::sin(i * 0.09 + phase) + 2.5 * std::sin(i * 0.37) +
+                       1.5 * std::sin(i * 1.71 + phase) + 0.03 * i;
+        series.dates.push_back(static_cast<int64_t>(i) * 86400);
+        series.open.push_back(close);
+        series.high.push_back(close);
+        series.low.push_back(close);
+        series.close.push_back(close);
+        series.volume.push_back(0.0);
+    }
+    return series;
+}
+
+} // namespace
+
+TEST(BoundedQueueTest, PreservesOrderAndNeverExceedsCapacity) {
+    BoundedQueue<int> queue(3);
+    std::thread producer([&] {
+        for (int i = 0; i < 100; ++i) queue.push(i);
+        queue.close();
+    });
+    int expected = 0, value = 0;
+    while (queue.pop(value)) EXPECT_EQ(value, expected++);
+    producer.join();
+    EXPECT_EQ(expected, 100);
+    EXPECT_LE(queue.high_water(), 3u);
+    EXPECT_FALSE(queue.push(7));  // closed
+}
+
+TEST(PipelineTest, ParsesJobFile) {
+    PipelineJob job = parse_job(R"({
+        "symbols": ["AAA", "BBB"],
+        "strategy": {"ma_period": 120, "rsi_threshold": 65.5},
+        "optimize": {"population": 12, "generations": 4, "threads": 2},
+        "data": {"store_dir": "/tmp/stores"},
+        "pipeline": {"queue_capacity": 2},
+        "output": {"csv": "out.csv"}
+    })");
+    EXPECT_EQ(job.symbols, (std::vector<std::string>{"AAA", "BBB"}));
+    EXPECT_EQ(job.options.params.ma_period, 120);
+    EXPECT_EQ(job.options.params.rsi_threshold, 65.5);
+    EXPECT_EQ(job.options.params.rsi_period, 14);  // default kept
+    EXPECT_TRUE(job.options.optimize);
+    EXPECT_EQ(job.options.population, 12u);
+    EXPECT_EQ(job.options.threads, 2u);
+    EXPECT_EQ(job.source.store_dir, "/tmp/stores");
+    EXPECT_EQ(job.queue_capacity, 2u);
+    EXPECT_EQ(job.csv_path, "out.csv");
+    EXPECT_TRUE(job.json_path.empty());
+
+    EXPECT_THROW(parse_job("{\"symbols\": []}"), DataException);
+    EXPECT_THROW(parse_job("{\"symbols\": [\"A\"], \"min_bars\": \"lots\"}"), DataException);
+    EXPECT_THROW(parse_job("not json"), DataException);
+}
+
+TEST(PipelineTest, MatchesBatchRunnerFromLocalStores) {
+    std::string dir = "/tmp/algo_trader_pipeline_" + std::to_string(::getpid());
+    std::filesystem::create_directories(dir);
+
+    PipelineJob job;
+    job.source.store_dir = dir;
+    job.symbols = {"AAA", "BBB", "CCC", "SHORT", "MISSING", "DDD"};
+    for (const auto& s : {wave_series("AAA", 3000, 0.0), wave_series("BBB", 800, 1.0),
+                          wave_series("CCC", 5000, 2.0), wave_series("SHORT", 100, 0.5),
+                          wave_series("DDD", 1500, 3.0)}) {
+        write_price_store(job.source.store_path(s.symbol), s);
+    }
+    job.options.optimize = true;
+    job.options.population = 10;
+    job.options.generations = 3;
+    job.options.threads = 2;
+    job.queue_capacity = 1;
+    job.fetch_chunk = 2;
+
+    PipelineReport pipeline = run_pipeline(job);
+    BatchReport batch = run_batch(job.symbols, job.source, job.options);
+
+    ASSERT_EQ(pipeline.batch.symbols.size(), job.symbols.size());
+    EXPECT_EQ(pipeline.batch.succeeded(), 4u);
+    for (size_t i = 0; i < job.symbols.size(); ++i) {
+        const SymbolReport& p = pipeline.batch.symbols[i];
+        const SymbolReport& b = batch.symbols[i];
+        EXPECT_EQ(p.symbol, job.symbols[i]);
+        EXPECT_EQ(p.ok(), b.ok()) << p.symbol << ": " << p.error;
+        if (!p.ok()) continue;
+        EXPECT_EQ(p.bars, b.bars);
+        EXPECT_EQ(p.backtest.triggers, b.backtest.triggers);
+        EXPECT_EQ(p.backtest.fitness, b.backtest.fitness);
+        EXPECT_EQ(p.best_fitness, b.best_fitness);
+        EXPECT_EQ(p.best_params.ma_period, b.best_params.ma_period);
+    }
+
+    // Fetch, parse, indicators, backtest, optimize
+    ASSERT_EQ(pipeline.stages.size(), 5u);
+    EXPECT_EQ(pipeline.stages[0].items, 6u);
+    EXPECT_EQ(pipeline.stages[1].items, 4u);      // SHORT and MISSING fail in parse
+    EXPECT_EQ(pipeline.stages[1].failures, 2u);
+    EXPECT_EQ(pipeline.stages[4].items, 4u);
+    EXPECT_EQ(pipeline.stages[4].workers, 2u);
+    EXPECT_EQ(pipeline.stages[3].bars, 3000u + 800u + 5000u + 1500u);
+    for (const auto& stage : pipeline.stages) EXPECT_LE(stage.queue_high_water, 1u);
+
+    std::ostringstream out;
+    write_pipeline_json(pipeline, out);
+    auto doc = nlohmann::json::parse(out.str());
+    EXPECT_EQ(doc["symbols"].size(), 6u);
+    EXPECT_EQ(doc["symbols"][2]["bars"], 5000);
+    EXPECT_FALSE(doc["symbols"][4]["ok"].get<bool>());
+    EXPECT_TRUE(doc["symbols"][0].contains("optimized"));
+    EXPECT_EQ(doc["stages"][4]["name"], "Optimize Stage");
+
+    std::filesystem::remove_all(dir);
+}
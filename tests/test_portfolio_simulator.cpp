@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "portfolio_simulator.h"
+#include "strategy.h"
+#include "strategy_engine.h"
+#include "exceptions.h"
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Open at the previous close; high/low `range` either side of the close
+PriceSeries random_bars(const std::string& symbol, size_t count, unsigned seed, double range,
+                        int64_t first_date = 1700000000, int64_t step = 60) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> move(0.0, 0.01);
+    PriceSeries s;
+    s.symbol = symbol;
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        double open = price;
+        price *= std::exp(move(gen));
+        s.dates.push_back(first_date + static_cast<int64_t>(i) * step);
+        s.open.push_back(open);
+        s.high.push_back(std::max(open, price) * (1.0 + range));
+        s.low.push_back(std::min(open, price) * (1.0 - range));
+        s.close.push_back(price);
+        s.volume.push_back(1000.0);
+    }
+    return s;
+}
+
+PortfolioOptions tiny_positions() {
+    PortfolioOptions options;
+    options.position_fraction = 1e-6;  // never short of cash
+    options.commission = 0.0;
+    return options;
+}
+
+} // namespace
+
+TEST(PortfolioSimulatorTest, FlatBarsMatchCloseOnlyExits) {
+    // open = high = low = close: intrabar checks reduce to the close-based scan
+    PriceSeries s = random_bars("FLAT", 5000, 4, 0.0);
+    s.open = s.high = s.low = s.close;
+    PortfolioOptions options = tiny_positions();
+
+    auto triggers = scan_entry_signals(s.close, options.params.ma_period, options.params.rsi_period,
+                                       options.params.rsi_threshold, options.params.ma_period, s.size());
+    TakeProfitStopLoss<> exit(options.params.stop_loss, options.params.take_profit, options.params.look_ahead);
+    size_t takes = 0, stops = 0;
+    for (size_t entry : triggers) {
+        ExitReason reason = exit.exit(Span<const double>(s.close), entry);
+        takes += reason == ExitReason::TakeProfit;
+        stops += reason == ExitReason::StopLoss;
+    }
+    ASSERT_GT(triggers.size(), 20u);
+
+    PortfolioReport report = simulate_portfolio({&s}, options);
+    EXPECT_EQ(report.trades, triggers.size());
+    EXPECT_EQ(report.take_profits, takes);
+    EXPECT_EQ(report.stop_losses, stops);
+    EXPECT_EQ(report.expired, triggers.size() - takes - stops);
+    EXPECT_EQ(report.skipped_entries, 0u);
+    EXPECT_EQ(report.bar_events, s.size());
+    ASSERT_EQ(report.equity.size(), s.size());
+    EXPECT_EQ(report.equity.back().equity, report.final_equity);
+    EXPECT_DOUBLE_EQ(report.total_return, report.final_equity / options.initial_capital - 1.0);
+}
+
+TEST(PortfolioSimulatorTest, IntrabarOrderDecidesWideBars) {
+    // Every bar spans more than both levels, so each position exits on the
+    // bar after entry and the intrabar order alone picks the side
+    PriceSeries s = random_bars("WIDE", 4000, 9, 0.05);
+    PortfolioOptions options = tiny_positions();
+
+    PortfolioReport stop_first = simulate_portfolio({&s}, options);
+    ASSERT_GT(stop_first.trades, 10u);
+    EXPECT_EQ(stop_first.take_profits, 0u);
+    EXPECT_LE(stop_first.expired, 1u);  // only an entry on the last bar
+    EXPECT_EQ(stop_first.max_open_positions, 1u);
+
+    options.intrabar = IntrabarOrder::TakeFirst;
+    PortfolioReport take_first = simulate_portfolio({&s}, options);
+    EXPECT_EQ(take_first.trades, stop_first.trades);
+    EXPECT_EQ(take_first.stop_losses, 0u);
+    EXPECT_EQ(take_first.take_profits + take_first.expired, take_first.trades);
+    EXPECT_GT(take_first.final_equity, stop_first.final_equity);
+}
+
+TEST(PortfolioSimulatorTest, ManySymbolsShareCapitalAndClock) {
+    std::vector<PriceSeries> universe;
+    for (unsigned k = 0; k < 6; ++k) {
+        // Offset clocks: symbol k trades on its own half-minute grid
+        int64_t first_date = 1700000000 + 30 * (k % 2);
+        universe.push_back(random_bars("S" + std::to_string(k), 3000, 20 + k, 0.004, first_date));
+    }
+    std::vector<const PriceSeries*> refs;
+    for (const auto& s : universe) refs.push_back(&s);
+
+    PortfolioOptions options;
+    // Distant levels and a long look-ahead keep positions open, so signals
+    // from different symbols overlap and hit the position cap
+    options.params.look_ahead = 200;
+    options.params.stop_loss = 0.3;
+    options.params.take_profit = 0.3;
+    options.max_positions = 4;
+    PortfolioReport report = simulate_portfolio(refs, options);
+
+    EXPECT_EQ(report.bar_events, 6u * 3000u);
+    EXPECT_EQ(report.equity.size(), 2u * 3000u);  // union of both grids
+    for (size_t k = 1; k < report.equity.size(); ++k) {
+        ASSERT_LT(report.equity[k - 1].date, report.equity[k].date);
+    }
+    EXPECT_LE(report.max_open_positions, 4u);
+    EXPECT_GT(report.skipped_entries, 0u);
+    EXPECT_EQ(report.trades, report.take_profits + report.stop_losses + report.expired);
+    EXPECT_GE(report.max_drawdown, 0.0);
+    EXPECT_LT(report.max_drawdown, 1.0);
+    EXPECT_TRUE(std::isfinite(report.sharpe));
+
+    // Same inputs, same answer
+    PortfolioReport again = simulate_portfolio(refs, options);
+    EXPECT_EQ(again.final_equity, report.final_equity);
+    EXPECT_EQ(again.trades, report.trades);
+}
+
+TEST(PortfolioSimulatorTest, RejectsMismatchedColumnsAndHandlesEmpty) {
+    PriceSeries s = random_bars("BAD", 100, 1, 0.01);
+    s.high.pop_back();
+    EXPECT_THROW(simulate_portfolio({&s}, PortfolioOptions{}), DataException);
+
+    PortfolioReport empty = simulate_portfolio(std::vector<PriceColumns>{}, PortfolioOptions{});
+    EXPECT_TRUE(empty.equity.empty());
+    EXPECT_EQ(empty.final_equity, empty.initial_capital);
+    EXPECT_EQ(empty.sharpe, 0.0);
+}
+
+TEST(PortfolioSimulatorTest, ZeroEquityKeepsSummaryFinite) {
+    // No capital: every equity point is 0, so no step has a defined return
+    PriceSeries s = random_bars("ZERO", 1000, 5, 0.01);
+    PortfolioOptions options = tiny_positions();
+    options.initial_capital = 0.0;
+    PortfolioReport report = simulate_portfolio({&s}, options);
+
+    ASSERT_EQ(report.equity.size(), s.size());
+    EXPECT_EQ(report.final_equity, 0.0);
+    EXPECT_EQ(report.total_return, 0.0);
+    EXPECT_EQ(report.sharpe, 0.0);
+    EXPECT_EQ(report.max_drawdown, 0.0);
+}
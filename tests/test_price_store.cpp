@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "price_store.h"
+#include "price_parser.h"
+#include "data_source.h"
+#include "indicators.h"
+#include "exceptions.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return "/tmp/algo_trader_" + std::to_string(::getpid()) + "_" + name;
+}
+
+PriceSeries sample_series(size_t count) {
+    PriceSeries series;
+    series.symbol = "TEST";
+    for (size_t i = 0; i < count; ++i) {
+        series.dates.push_back(1700000000 + static_cast<int64_t>(i) * 86400);
+        series.open.push_back(100.0 + i);
+        series.high.push_back(101.0 + i);
+        series.low.push_back(99.0 + i);
+        series.close.push_back(100.5 + i);
+        series.volume.push_back(1000.0 * i);
+    }
+    return series;
+}
+
+} // namespace
+
+TEST(PriceStoreTest, RoundTripsAllColumns) {
+    auto series = sample_series(1000);
+    std::string path = temp_path("roundtrip.atps");
+    write_price_store(path, series);
+
+    MappedPriceStore store(path);
+    EXPECT_EQ(store.symbol(), "TEST");
+    ASSERT_EQ(store.size(), series.size());
+    EXPECT_EQ(store.dates().to_vector(), series.dates);
+    EXPECT_EQ(store.open().to_vector(), series.open);
+    EXPECT_EQ(store.high().to_vector(), series.high);
+    EXPECT_EQ(store.low().to_vector(), series.low);
+    EXPECT_EQ(store.close().to_vector(), series.close);
+    EXPECT_EQ(store.volume().to_vector(), series.volume);
+
+    // Columns feed the indicator functions without copying
+    auto sma = calc_sma(store.close(), 10);
+    EXPECT_DOUBLE_EQ(sma[9], 105.0);
+
+    std::remove(path.c_str());
+}
+
+TEST(PriceStoreTest, LoadedStoreIsReadInPlace) {
+    auto series = sample_series(500);
+    DataSourceConfig config;
+    config.store_dir = temp_path("stores");
+    std::string path = config.store_path("TEST");
+    std::filesystem::create_directories(config.store_dir);
+    write_price_store(path, series);
+
+    RawHistory raw = fetch_histories({"TEST"}, config).front();
+    ASSERT_EQ(raw.store_path, path);
+    LoadedHistory loaded = materialize_history(std::move(raw), config);
+    EXPECT_EQ(loaded.origin, HistoryOrigin::PriceStore);
+    EXPECT_TRUE(loaded.series.close.empty());
+
+    PriceColumns bars = loaded.columns();
+    EXPECT_EQ(bars.symbol, "TEST");
+    EXPECT_EQ(bars.close.data(), loaded.store->close().data());
+    EXPECT_EQ(bars.close.to_vector(), series.close);
+    EXPECT_EQ(bars.dates.to_vector(), series.dates);
+
+    std::filesystem::remove_all(config.store_dir);
+}
+
+TEST(PriceStoreTest, RejectsInvalidFiles) {
+    EXPECT_THROW(MappedPriceStore(temp_path("missing.atps")), DataException);
+
+    std::string path = temp_path("garbage.atps");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(256, 'x');
+    }
+    EXPECT_THROW(MappedPriceStore store(path), DataException);
+    std::remove(path.c_str());
+}
+
+TEST(PriceStoreTest, RejectsCountThatWrapsColumnBounds) {
+    // count * 8 wraps to 80, so an unchecked offset + count * 8 would fit
+    std::string path = temp_path("wrapped.atps");
+    write_price_store(path, sample_series(10));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        PriceStoreHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.count = (uint64_t(1) << 61) + 10;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    EXPECT_THROW(MappedPriceStore store(path), DataException);
+    EXPECT_THROW(PriceStoreColumnReader reader(path), DataException);
+    std::remove(path.c_str());
+}
+
+TEST(PriceParserTest, ParsesHistoryOldestFirst) {
+    const std::string body = R"({"symbol":"AAPL","historical":[
+        {"date":"2024-01-03","close":3.0,"high":3.5,"low":2.5,"open":2.9,"volume":300},
+        {"date":"2024-01-02","Close":2.0},
+        {"date":"2024-01-01","close":null},
+        {"date":"2023-12-31","close":1.0}
+    ]})";
+
+    ParsedHistory parsed = parse_price_history(body, "AAPL");
+    EXPECT_EQ(parsed.total_records, 4u);
+    EXPECT_EQ(parsed.skipped_records, 1u);
+
+    const PriceSeries& s = parsed.series;
+    ASSERT_EQ(s.size(), 3u);
+    EXPECT_EQ(s.close, (std::vector<double>{1.0, 2.0, 3.0}));
+    EXPECT_EQ(s.high[1], 2.0);  // missing high falls back to close
+    EXPECT_EQ(s.high[2], 3.5);
+    EXPECT_EQ(s.volume[0], 0.0);
+    EXPECT_EQ(s.dates[2], parse_date_to_epoch("2024-01-03"));
+    EXPECT_EQ(parse_date_to_epoch("1970-01-02"), 86400);
+}
+
+TEST(PriceParserTest, RejectsMalformedResponses) {
+    EXPECT_THROW(parse_price_history("not json", "X"), DataException);
+    EXPECT_THROW(parse_price_history(R"({"historical":{}})", "X"), DataException);
+    EXPECT_THROW(parse_price_history(R"({"historical":[]})", "X"), DataException);
+}
+
+TEST(PriceParserTest, StreamingParserMatchesDomParser) {
+    std::string body = R"({"symbol":"XYZ","note":{"historical":1},"historical":[)";
+    for (int i = 0; i < 500; ++i) {
+        if (i) body += ",";
+        int day = 1 + i % 28, month = 1 + (i / 28) % 12;
+        std::string date = "\"2020-" + std::string(month < 10 ? "0" : "") + std::to_string(month) + "-" +
+                           std::string(day < 10 ? "0" : "") + std::to_string(day) + "\"";
+        if (i % 50 == 7) {
+            body += "{\"date\":" + date + ",\"close\":null,\"Close\":" + std::to_string(10.0 + i) + "}";
+        } else if (i % 50 == 13) {
+            body += "{\"date\":" + date + ",\"adjClose\":1.5,\"extra\":{\"close\":99}}";
+        } else if (i % 50 == 21) {
+            body += "{\"date\":" + date + ",\"close\":" + std::to_string(i) + ",\"tags\":[1,2,{\"low\":0}]}";
+        } else {
+            body += "{\"date\":" + date + ",\"open\":" + std::to_string(i + 0.25) + ",\"high\":" +
+                    std::to_string(i + 1.5) + ",\"low\":" + std::to_string(i - 0.5) + ",\"close\":" +
+                    std::to_string(i + 0.75) + ",\"volume\":" + std::to_string(1000 + i) + "}";
+        }
+    }
+    body += "],\"trailer\":[{\"close\":1}]}";
+
+    ParsedHistory sax = parse_price_history(body, "XYZ");
+    ParsedHistory dom = parse_price_history_dom(body, "XYZ");
+
+    EXPECT_EQ(sax.total_records, dom.total_records);
+    EXPECT_EQ(sax.skipped_records, dom.skipped_records);
+    EXPECT_EQ(sax.skipped_records, 10u);
+    EXPECT_EQ(sax.series.dates, dom.series.dates);
+    EXPECT_EQ(sax.series.open, dom.series.open);
+    EXPECT_EQ(sax.series.high, dom.series.high);
+    EXPECT_EQ(sax.series.low, dom.series.low);
+    EXPECT_EQ(sax.series.close, dom.series.close);
+    EXPECT_EQ(sax.series.volume, dom.series.volume);
+}
+
+TEST(PriceParserTest, ParsersAgreeOnNonNumericFields) {
+    // Boolean closes convert to 1/0; booleans elsewhere fall back like nulls
+    const std::string body = R"({"historical":[
+        {"date":"2024-01-04","close":true,"open":false,"volume":true},
+        {"date":"2024-01-03","close":null,"Close":false},
+        {"date":"2024-01-02","close":2.5,"high":true,"low":"n/a"},
+        {"date":"2024-01-01","close":1.5}
+    ]})";
+    ParsedHistory sax = parse_price_history(body, "BOOL");
+    ParsedHistory dom = parse_price_history_dom(body, "BOOL");
+
+    EXPECT_EQ(sax.total_records, dom.total_records);
+    EXPECT_EQ(sax.skipped_records, dom.skipped_records);
+    EXPECT_EQ(sax.series.close, (std::vector<double>{1.5, 2.5, 0.0, 1.0}));
+    EXPECT_EQ(sax.series.close, dom.series.close);
+    EXPECT_EQ(sax.series.open, dom.series.open);
+    EXPECT_EQ(sax.series.high, dom.series.high);
+    EXPECT_EQ(sax.series.low, dom.series.low);
+    EXPECT_EQ(sax.series.volume, dom.series.volume);
+
+    // A close that is not a number or boolean is an error in both
+    for (const char* bad : {R"({"historical":[{"close":"1.0"}]})", R"({"historical":[{"close":[1.0]}]})",
+                            R"({"historical":[{"Close":{"value":1.0}}]})",
+                            R"({"historical":[{"close":null,"Close":"n/a"}]})"}) {
+        EXPECT_THROW(parse_price_history(bad, "BAD"), DataException) << bad;
+        EXPECT_THROW(parse_price_history_dom(bad, "BAD"), DataException) << bad;
+    }
+
+    // "Close" is only read when "close" is missing, so a bad one beside a
+    // valid "close" is ignored by both, whichever key comes first
+    for (const char* ok : {R"({"historical":[{"close":1.5,"Close":"n/a"}]})",
+                           R"({"historical":[{"Close":["n/a"],"close":1.5}]})"}) {
+        EXPECT_EQ(parse_price_history(ok, "OK").series.close, std::vector<double>{1.5}) << ok;
+        EXPECT_EQ(parse_price_history_dom(ok, "OK").series.close, std::vector<double>{1.5}) << ok;
+    }
+}
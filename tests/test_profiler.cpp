@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "profiler.h"
+#include "thread_pool.h"
+#include <nlohmann/json.hpp>
+#include <set>
+#include <sstream>
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Profiler::reset();
+        Profiler::set_enabled(true);
+    }
+
+    void TearDown() override {
+        Profiler::set_enabled(false);
+        Profiler::reset();
+    }
+
+    static const ZoneStats* find(const std::vector<ZoneStats>& stats, const std::string& path) {
+        for (const auto& s : stats) {
+            if (s.path == path) return &s;
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(ProfilerTest, DisabledZonesRecordNothing) {
+    Profiler::set_enabled(false);
+    for (int i = 0; i < 10; ++i) {
+        PROFILE_ZONE("Ignored");
+    }
+    EXPECT_EQ(Profiler::event_count(), 0u);
+    EXPECT_TRUE(Profiler::summarize().empty());
+}
+
+TEST_F(ProfilerTest, AggregatesNestedZonesByPath) {
+    for (int outer = 0; outer < 2; ++outer) {
+        PROFILE_ZONE("Outer");
+        for (int inner = 0; inner < 3; ++inner) {
+            PROFILE_ZONE("Inner");
+            volatile double sink = 0.0;
+            for (int k = 0; k < 1000; ++k) sink = sink + k;
+        }
+    }
+    {
+        PROFILE_ZONE("Inner");
+    }
+
+    auto stats = Profiler::summarize();
+    ASSERT_EQ(stats.size(), 3u);
+
+    const ZoneStats* outer = find(stats, "Outer");
+    const ZoneStats* nested = find(stats, "Outer/Inner");
+    const ZoneStats* top = find(stats, "Inner");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(nested, nullptr);
+    ASSERT_NE(top, nullptr);
+
+    EXPECT_EQ(outer->count, 2u);
+    EXPECT_EQ(outer->depth, 0);
+    EXPECT_EQ(nested->count, 6u);
+    EXPECT_EQ(nested->depth, 1);
+    EXPECT_EQ(top->count, 1u);
+    EXPECT_GE(outer->total_us, nested->total_us);
+
+    EXPECT_LE(nested->min_us, nested->p50_us);
+    EXPECT_LE(nested->p50_us, nested->p99_us);
+    EXPECT_LE(nested->p99_us, nested->max_us);
+
+    // Children are listed directly under their parent
+    EXPECT_EQ(stats[0].path, "Outer");
+    EXPECT_EQ(stats[1].path, "Outer/Inner");
+}
+
+TEST_F(ProfilerTest, KeepsEveryEventAcrossChunksAndThreads) {
+    const size_t per_thread_zones = 5000;  // spills past one buffer chunk
+    ThreadPool pool(4);
+    pool.parallel_for(8, [&](size_t) {
+        PROFILE_ZONE("Task");
+        for (size_t i = 0; i < per_thread_zones; ++i) {
+            PROFILE_ZONE("Step");
+        }
+    });
+
+    EXPECT_EQ(Profiler::event_count(), 8 * (per_thread_zones + 1));
+    auto stats = Profiler::summarize();
+    const ZoneStats* step = find(stats, "Task/Step");
+    ASSERT_NE(step, nullptr);
+    EXPECT_EQ(step->count, 8 * per_thread_zones);
+}
+
+TEST_F(ProfilerTest, KeepsMostRecentZonesWithinLimit) {
+    size_t limit = Profiler::event_limit();
+    Profiler::set_event_limit(2 * 4096);
+    const size_t steps = 5 * 4096;
+    {
+        PROFILE_ZONE("Run");
+        for (size_t i = 0; i < steps; ++i) {
+            PROFILE_ZONE("Step");
+        }
+    }
+
+    // The enclosing zone closes last, so it survives with its path intact
+    EXPECT_LE(Profiler::event_count(), 2u * 4096);
+    EXPECT_EQ(Profiler::event_count() + Profiler::dropped_count(), steps + 1);
+    auto stats = Profiler::summarize();
+    ASSERT_NE(find(stats, "Run"), nullptr);
+    const ZoneStats* step = find(stats, "Run/Step");
+    ASSERT_NE(step, nullptr);
+    EXPECT_EQ(step->count, Profiler::event_count() - 1);
+
+    Profiler::reset();
+    EXPECT_EQ(Profiler::dropped_count(), 0u);
+    Profiler::set_event_limit(limit);
+}
+
+TEST_F(ProfilerTest, ExportsChromeTraceJson) {
+    {
+        PROFILE_ZONE("Parent \"quoted\"");
+        PROFILE_ZONE("Child");
+    }
+
+    std::ostringstream out;
+    Profiler::write_chrome_trace(out);
+    auto trace = nlohmann::json::parse(out.str());
+
+    ASSERT_TRUE(trace.contains("traceEvents"));
+    std::set<std::string> names;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] != "X") continue;
+        names.insert(event["name"].get<std::string>());
+        EXPECT_GE(event["dur"].get<double>(), 0.0);
+        EXPECT_GE(event["ts"].get<double>(), 0.0);
+    }
+    EXPECT_EQ(names, (std::set<std::string>{"Parent \"quoted\"", "Child"}));
+}
+
+TEST_F(ProfilerTest, ResetDiscardsRecordedZones) {
+    for (int i = 0; i < 5000; ++i) {
+        PROFILE_ZONE("Zone");
+    }
+    Profiler::reset();
+    EXPECT_EQ(Profiler::event_count(), 0u);
+
+    {
+        PROFILE_ZONE("After");
+    }
+    EXPECT_EQ(Profiler::event_count(), 1u);
+}
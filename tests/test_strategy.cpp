@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "strategy.h"
+#include "indicators.h"
+#include "optimizer.h"
+#include "exceptions.h"
+#include <vector>
+#include <cmath>
+
+namespace {
+
+std::vector<double> cyclical_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 6.0 * std::sin(i * 0.09) + 2.5 * std::sin(i * 0.37) +
+                         1.5 * std::sin(i * 1.71) + 0.03 * i);
+    }
+    return prices;
+}
+
+// Trigger indices evaluated the pre-fused way, from full indicator arrays
+std::vector<size_t> array_triggers(const std::vector<double>& closes, int ma_period, int rsi_period,
+                                   double threshold, size_t begin, size_t end) {
+    auto sma = calc_sma(closes, ma_period);
+    auto macd = calc_macd(closes);
+    auto rsi = calc_rsi(closes, rsi_period);
+    std::vector<size_t> out;
+    for (size_t i = begin; i < end; ++i) {
+        bool above = closes[i] > sma[i];
+        bool cross = macd.macd[i] > macd.signal[i] && macd.macd[i - 1] <= macd.signal[i - 1];
+        if (above && cross && rsi[i] < threshold) out.push_back(i);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(StrategyTest, FusedScanMatchesIndicatorArrays) {
+    auto prices = cyclical_prices(4000);
+    for (int ma : {50, 200, 300}) {
+        for (int rsi : {10, 14, 20}) {
+            auto fused = scan_entry_signals(prices, ma, rsi, 70.0, ma, prices.size() - 10);
+            auto reference = array_triggers(prices, ma, rsi, 70.0, ma, prices.size() - 10);
+            EXPECT_EQ(fused, reference) << "ma " << ma << " rsi " << rsi;
+        }
+    }
+}
+
+TEST(StrategyTest, FusedScanHandlesEmptyRange) {
+    auto prices = cyclical_prices(100);
+    EXPECT_TRUE(scan_entry_signals(prices, 20, 14, 70.0, 90, 50).empty());
+    EXPECT_TRUE(scan_entry_signals(prices, 20, 14, 70.0, 200, 300).empty());
+}
+
+TEST(StrategyTest, FusedBacktestMatchesCachedBacktest) {
+    auto prices = cyclical_prices(3000);
+    IndicatorCache cache;
+    StrategyParameters params;
+    params.ma_period = 120;
+    params.rsi_period = 12;
+    params.rsi_threshold = 72.0;
+
+    BacktestResult fused = backtest_detailed(prices, params);
+    BacktestResult cached = backtest_detailed(prices, params, cache);
+    EXPECT_GT(fused.triggers, 0u);
+    EXPECT_EQ(fused.triggers, cached.triggers);
+    EXPECT_EQ(fused.successes, cached.successes);
+    EXPECT_DOUBLE_EQ(fused.fitness, cached.fitness);
+}
+
+TEST(StrategyTest, BacktestStrategyUsesGivenParameters) {
+    auto prices = cyclical_prices(3000);
+    StrategyParameters params;
+    params.ma_period = 80;
+    params.rsi_period = 10;
+    params.rsi_threshold = 55.0;
+    params.look_ahead = 15;
+
+    // Entries from bar ma_period under the given threshold, not 200 and 70
+    auto triggers = scan_entry_signals(prices, params.ma_period, params.rsi_period, params.rsi_threshold,
+                                       params.ma_period, prices.size() - params.look_ahead);
+    ASSERT_GT(triggers.size(), 0u);
+    TradeTally streamed = backtest_strategy(prices, params);
+    EXPECT_EQ(streamed.triggers, triggers.size());
+
+    auto sma = calc_sma(prices, params.ma_period);
+    auto macd = calc_macd(prices);
+    auto rsi = calc_rsi(prices, params.rsi_period);
+    TradeTally arrays = backtest_strategy(prices, sma, rsi, macd.macd, macd.signal, params);
+    EXPECT_EQ(arrays.triggers, streamed.triggers);
+    EXPECT_EQ(arrays.successes, streamed.successes);
+    EXPECT_EQ(arrays.total_return, streamed.total_return);
+}
+
+TEST(StrategyTest, BacktestStrategyRejectsInvalidParameters) {
+    auto prices = cyclical_prices(300);
+    StrategyParameters params;
+    params.rsi_period = 0;
+    EXPECT_THROW(backtest_strategy(prices, params), CalculationException);
+    params = StrategyParameters{};
+    params.stop_loss = 1.5;
+    EXPECT_THROW(backtest_strategy(prices, params), CalculationException);
+    params = StrategyParameters{};
+    params.rsi_threshold = 0.0;
+    EXPECT_THROW(backtest_strategy(prices, params), CalculationException);
+    params = StrategyParameters{};
+    params.ma_period = 500;  // longer than the series
+    EXPECT_THROW(backtest_strategy(prices, params), CalculationException);
+    EXPECT_THROW(backtest_strategy(prices, {}, {}, {}, {}, StrategyParameters{}), CalculationException);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "strategy_engine.h"
+#include "strategy.h"
+#include "indicators.h"
+#include "optimizer.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<double> cyclical_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 6.0 * std::sin(i * 0.09) + 2.5 * std::sin(i * 0.37) +
+                         1.5 * std::sin(i * 1.71) + 0.03 * i);
+    }
+    return prices;
+}
+
+// The pre-engine backtest_detailed: array triggers, then a forward scan each
+TradeTally hand_written(const std::vector<double>& prices, const StrategyParameters& params) {
+    auto sma = calc_sma(prices, params.ma_period);
+    auto macd = calc_macd(prices);
+    auto rsi = calc_rsi(prices, params.rsi_period);
+    TradeTally tally;
+    for (size_t i = params.ma_period; i < prices.size() - params.look_ahead; ++i) {
+        bool above = prices[i] > sma[i];
+        bool cross = macd.macd[i] > macd.signal[i] && macd.macd[i - 1] <= macd.signal[i - 1];
+        if (!(above && cross && rsi[i] < params.rsi_threshold)) continue;
+        ++tally.triggers;
+        double stop = prices[i] * (1.0 - params.stop_loss);
+        double take = prices[i] * (1.0 + params.take_profit);
+        for (size_t j = i + 1; j <= i + params.look_ahead && j < prices.size(); ++j) {
+            if (prices[j] >= take) {
+                ++tally.successes;
+                tally.total_return += params.take_profit;
+                break;
+            }
+            if (prices[j] <= stop) {
+                tally.total_return -= params.stop_loss;
+                break;
+            }
+        }
+    }
+    return tally;
+}
+
+// A user-defined policy: fires every `stride` bars
+class EveryNth {
+private:
+    size_t stride;
+
+public:
+    static constexpr bool needs_history = false;
+
+    explicit EveryNth(size_t n) : stride(n) {}
+    bool update(size_t i, double) const { return i % stride == 0; }
+};
+
+} // namespace
+
+TEST(StrategyEngineTest, StreamingAndArrayEntriesAgree) {
+    auto prices = cyclical_prices(4000);
+    Span<const double> view(prices);
+    for (int ma : {50, 200}) {
+        for (int rsi_period : {10, 14, 20}) {
+            auto sma = calc_sma(prices, ma);
+            auto macd = calc_macd(prices);
+            auto rsi = calc_rsi(prices, rsi_period);
+            auto arrays = all_of(SeriesAboveSMA<double>(view, sma), SeriesMACDCross<double>(macd),
+                                 SeriesRSIBelow<double>(rsi, 65.0));
+            StreamingSMA window(1);
+            auto streaming = all_of(CloseAboveSMA(window, ma), MACDBullishCross(), RSIBelow(rsi_period, 65.0));
+
+            std::vector<size_t> from_arrays, from_streams;
+            scan_entries(arrays, view, ma, prices.size() - 10, from_arrays);
+            scan_entries(streaming, view, ma, prices.size() - 10, from_streams);
+            EXPECT_FALSE(from_arrays.empty());
+            EXPECT_EQ(from_arrays, from_streams) << "ma " << ma << " rsi " << rsi_period;
+            EXPECT_EQ(from_streams, scan_entry_signals(prices, ma, rsi_period, 65.0, ma, prices.size() - 10));
+        }
+    }
+}
+
+TEST(StrategyEngineTest, InstantiationsMatchHandWrittenLoop) {
+    auto prices = cyclical_prices(5000);
+    IndicatorCache cache;
+    std::mt19937 gen(21);
+    for (int k = 0; k < 25; ++k) {
+        StrategyParameters params = StrategyParameters::random(gen);
+        TradeTally expected = hand_written(prices, params);
+        BacktestResult want = score_outcomes(expected.triggers, expected.successes, expected.total_return);
+
+        StreamingSMA window(1);
+        auto entry = all_of(CloseAboveSMA(window, params.ma_period), MACDBullishCross(),
+                            RSIBelow(params.rsi_period, params.rsi_threshold));
+        TradeTally tally = run_strategy(entry, TakeProfitStopLoss<>(params.stop_loss, params.take_profit,
+                                                                    params.look_ahead),
+                                        Span<const double>(prices), params.ma_period,
+                                        prices.size() - params.look_ahead);
+        EXPECT_EQ(tally.triggers, expected.triggers);
+        EXPECT_EQ(tally.successes, expected.successes);
+        EXPECT_EQ(tally.total_return, expected.total_return);
+
+        EXPECT_EQ(backtest_detailed(prices, params).fitness, want.fitness);
+        EXPECT_EQ(backtest_detailed(prices, params, cache).fitness, want.fitness);
+        EXPECT_EQ(backtest_arrays(Span<const double>(prices), params).fitness, want.fitness);
+        EXPECT_EQ(backtest_detailed(prices, params).triggers, want.triggers);
+    }
+}
+
+TEST(StrategyEngineTest, CustomPoliciesComposeAndRangeIsClamped) {
+    std::vector<double> prices(100);
+    for (size_t i = 0; i < prices.size(); ++i) prices[i] = 100.0 + (i % 2 ? 1.0 : -1.0);
+    Span<const double> view(prices);
+
+    auto entry = all_of(EveryNth(10), EveryNth(4));
+    std::vector<size_t> triggers;
+    scan_entries(entry, view, 0, 1000, triggers);
+    EXPECT_EQ(triggers, (std::vector<size_t>{20, 40, 60, 80}));  // bar 0 never fires
+
+    scan_entries(entry, view, 50, 50, triggers);
+    EXPECT_TRUE(triggers.empty());
+
+    // Even bars close at 99 and the next bar at 101: every trade takes profit
+    auto even = all_of(EveryNth(2));
+    TradeTally tally = run_strategy(even, TakeProfitStopLoss<>(0.05, 0.015, 3), view, 10, 20);
+    EXPECT_EQ(tally.triggers, 5u);
+    EXPECT_EQ(tally.successes, 5u);
+    EXPECT_DOUBLE_EQ(tally.total_return, 5 * 0.015);
+
+    // Levels out of reach: every trade expires and adds no return
+    tally = run_strategy(even, TakeProfitStopLoss<>(0.5, 0.5, 3), view, 10, 20);
+    EXPECT_EQ(tally.triggers, 5u);
+    EXPECT_EQ(tally.successes, 0u);
+    EXPECT_EQ(tally.total_return, 0.0);
+}
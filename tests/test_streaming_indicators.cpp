@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "streaming_indicators.h"
+#include "indicators.h"
+#include "exceptions.h"
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+
+namespace {
+
+std::vector<double> noisy_series(size_t count) {
+    std::vector<double> prices;
+    double price = 50.0;
+    unsigned int state = 987654321u;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        price += (static_cast<int>(state >> 20) - 2048) / 1024.0;
+        if (price < 1.0) price = 1.0;
+        prices.push_back(price);
+    }
+    return prices;
+}
+
+// Bit-level equality that also treats NaN == NaN
+bool same_bits(double a, double b) {
+    if (std::isnan(a) && std::isnan(b)) return true;
+    uint64_t x, y;
+    std::memcpy(&x, &a, sizeof(x));
+    std::memcpy(&y, &b, sizeof(y));
+    return x == y;
+}
+
+} // namespace
+
+class StreamingIndicatorsTest : public ::testing::Test {
+protected:
+    std::vector<double> prices = noisy_series(5000);
+};
+
+TEST_F(StreamingIndicatorsTest, SMAIsBitIdenticalToBatch) {
+    for (int period : {1, 2, 14, 200}) {
+        auto batch = calc_sma(prices, period);
+        StreamingSMA sma(period);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            ASSERT_TRUE(same_bits(sma.update(prices[i]), batch[i])) << "period " << period << " bar " << i;
+        }
+    }
+}
+
+TEST_F(StreamingIndicatorsTest, SMAMatchesBatchAcrossNonFiniteValues) {
+    auto dirty = prices;
+    dirty[100] = std::nan("");
+    dirty[400] = std::numeric_limits<double>::infinity();
+    dirty[410] = -std::numeric_limits<double>::infinity();
+    auto batch = calc_sma(dirty, 30);
+    StreamingSMA sma(30);
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        ASSERT_TRUE(same_bits(sma.update(dirty[i]), batch[i])) << "bar " << i;
+    }
+    EXPECT_TRUE(std::isfinite(sma.value()));
+}
+
+TEST_F(StreamingIndicatorsTest, MACDIsBitIdenticalToBatch) {
+    auto batch = calc_macd(prices, 12, 26, 9);
+    StreamingMACD macd(12, 26, 9);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        MACDValue value = macd.update(prices[i]);
+        ASSERT_TRUE(same_bits(value.macd, batch.macd[i])) << "bar " << i;
+        ASSERT_TRUE(same_bits(value.signal, batch.signal[i])) << "bar " << i;
+    }
+}
+
+TEST_F(StreamingIndicatorsTest, RSIIsBitIdenticalToBatch) {
+    for (int period : {2, 14, 20}) {
+        auto batch = calc_rsi(prices, period);
+        StreamingRSI rsi(period);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            ASSERT_TRUE(same_bits(rsi.update(prices[i]), batch[i])) << "period " << period << " bar " << i;
+        }
+        EXPECT_TRUE(rsi.ready());
+    }
+}
+
+TEST_F(StreamingIndicatorsTest, InvalidPeriodThrows) {
+    EXPECT_THROW(StreamingSMA(0), CalculationException);
+    EXPECT_THROW(StreamingRSI(-3), CalculationException);
+    EXPECT_THROW(StreamingMACD(12, 26, 0), CalculationException);
+}
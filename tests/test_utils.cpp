@@ -2,6 +2,9 @@
 #include "utils.h"
 #include "exceptions.h"
 
+// The whole test binary shares one curl initialization, as main does
+static const CurlGlobal curl_global;
+
 TEST(UtilsTest, HTTPGetValidURL) {
     // Test with a simple HTTP endpoint
     std::string result = http_get("https://httpbin.org/get");
@@ -9,6 +12,19 @@ TEST(UtilsTest, HTTPGetValidURL) {
     EXPECT_TRUE(result.find("httpbin") != std::string::npos);
 }
 
+TEST(UtilsTest, ValidatesSymbols) {
+    EXPECT_TRUE(is_valid_symbol("AAPL"));
+    EXPECT_TRUE(is_valid_symbol("BRK.B"));
+    EXPECT_TRUE(is_valid_symbol("RDS-A"));
+    EXPECT_TRUE(is_valid_symbol("ABCDEFGHIJKLMNO"));
+    EXPECT_FALSE(is_valid_symbol(""));
+    EXPECT_FALSE(is_valid_symbol("ABCDEFGHIJKLMNOP"));  // 16 characters
+    EXPECT_FALSE(is_valid_symbol("../etc/passwd"));
+    EXPECT_FALSE(is_valid_symbol("/tmp/x"));
+    EXPECT_FALSE(is_valid_symbol("A B"));
+    EXPECT_FALSE(is_valid_symbol("AAPL?apikey=x"));
+}
+
 TEST(UtilsTest, HTTPGetInvalidURL) {
     // Test with invalid URL
     std::string result = http_get("invalid-url");
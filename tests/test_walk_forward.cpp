@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "walk_forward.h"
+#include "exceptions.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+std::vector<double> wave_prices(size_t count) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(i * 0.07) + 3.0 * std::sin(i * 0.31) +
+                         1.5 * std::sin(i * 1.3) + 0.02 * i);
+    }
+    return prices;
+}
+
+WalkForwardOptions small_options() {
+    WalkForwardOptions options;
+    options.train_bars = 600;
+    options.test_bars = 200;
+    options.population = 12;
+    options.generations = 6;
+    options.seed = 7;
+    return options;
+}
+
+} // namespace
+
+TEST(WalkForwardTest, RollingFoldsSlideFixedWindows) {
+    WalkForwardOptions options;
+    options.train_bars = 100;
+    options.test_bars = 50;
+    auto folds = make_folds(300, options);
+
+    ASSERT_EQ(folds.size(), 4u);
+    for (size_t k = 0; k < folds.size(); ++k) {
+        EXPECT_EQ(folds[k].train_begin, 50 * k);
+        EXPECT_EQ(folds[k].train_end - folds[k].train_begin, 100u);
+        EXPECT_EQ(folds[k].test_begin, folds[k].train_end);
+        EXPECT_EQ(folds[k].test_end - folds[k].test_begin, 50u);
+        EXPECT_LE(folds[k].test_end, 300u);
+    }
+}
+
+TEST(WalkForwardTest, AnchoredFoldsGrowFromStart) {
+    WalkForwardOptions options;
+    options.mode = WindowMode::Anchored;
+    options.train_bars = 100;
+    options.test_bars = 50;
+    options.step_bars = 25;
+    auto folds = make_folds(230, options);
+
+    ASSERT_EQ(folds.size(), 4u);
+    for (size_t k = 0; k < folds.size(); ++k) {
+        EXPECT_EQ(folds[k].train_begin, 0u);
+        EXPECT_EQ(folds[k].train_end, 100 + 25 * k);
+    }
+    EXPECT_THROW(make_folds(100, WalkForwardOptions{WindowMode::Rolling, 0, 10}), CalculationException);
+}
+
+TEST(WalkForwardTest, FullWindowMatchesCachedBacktest) {
+    auto prices = wave_prices(1200);
+    StrategyParameters params;
+    params.ma_period = 80;
+    params.rsi_threshold = 65.0;
+
+    IndicatorCache cache;
+    auto full = backtest_detailed(prices, params, cache);
+    auto window = backtest_window(prices, params, cache, series_fingerprint(prices), 0, prices.size());
+    EXPECT_EQ(window.fitness, full.fitness);
+    EXPECT_EQ(window.triggers, full.triggers);
+    EXPECT_EQ(window.successes, full.successes);
+    EXPECT_GT(full.triggers, 0u);
+}
+
+TEST(WalkForwardTest, WindowsPartitionTrades) {
+    auto prices = wave_prices(1200);
+    StrategyParameters params;
+    params.ma_period = 80;
+    params.rsi_threshold = 65.0;
+    params.look_ahead = 5;
+
+    IndicatorCache cache;
+    uint64_t id = series_fingerprint(prices);
+    auto full = backtest_window(prices, params, cache, id, 0, prices.size());
+    auto first = backtest_window(prices, params, cache, id, 0, 600);
+    auto second = backtest_window(prices, params, cache, id, 600, prices.size());
+
+    // Only entries whose look-ahead straddles the split are dropped
+    EXPECT_LE(first.triggers + second.triggers, full.triggers);
+    EXPECT_GE(first.triggers + second.triggers + 5, full.triggers);
+
+    // Too short to hold warm-up, look-ahead and 50 scan bars
+    EXPECT_EQ(backtest_window(prices, params, cache, id, 1100, 1150).fitness, -1000.0);
+}
+
+TEST(WalkForwardTest, ReproducibleAcrossThreadCounts) {
+    auto prices = wave_prices(1600);
+    auto options = small_options();
+
+    options.threads = 1;
+    auto serial = walk_forward(prices, options);
+    options.threads = 4;
+    auto parallel = walk_forward(prices, options);
+
+    ASSERT_EQ(serial.folds.size(), 5u);
+    ASSERT_EQ(parallel.folds.size(), serial.folds.size());
+    for (size_t k = 0; k < serial.folds.size(); ++k) {
+        EXPECT_EQ(parallel.folds[k].params.ma_period, serial.folds[k].params.ma_period);
+        EXPECT_EQ(parallel.folds[k].train_fitness, serial.folds[k].train_fitness);
+        EXPECT_EQ(parallel.folds[k].test.fitness, serial.folds[k].test.fitness);
+    }
+    EXPECT_EQ(parallel.oos_fitness, serial.oos_fitness);
+}
+
+TEST(WalkForwardTest, AggregatesOutOfSampleFolds) {
+    auto prices = wave_prices(1600);
+    auto report = walk_forward(prices, small_options());
+
+    size_t triggers = 0, successes = 0;
+    for (const auto& fold : report.folds) {
+        triggers += fold.test.triggers;
+        successes += fold.test.successes;
+        // Winners are scored on the test window with the same parameters
+        IndicatorCache cache;
+        auto again = backtest_window(prices, fold.params, cache, series_fingerprint(prices),
+                                     fold.window.test_begin, fold.window.test_end);
+        EXPECT_EQ(again.fitness, fold.test.fitness);
+    }
+    EXPECT_EQ(report.oos_triggers, triggers);
+    EXPECT_EQ(report.oos_successes, successes);
+    if (triggers > 0) {
+        EXPECT_DOUBLE_EQ(report.oos_win_rate, 100.0 * successes / triggers);
+    }
+
+    // Indicators are shared across folds: at most one array per distinct key
+    EXPECT_LE(report.cache.misses, report.cache.entries);
+    EXPECT_GT(report.cache.hits, report.cache.misses);
+}
+
+TEST(WalkForwardTest, RejectsSeriesShorterThanOneFold) {
+    EXPECT_THROW(walk_forward(wave_prices(500), small_options()), CalculationException);
+}